@@ -0,0 +1,99 @@
+#! /usr/bin/env python
+
+"""
+Run MUGS searches with and without hash compaction and test that they
+report the same minimal unsolvable goal subsets. The debug build
+additionally checks that every state on the hash compaction stack is
+unpacked correctly and that its fingerprint is found in the set.
+"""
+
+from __future__ import print_function
+
+import os
+import subprocess
+import sys
+
+DIR = os.path.dirname(os.path.abspath(__file__))
+REPO = os.path.dirname(os.path.dirname(DIR))
+BENCHMARKS_DIR = os.path.join(REPO, "misc", "tests", "benchmarks")
+FAST_DOWNWARD = os.path.join(REPO, "fast-downward.py")
+
+# Hash compaction stops at the first goal state, so the tasks must be unsolvable.
+TASKS = [os.path.join(BENCHMARKS_DIR, path) for path in [
+    "visitall-fuel/p01.pddl",
+]]
+
+PRUNING = "mugs_pruning(all_softgoals=true)"
+
+SEARCHES = [
+    "mugs_astar(blind(), pruning={pruning}{options})",
+    "mugs_greedy([blind()], pruning={pruning}{options})",
+]
+
+COMPACTION_OPTIONS = [
+    ", hash_compaction=true",
+    ", hash_compaction=true, fingerprint_seed=42",
+]
+
+MUGS_START = "++++++++++ MUGS PRUNING +++++++++++++++"
+MUGS_END = "++++++++++++++++++++++++++++++++++++++++++++++++"
+
+
+def run_search(task, search, debug):
+    cmd = [sys.executable, FAST_DOWNWARD]
+    if debug:
+        cmd.append("--debug")
+    cmd += [task, "--search", search]
+    print("\nRun {}:".format(cmd))
+    sys.stdout.flush()
+    process = subprocess.Popen(
+        cmd, stdout=subprocess.PIPE, universal_newlines=True)
+    output = process.communicate()[0]
+    print(output)
+    return process.returncode, output
+
+
+def parse_mugs(output):
+    """Return the reported MUGS as a set of frozensets of fact names."""
+    lines = output.splitlines()
+    try:
+        start = lines.index(MUGS_START)
+    except ValueError:
+        sys.exit("Error: search did not report MUGS")
+    mugs = set()
+    for line in lines[start + 1:]:
+        if line == MUGS_END:
+            return mugs
+        mugs.add(frozenset(fact for fact in line.split("|") if fact))
+    sys.exit("Error: MUGS output is incomplete")
+
+
+def cleanup():
+    subprocess.check_call([sys.executable, FAST_DOWNWARD, "--cleanup"])
+
+
+def main():
+    if os.name == "posix":
+        subprocess.check_call(["./build.py", "release32", "debug32"], cwd=REPO)
+    for task in TASKS:
+        for search in SEARCHES:
+            for debug in [False, True]:
+                expected_code, expected_output = run_search(
+                    task, search.format(pruning=PRUNING, options=""), debug)
+                expected_mugs = parse_mugs(expected_output)
+                for options in COMPACTION_OPTIONS:
+                    code, output = run_search(
+                        task, search.format(pruning=PRUNING, options=options),
+                        debug)
+                    mugs = parse_mugs(output)
+                    if code != expected_code or mugs != expected_mugs:
+                        sys.exit(
+                            "\nError: {} with{} (debug={}) reports {} "
+                            "(exit code {}), expected {} (exit code {})".format(
+                                task, options, debug,
+                                sorted(map(sorted, mugs)), code,
+                                sorted(map(sorted, expected_mugs)),
+                                expected_code))
+                cleanup()
+
+main()
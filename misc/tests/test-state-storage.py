@@ -0,0 +1,92 @@
+#! /usr/bin/env python
+
+"""
+Run searches with the different state storage options (tree-compressed
+states, states spilled to a file-backed arena, hash compaction) and test
+that they behave exactly like searches with the default storage. The
+debug builds additionally check that every compressed state and every
+state on the hash compaction stack decompresses to the original state.
+"""
+
+from __future__ import print_function
+
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+DIR = os.path.dirname(os.path.abspath(__file__))
+REPO = os.path.dirname(os.path.dirname(DIR))
+BENCHMARKS_DIR = os.path.join(REPO, "misc", "tests", "benchmarks")
+FAST_DOWNWARD = os.path.join(REPO, "fast-downward.py")
+
+TASKS = [os.path.join(BENCHMARKS_DIR, path) for path in [
+    "gripper/prob01.pddl",
+    "miconic/s1-0.pddl",
+]]
+
+SEARCHES = [
+    "astar(blind(){options})",
+    "astar(lmcut(){options})",
+    "eager_greedy([ff()]{options})",
+]
+
+# {spill} is replaced by a temporary directory.
+STORAGE_OPTIONS = [
+    ", compress_states=true",
+    ", spill_directory={spill}",
+    ", compress_states=true, spill_directory={spill}",
+]
+
+# Lines that must be equal for all storage options.
+COMPARED_LINES = [
+    re.compile(r"^Plan length: .*$", re.M),
+    re.compile(r"^Plan cost: .*$", re.M),
+    re.compile(r"^Expanded \d+ state\(s\)\.$", re.M),
+    re.compile(r"^Generated \d+ state\(s\)\.$", re.M),
+]
+
+
+def run_search(task, search, debug):
+    cmd = [sys.executable, FAST_DOWNWARD]
+    if debug:
+        cmd.append("--debug")
+    cmd += [task, "--search", search]
+    print("\nRun {}:".format(cmd))
+    sys.stdout.flush()
+    output = subprocess.check_output(cmd, universal_newlines=True)
+    print(output)
+    return [regex.findall(output) for regex in COMPARED_LINES]
+
+
+def cleanup():
+    subprocess.check_call([sys.executable, FAST_DOWNWARD, "--cleanup"])
+
+
+def main():
+    if os.name == "posix":
+        subprocess.check_call(["./build.py", "release32", "debug32"], cwd=REPO)
+    spill_directory = tempfile.mkdtemp()
+    try:
+        for task in TASKS:
+            for search in SEARCHES:
+                for debug in [False, True]:
+                    expected = run_search(
+                        task, search.format(options=""), debug)
+                    for options in STORAGE_OPTIONS:
+                        options = options.format(spill=spill_directory)
+                        result = run_search(
+                            task, search.format(options=options), debug)
+                        if result != expected:
+                            sys.exit(
+                                "\nError: {} with{} (debug={}) reports {}, "
+                                "expected {}".format(
+                                    search.format(options=""), options,
+                                    debug, result, expected))
+                    cleanup()
+    finally:
+        shutil.rmtree(spill_directory)
+
+main()
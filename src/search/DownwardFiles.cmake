@@ -72,6 +72,7 @@ fast_downward_plugin(
         pruning_method
         search_engine
         search_node_info
+        search_profiler
         search_progress
         search_space
         search_statistics
@@ -79,7 +80,7 @@ fast_downward_plugin(
         state_registry
         task_proxy
 
-    DEPENDS CAUSAL_GRAPH INT_HASH_SET INT_PACKER ORDERED_SET SEGMENTED_VECTOR SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES
+    DEPENDS CAUSAL_GRAPH INT_HASH_SET INT_PACKER ORDERED_SET SEGMENTED_VECTOR SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES TREE_COMPRESSED_SET
     CORE_PLUGIN
 )
 
@@ -109,17 +110,22 @@ fast_downward_plugin(
     SOURCES
         utils/collections
         utils/countdown_timer
+        utils/file_backed_arena
         utils/hash
         utils/language
         utils/logging
         utils/markup
         utils/math
+        utils/memory_mapped_file
         utils/memory
+        utils/memory_accounting
         utils/rng
         utils/rng_options
         utils/system
         utils/system_unix
         utils/system_windows
+        utils/thread_pool
+        utils/thread_pool_options
         utils/timer
     CORE_PLUGIN
 )
@@ -182,6 +188,14 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME FINGERPRINT_SET
+    HELP "Compact hash set of 64-bit state fingerprints"
+    SOURCES
+        algorithms/fingerprint_set
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME INT_HASH_SET
     HELP "Hash set storing non-negative integers"
@@ -230,6 +244,15 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME TREE_COMPRESSED_SET
+    HELP "Set of fixed-size arrays with tree compression"
+    SOURCES
+        algorithms/tree_compressed_set
+    DEPENDS INT_HASH_SET SEGMENTED_VECTOR
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME SUBSCRIBER
     HELP "Allows object to subscribe to the destructor of other objects"
@@ -374,12 +397,20 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME PARALLEL_SUCCESSOR_EVALUATOR
+    HELP "Parallel evaluation of successor states"
+    SOURCES
+        search_engines/parallel_successor_evaluator
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME EAGER_SEARCH
     HELP "Eager search algorithm"
     SOURCES
         search_engines/eager_search
-    DEPENDS NULL_PRUNING_METHOD ORDERED_SET SUCCESSOR_GENERATOR
+    DEPENDS NULL_PRUNING_METHOD ORDERED_SET PARALLEL_SUCCESSOR_EVALUATOR SUCCESSOR_GENERATOR
     DEPENDENCY_ONLY
 )
 
@@ -388,7 +419,7 @@ fast_downward_plugin(
     HELP "mugs search"
     SOURCES
         search_engines/mugs_search
-    DEPENDS NULL_PRUNING_METHOD ORDERED_SET SUCCESSOR_GENERATOR
+    DEPENDS CONFLICT_LEARNING FINGERPRINT_SET MUGS_HMAX_HEURISTIC MUGS_PRUNING NULL_PRUNING_METHOD ORDERED_SET PARALLEL_SUCCESSOR_EVALUATOR SUCCESSOR_GENERATOR
     DEPENDENCY_ONLY
 )
 
@@ -433,6 +464,14 @@ fast_downward_plugin(
         DEPENDS MONITOR_SEARCH SEARCH_COMMON
 )
 
+fast_downward_plugin(
+    NAME PARALLEL_EAGER_SEARCH
+    HELP "Parallel A* search with hash-distributed state ownership"
+    SOURCES
+        search_engines/parallel_eager_search
+    DEPENDS SUCCESSOR_GENERATOR
+)
+
 fast_downward_plugin(
     NAME PLUGIN_EAGER
     HELP "Eager (i.e., normal) best-first search"
@@ -697,6 +736,7 @@ fast_downward_plugin(
         cegar/cost_saturation
         cegar/domains
         cegar/refinement_hierarchy
+        cegar/shortest_paths
         cegar/split_selector
         cegar/subtask_generators
         cegar/transition
@@ -800,6 +840,7 @@ fast_downward_plugin(
     SOURCES
         pdbs/canonical_pdbs
         pdbs/canonical_pdbs_heuristic
+        pdbs/distance_table
         pdbs/dominance_pruning
         pdbs/incremental_canonical_pdbs
         pdbs/match_tree
@@ -807,6 +848,7 @@ fast_downward_plugin(
         pdbs/max_cliques
         pdbs/pattern_collection_information
         pdbs/pattern_database
+        pdbs/pattern_collection_generator_cached
         pdbs/pattern_collection_generator_combo
         pdbs/pattern_collection_generator_genetic
         pdbs/pattern_collection_generator_hillclimbing
@@ -815,7 +857,9 @@ fast_downward_plugin(
         pdbs/pattern_generator_greedy
         pdbs/pattern_generator_manual
         pdbs/pattern_generator
+        pdbs/pdb_file
         pdbs/pdb_heuristic
+        pdbs/pdb_lookup
         pdbs/plugin_group
         pdbs/types
         pdbs/validation
@@ -833,6 +877,7 @@ fast_downward_plugin(
         potentials/potential_heuristic
         potentials/potential_max_heuristic
         potentials/potential_optimizer
+        potentials/sample_file
         potentials/sample_based_potential_heuristics
         potentials/single_potential_heuristics
         potentials/util
@@ -875,6 +920,7 @@ fast_downward_plugin(
         conflict_driven_learning/hc_neighbors_refinement
 
         conflict_driven_learning/partial_state_evaluator
+        conflict_driven_learning/bitset_formula
         conflict_driven_learning/trap_unsat_heuristic
         conflict_driven_learning/trap_neighbors_refinement
 
@@ -883,6 +929,9 @@ fast_downward_plugin(
         conflict_driven_learning/mugs_hc_heuristic
         conflict_driven_learning/mugs_uc_refiner
         conflict_driven_learning/mugs_hc_refiner
+
+        conflict_driven_learning/knowledge_pool
+        conflict_driven_learning/portfolio_search
     )
 
 fast_downward_add_plugin_sources(PLANNER_SOURCES)
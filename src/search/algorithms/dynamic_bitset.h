@@ -78,6 +78,14 @@ public:
         return result;
     }
 
+    bool none() const {
+        for (Block block : blocks) {
+            if (block)
+                return false;
+        }
+        return true;
+    }
+
     void set() {
         std::fill(blocks.begin(), blocks.end(), ones);
         zero_unused_bits();
@@ -0,0 +1,94 @@
+#ifndef ALGORITHMS_FINGERPRINT_SET_H
+#define ALGORITHMS_FINGERPRINT_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fingerprint_set {
+/*
+  Set of 64-bit fingerprints (hash values of states) for hash compaction.
+  It uses open addressing with linear probing and stores nothing but the
+  fingerprints, i.e., 8 bytes per slot. The load factor is kept between 3/8
+  and 3/4 (after the first resize). Since the fingerprints are hash values,
+  their lower bits are used as slot indices directly.
+
+  The fingerprint 0 marks empty slots and is mapped to 1 on insertion.
+*/
+class FingerprintSet {
+    std::vector<std::uint64_t> slots;
+    std::size_t num_entries;
+
+    std::size_t get_mask() const {
+        return slots.size() - 1;
+    }
+
+    // Return true if the fingerprint was not contained before.
+    bool insert_into_slots(std::uint64_t fingerprint) {
+        std::size_t mask = get_mask();
+        for (std::size_t index = fingerprint & mask; ; index = (index + 1) & mask) {
+            if (slots[index] == fingerprint) {
+                return false;
+            } else if (slots[index] == 0) {
+                slots[index] = fingerprint;
+                return true;
+            }
+        }
+    }
+
+    void grow() {
+        std::vector<std::uint64_t> old_slots(2 * slots.size(), 0);
+        old_slots.swap(slots);
+        for (std::uint64_t fingerprint : old_slots) {
+            if (fingerprint != 0) {
+                insert_into_slots(fingerprint);
+            }
+        }
+    }
+
+public:
+    FingerprintSet()
+        : slots(1024, 0),
+          num_entries(0) {
+    }
+
+    bool contains(std::uint64_t fingerprint) const {
+        if (fingerprint == 0) {
+            fingerprint = 1;
+        }
+        std::size_t mask = get_mask();
+        for (std::size_t index = fingerprint & mask; ; index = (index + 1) & mask) {
+            if (slots[index] == fingerprint) {
+                return true;
+            } else if (slots[index] == 0) {
+                return false;
+            }
+        }
+    }
+
+    // Return true if the fingerprint was not contained before.
+    bool insert(std::uint64_t fingerprint) {
+        if (fingerprint == 0) {
+            fingerprint = 1;
+        }
+        if (4 * (num_entries + 1) > 3 * slots.size()) {
+            grow();
+        }
+        bool inserted = insert_into_slots(fingerprint);
+        if (inserted) {
+            ++num_entries;
+        }
+        return inserted;
+    }
+
+    std::size_t size() const {
+        return num_entries;
+    }
+
+    std::size_t get_num_bytes() const {
+        return slots.size() * sizeof(std::uint64_t);
+    }
+};
+}
+
+#endif
@@ -279,6 +279,10 @@ public:
         return num_entries;
     }
 
+    std::size_t get_num_bytes() const {
+        return buckets.capacity() * sizeof(Bucket);
+    }
+
     /*
       Insert a key into the hash set.
 
@@ -112,6 +112,12 @@ public:
         return the_size;
     }
 
+    // Number of bytes allocated for the segments (including unused entries).
+    size_t get_num_bytes() const {
+        return segments.size() * SEGMENT_ELEMENTS * sizeof(Entry) +
+               segments.capacity() * sizeof(Entry *);
+    }
+
     void push_back(const Entry &entry) {
         size_t segment = get_segment(the_size);
         size_t offset = get_offset(the_size);
@@ -188,11 +194,11 @@ public:
 
 
     SegmentedArrayVector(size_t elements_per_array_, const ElementAllocator &allocator_)
-        : element_allocator(allocator_),
-          elements_per_array(elements_per_array_),
+        : elements_per_array(elements_per_array_),
           arrays_per_segment(
               std::max(SEGMENT_BYTES / (elements_per_array * sizeof(Element)), size_t(1))),
           elements_per_segment(elements_per_array * arrays_per_segment),
+          element_allocator(allocator_),
           the_size(0) {
     }
 
@@ -228,6 +234,12 @@ public:
         return the_size;
     }
 
+    // Number of bytes allocated for the segments (including unused elements).
+    size_t get_num_bytes() const {
+        return segments.size() * elements_per_segment * sizeof(Element) +
+               segments.capacity() * sizeof(Element *);
+    }
+
     void push_back(const Element *entry) {
         size_t segment = get_segment(the_size);
         size_t offset = get_offset(the_size);
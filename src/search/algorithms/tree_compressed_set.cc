@@ -0,0 +1,112 @@
+#include "tree_compressed_set.h"
+
+#include "../utils/hash.h"
+#include "../utils/memory.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace tree_compressed_set {
+int_hash_set::HashType TreeCompressedSet::NodeHash::operator()(int id) const {
+    Node node = nodes[id];
+    utils::HashState hash_state;
+    hash_state.feed(static_cast<uint32_t>(node >> 32));
+    hash_state.feed(static_cast<uint32_t>(node));
+    return hash_state.get_hash32();
+}
+
+TreeCompressedSet::TreeCompressedSet(
+    int array_size, const shared_ptr<utils::FileBackedArena> &arena)
+    : array_size(array_size),
+      num_leaves(max(2, array_size)) {
+    assert(array_size >= 1);
+    add_positions(0, num_leaves);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        tables.push_back(utils::make_unique_ptr<NodeTable>(arena));
+    }
+}
+
+int TreeCompressedSet::add_positions(int begin, int end) {
+    if (end - begin == 1) {
+        return -1;
+    }
+    int position = positions.size();
+    int middle = begin + (end - begin) / 2;
+    positions.push_back({begin, middle, -1, -1});
+    int left = add_positions(begin, middle);
+    int right = add_positions(middle, end);
+    positions[position].left = left;
+    positions[position].right = right;
+    return position;
+}
+
+pair<int, bool> TreeCompressedSet::insert_node(int position, const Bin *data) {
+    const TreePosition &pos = positions[position];
+    Node left = (pos.left == -1) ?
+        (pos.begin < array_size ? data[pos.begin] : 0) :
+        insert_node(pos.left, data).first;
+    Node right = (pos.right == -1) ?
+        (pos.middle < array_size ? data[pos.middle] : 0) :
+        insert_node(pos.right, data).first;
+
+    /*
+      Add the node to the table and remove it again if the table already
+      contains an equal node (see StateRegistry::insert_id_or_pop_state).
+    */
+    NodeTable &table = *tables[position];
+    table.nodes.push_back((left << 32) | right);
+    pair<int, bool> result = table.index.insert(table.nodes.size() - 1);
+    if (!result.second) {
+        table.nodes.pop_back();
+    }
+    return result;
+}
+
+void TreeCompressedSet::extract_node(int position, int index, Bin *data) const {
+    const TreePosition &pos = positions[position];
+    Node node = tables[position]->nodes[index];
+    Bin left = static_cast<Bin>(node >> 32);
+    Bin right = static_cast<Bin>(node);
+    if (pos.left == -1) {
+        if (pos.begin < array_size) {
+            data[pos.begin] = left;
+        }
+    } else {
+        extract_node(pos.left, left, data);
+    }
+    if (pos.right == -1) {
+        if (pos.middle < array_size) {
+            data[pos.middle] = right;
+        }
+    } else {
+        extract_node(pos.right, right, data);
+    }
+}
+
+pair<int, bool> TreeCompressedSet::insert(const Bin *data) {
+    return insert_node(0, data);
+}
+
+void TreeCompressedSet::get(int index, Bin *data) const {
+    assert(index >= 0 && index < size());
+    extract_node(0, index, data);
+}
+
+size_t TreeCompressedSet::get_num_bytes() const {
+    size_t num_bytes = 0;
+    for (const unique_ptr<NodeTable> &table : tables) {
+        num_bytes += table->nodes.get_num_bytes() + table->index.get_num_bytes();
+    }
+    return num_bytes;
+}
+
+size_t TreeCompressedSet::get_num_nodes() const {
+    size_t num_nodes = 0;
+    for (const unique_ptr<NodeTable> &table : tables) {
+        num_nodes += table->nodes.size();
+    }
+    return num_nodes;
+}
+}
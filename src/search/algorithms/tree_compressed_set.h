@@ -0,0 +1,125 @@
+#ifndef ALGORITHMS_TREE_COMPRESSED_SET_H
+#define ALGORITHMS_TREE_COMPRESSED_SET_H
+
+#include "int_hash_set.h"
+#include "segmented_vector.h"
+
+#include "../utils/file_backed_arena.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace tree_compressed_set {
+/*
+  Set of arrays of a fixed size with tree compression (as in the tree
+  databases of the model checkers LTSmin and SPIN). Every array is split
+  recursively into halves. Each inner node of this binary tree stores the
+  pair of its children: array entries for the leaves and indices into the
+  node tables of the children otherwise. Every position in the tree has its
+  own table, in which each distinct pair is stored only once. An array is
+  identified by the index of its root node, so the indices of the arrays are
+  consecutive and start at 0.
+
+  Arrays that differ only in few entries (like a state and its successors)
+  share most of their nodes, so adding an array usually stores one new node
+  per level (8 bytes each) instead of a full copy. In the worst case, the
+  set needs twice the memory of storing the arrays explicitly. Reading an
+  array requires visiting all of its nodes.
+
+  The nodes can be allocated from a FileBackedArena. The hash indices of
+  the tables stay in RAM.
+*/
+class TreeCompressedSet {
+public:
+    using Bin = unsigned int;
+
+private:
+    // A node stores the pair (left, right) as (left << 32) | right.
+    using Node = std::uint64_t;
+    using NodePool = segmented_vector::SegmentedVector<
+        Node, utils::ArenaAllocator<Node>>;
+
+    struct NodeHash {
+        const NodePool &nodes;
+        explicit NodeHash(const NodePool &nodes)
+            : nodes(nodes) {
+        }
+
+        int_hash_set::HashType operator()(int id) const;
+    };
+
+    struct NodeEqual {
+        const NodePool &nodes;
+        explicit NodeEqual(const NodePool &nodes)
+            : nodes(nodes) {
+        }
+
+        bool operator()(int lhs, int rhs) const {
+            return nodes[lhs] == nodes[rhs];
+        }
+    };
+
+    struct NodeTable {
+        NodePool nodes;
+        int_hash_set::IntHashSet<NodeHash, NodeEqual> index;
+
+        explicit NodeTable(const std::shared_ptr<utils::FileBackedArena> &arena)
+            : nodes(utils::ArenaAllocator<Node>(arena)),
+              index(NodeHash(nodes), NodeEqual(nodes)) {
+        }
+    };
+
+    // Position of an inner node, which covers the entries [begin, end).
+    struct TreePosition {
+        int begin;
+        // The right child covers the entries [middle, end).
+        int middle;
+        // Positions of the children or -1 for leaves (single entries).
+        int left;
+        int right;
+    };
+
+    const int array_size;
+    // Arrays with a single entry are padded with 0, so that there is a root.
+    const int num_leaves;
+    // The root has position 0, the children follow their parents.
+    std::vector<TreePosition> positions;
+    std::vector<std::unique_ptr<NodeTable>> tables;
+
+    int add_positions(int begin, int end);
+    std::pair<int, bool> insert_node(int position, const Bin *data);
+    void extract_node(int position, int index, Bin *data) const;
+
+public:
+    TreeCompressedSet(
+        int array_size, const std::shared_ptr<utils::FileBackedArena> &arena);
+    TreeCompressedSet(const TreeCompressedSet &) = delete;
+    TreeCompressedSet &operator=(const TreeCompressedSet &) = delete;
+
+    /*
+      Insert the array with array_size entries starting at data.
+
+      Return the index of the array and whether the array was inserted or
+      was contained already.
+    */
+    std::pair<int, bool> insert(const Bin *data);
+
+    // Write the array with the given index to data.
+    void get(int index, Bin *data) const;
+
+    // Return the number of arrays in the set.
+    int size() const {
+        return tables[0]->index.size();
+    }
+
+    std::size_t get_num_nodes() const;
+
+    // Number of bytes used by the node tables and their hash indices.
+    std::size_t get_num_bytes() const;
+};
+}
+
+#endif
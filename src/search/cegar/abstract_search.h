@@ -16,38 +16,30 @@ using AbstractStates = std::unordered_set<AbstractState *>;
 using Solution = std::deque<Transition>;
 
 /*
-  Find abstract solutions using A*. Compute g and h values for abstract
-  states.
+  Compute g and h values for abstract states with Dijkstra's algorithm.
+  Abstract solutions are found by ShortestPaths during refinement.
 */
 class AbstractSearch {
-    const std::vector<int> operator_costs;
+    std::vector<int> operator_costs;
     AbstractStates &states;
 
     priority_queues::AdaptiveQueue<AbstractState *> open_queue;
-    Solution solution;
 
     void reset();
 
-    void extract_solution(AbstractState *init, AbstractState *goal);
-
-    AbstractState *astar_search(
-        bool forward,
-        bool use_h,
-        AbstractStates *goals = nullptr);
+    void dijkstra_search(bool forward);
 
 public:
     AbstractSearch(
         std::vector<int> &&operator_costs,
         AbstractStates &states);
 
-    bool find_solution(AbstractState *init, AbstractStates &goals);
+    void set_operator_costs(const std::vector<int> &costs) {
+        operator_costs = costs;
+    }
 
     void forward_dijkstra(AbstractState *init);
     void backwards_dijkstra(const AbstractStates &goals);
-
-    const Solution &get_solution() {
-        return solution;
-    }
 };
 }
 
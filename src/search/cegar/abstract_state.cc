@@ -16,7 +16,8 @@ const int AbstractSearchInfo::UNDEFINED_OPERATOR = -1;
 
 AbstractState::AbstractState(const Domains &domains, Node *node)
     : domains(domains),
-      node(node) {
+      node(node),
+      shortest_path_transition(-1, nullptr) {
 }
 
 AbstractState::AbstractState(AbstractState &&other)
@@ -25,7 +26,8 @@ AbstractState::AbstractState(AbstractState &&other)
       incoming_transitions(move(other.incoming_transitions)),
       outgoing_transitions(move(other.outgoing_transitions)),
       loops(move(other.loops)),
-      search_info(move(other.search_info)) {
+      search_info(move(other.search_info)),
+      shortest_path_transition(other.shortest_path_transition) {
 }
 
 int AbstractState::count(int var) const {
@@ -145,6 +147,11 @@ void AbstractState::set_h_value(int new_h) {
     node->increase_h_value_to(new_h);
 }
 
+void AbstractState::overwrite_h_value(int new_h) {
+    assert(node);
+    node->set_h_value(new_h);
+}
+
 int AbstractState::get_h_value() const {
     assert(node);
     return node->get_h_value();
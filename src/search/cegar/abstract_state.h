@@ -78,6 +78,11 @@ class AbstractState {
 
     AbstractSearchInfo search_info;
 
+    /* First transition on a shortest path to an abstract goal state. Unlike
+       search_info, this survives across refinement steps (see
+       ShortestPaths). */
+    Transition shortest_path_transition;
+
     // Construct instances with factory methods.
     AbstractState(const Domains &domains, Node *node);
 
@@ -119,6 +124,8 @@ public:
     bool includes(const State &concrete_state) const;
 
     void set_h_value(int new_h);
+    // Unlike set_h_value(), this allows decreasing the h value.
+    void overwrite_h_value(int new_h);
     int get_h_value() const;
 
     const Transitions &get_outgoing_transitions() const {
@@ -135,6 +142,14 @@ public:
 
     AbstractSearchInfo &get_search_info() {return search_info;}
 
+    void set_shortest_path_transition(const Transition &transition) {
+        shortest_path_transition = transition;
+    }
+
+    const Transition &get_shortest_path_transition() const {
+        return shortest_path_transition;
+    }
+
     friend std::ostream &operator<<(std::ostream &os, const AbstractState &state) {
         return os << state.domains;
     }
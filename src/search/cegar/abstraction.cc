@@ -79,6 +79,7 @@ Abstraction::Abstraction(
       max_non_looping_transitions(max_non_looping_transitions),
       use_general_costs(use_general_costs),
       abstract_search(task_properties::get_operator_costs(task_proxy), states),
+      shortest_paths(task_properties::get_operator_costs(task_proxy)),
       split_selector(task, pick),
       transition_updater(task_proxy.get_operators()),
       timer(max_time),
@@ -86,6 +87,7 @@ Abstraction::Abstraction(
       deviations(0),
       unmet_preconditions(0),
       unmet_goals(0),
+      maintain_shortest_paths(false),
       debug(debug) {
     assert(max_states >= 1);
     g_log << "Start building abstraction." << endl;
@@ -165,14 +167,16 @@ void Abstraction::build(utils::RandomNumberGenerator &rng) {
     if (task_proxy.get_goals().size() == 1) {
         separate_facts_unreachable_before_goal();
     }
+    shortest_paths.recompute(states, goals);
+    maintain_shortest_paths = true;
     bool found_concrete_solution = false;
     while (may_keep_refining()) {
-        bool found_abstract_solution = abstract_search.find_solution(init, goals);
-        if (!found_abstract_solution) {
+        if (init->get_h_value() == INF) {
             cout << "Abstract problem is unsolvable!" << endl;
             break;
         }
-        unique_ptr<Flaw> flaw = find_flaw(abstract_search.get_solution());
+        unique_ptr<Flaw> flaw = find_flaw(
+            shortest_paths.extract_solution(init, goals));
         if (!flaw) {
             found_concrete_solution = true;
             break;
@@ -188,6 +192,9 @@ void Abstraction::build(utils::RandomNumberGenerator &rng) {
 void Abstraction::refine(AbstractState *state, int var, const vector<int> &wanted) {
     if (debug)
         cout << "Refine " << *state << " for " << var << "=" << wanted << endl;
+    vector<AbstractState *> children;
+    if (maintain_shortest_paths)
+        children = shortest_paths.get_children(state);
     pair<AbstractState *, AbstractState *> new_states = state->split(var, wanted);
     AbstractState *v1 = new_states.first;
     AbstractState *v2 = new_states.second;
@@ -216,6 +223,9 @@ void Abstraction::refine(AbstractState *state, int var, const vector<int> &wante
             cout << "New/additional goal state: " << *v2 << endl;
     }
 
+    if (maintain_shortest_paths)
+        shortest_paths.update_incrementally(children, v1, v2, goals);
+
     int num_states = get_num_states();
     if (num_states % 1000 == 0) {
         g_log << num_states << "/" << max_states << " states, "
@@ -295,6 +305,16 @@ void Abstraction::update_h_and_g_values() {
     abstract_search.forward_dijkstra(init);
 }
 
+void Abstraction::set_operator_costs(const vector<int> &operator_costs) {
+    assert(operator_costs.size() == task_proxy.get_operators().size());
+    abstract_search.set_operator_costs(operator_costs);
+    abstract_search.backwards_dijkstra(goals);
+    for (AbstractState *state : states) {
+        state->overwrite_h_value(state->get_search_info().get_g_value());
+    }
+    abstract_search.forward_dijkstra(init);
+}
+
 int Abstraction::get_h_value_of_initial_state() const {
     return init->get_h_value();
 }
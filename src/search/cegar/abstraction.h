@@ -3,6 +3,7 @@
 
 #include "abstract_search.h"
 #include "refinement_hierarchy.h"
+#include "shortest_paths.h"
 #include "split_selector.h"
 #include "transition_updater.h"
 
@@ -26,7 +27,7 @@ class AbstractState;
 struct Flaw;
 
 /*
-  Store the set of AbstractStates, use AbstractSearch to find abstract
+  Store the set of AbstractStates, use ShortestPaths to find abstract
   solutions, find flaws, use SplitSelector to select splits in case of
   ambiguities, break spurious solutions and maintain the
   RefinementHierarchy.
@@ -38,6 +39,7 @@ class Abstraction {
     const bool use_general_costs;
 
     AbstractSearch abstract_search;
+    ShortestPaths shortest_paths;
     SplitSelector split_selector;
     TransitionUpdater transition_updater;
 
@@ -70,6 +72,10 @@ class Abstraction {
        current states. */
     RefinementHierarchy refinement_hierarchy;
 
+    /* Goal distances are maintained incrementally once the refinement
+       loop has started. */
+    bool maintain_shortest_paths;
+
     const bool debug;
 
     void create_trivial_abstraction();
@@ -139,6 +145,14 @@ public:
     std::vector<int> get_saturated_costs();
 
     int get_h_value_of_initial_state() const;
+
+    /*
+      Recompute all goal and initial state distances for new operator
+      costs. This keeps the abstraction (and hence the refinement
+      hierarchy) unchanged, but stores the new goal distances in it, so
+      h values may decrease.
+    */
+    void set_operator_costs(const std::vector<int> &operator_costs);
 };
 }
 
@@ -12,6 +12,8 @@
 #include "../utils/markup.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
+#include "../utils/thread_pool.h"
+#include "../utils/thread_pool_options.h"
 
 #include <cassert>
 
@@ -25,6 +27,8 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
         opts.get_list<shared_ptr<SubtaskGenerator>>("subtasks");
     shared_ptr<utils::RandomNumberGenerator> rng =
         utils::parse_rng_from_options(opts);
+    shared_ptr<utils::ThreadPool> thread_pool =
+        utils::parse_thread_pool_from_options(opts);
     CostSaturation cost_saturation(
         subtask_generators,
         opts.get<int>("max_states"),
@@ -32,7 +36,8 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
         opts.get<double>("max_time"),
         opts.get<bool>("use_general_costs"),
         static_cast<PickSplit>(opts.get<int>("pick")),
-        *rng);
+        *rng,
+        *thread_pool);
     return cost_saturation.generate_heuristic_functions(
         opts.get<shared_ptr<AbstractTask>>("transform"));
 }
@@ -49,9 +54,11 @@ int AdditiveCartesianHeuristic::compute_heuristic(const GlobalState &global_stat
 }
 
 int AdditiveCartesianHeuristic::compute_heuristic(const State &state) {
+    compute_values(
+        heuristic_functions, *task, state.get_values(), local_state_values,
+        values);
     int sum_h = 0;
-    for (const CartesianHeuristicFunction &function : heuristic_functions) {
-        int value = function.get_value(state);
+    for (int value : values) {
         assert(value >= 0);
         if (value == INF)
             return DEAD_END;
@@ -83,6 +90,15 @@ static Heuristic *_parse(OptionParser &parser) {
             "Automated Planning and Scheduling (ICAPS 2014)",
             "289-297",
             "AAAI Press 2014"));
+    parser.document_note(
+        "Parallel construction",
+        "With num_threads > 1, the abstractions for consecutive subtasks are "
+        "built concurrently and their goal distances are afterwards "
+        "recomputed for the costs that remain after the previous subtasks. "
+        "The resulting heuristic is admissible and deterministic for a fixed "
+        "random_seed and num_threads, but usually differs from the one "
+        "computed with a single thread. The log output of concurrently built "
+        "abstractions is interleaved.");
     parser.document_language_support("action costs", "supported");
     parser.document_language_support("conditional effects", "not supported");
     parser.document_language_support("axioms", "not supported");
@@ -128,6 +144,7 @@ static Heuristic *_parse(OptionParser &parser) {
         "true");
     Heuristic::add_options_to_parser(parser);
     utils::add_rng_options(parser);
+    utils::add_thread_pool_options(parser);
     Options opts = parser.parse();
 
     if (parser.dry_run())
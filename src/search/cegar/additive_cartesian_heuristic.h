@@ -14,6 +14,12 @@ class CartesianHeuristicFunction;
 */
 class AdditiveCartesianHeuristic : public Heuristic {
     const std::vector<CartesianHeuristicFunction> heuristic_functions;
+    /*
+      Memory reused by compute_values(). Copies of the heuristic for other
+      threads (see Heuristic::create_thread_local_copy) have their own.
+    */
+    std::vector<std::vector<int>> local_state_values;
+    std::vector<int> values;
 
     int compute_heuristic(const State &state);
 
@@ -5,14 +5,51 @@ using namespace std;
 namespace cegar {
 CartesianHeuristicFunction::CartesianHeuristicFunction(
     const shared_ptr<AbstractTask> &task,
-    RefinementHierarchy &&hierarchy)
+    const RefinementHierarchy &hierarchy)
     : task(task),
       task_proxy(*task),
-      refinement_hierarchy(move(hierarchy)) {
+      refinement_hierarchy(hierarchy) {
 }
 
 int CartesianHeuristicFunction::get_value(const State &parent_state) const {
     State local_state = task_proxy.convert_ancestor_state(parent_state);
-    return refinement_hierarchy.get_node(local_state)->get_h_value();
+    return refinement_hierarchy.get_h_value(local_state.get_values());
+}
+
+void compute_values(
+    const vector<CartesianHeuristicFunction> &functions,
+    const AbstractTask &parent_task,
+    const vector<int> &parent_state_values,
+    vector<vector<int>> &local_state_values,
+    vector<int> &values) {
+    int num_functions = functions.size();
+    local_state_values.resize(num_functions);
+    values.resize(num_functions);
+    // values[i] is the code of the current node of hierarchy i.
+    int num_active = 0;
+    for (int i = 0; i < num_functions; ++i) {
+        const CartesianHeuristicFunction &function = functions[i];
+        // Assigning the values reuses the memory of the previous call.
+        local_state_values[i] = parent_state_values;
+        function.task->convert_state_values(local_state_values[i], &parent_task);
+        values[i] = function.refinement_hierarchy.get_root();
+        if (!FlatRefinementHierarchy::is_leaf(values[i]))
+            ++num_active;
+    }
+    while (num_active > 0) {
+        for (int i = 0; i < num_functions; ++i) {
+            int code = values[i];
+            if (!FlatRefinementHierarchy::is_leaf(code)) {
+                code = functions[i].refinement_hierarchy.get_child(
+                    code, local_state_values[i]);
+                if (FlatRefinementHierarchy::is_leaf(code))
+                    --num_active;
+                values[i] = code;
+            }
+        }
+    }
+    for (int &value : values) {
+        value = FlatRefinementHierarchy::get_h_value_of_leaf(value);
+    }
 }
 }
@@ -6,23 +6,31 @@
 #include "../task_proxy.h"
 
 #include <memory>
+#include <vector>
 
 class AbstractTask;
 
 namespace cegar {
 /*
-  Store RefinementHierarchy and subtask for looking up heuristic values
-  efficiently.
+  Store a flattened RefinementHierarchy and subtask for looking up
+  heuristic values efficiently.
 */
 class CartesianHeuristicFunction {
     const std::shared_ptr<AbstractTask> task;
     TaskProxy task_proxy;
-    RefinementHierarchy refinement_hierarchy;
+    FlatRefinementHierarchy refinement_hierarchy;
+
+    friend void compute_values(
+        const std::vector<CartesianHeuristicFunction> &functions,
+        const AbstractTask &parent_task,
+        const std::vector<int> &parent_state_values,
+        std::vector<std::vector<int>> &local_state_values,
+        std::vector<int> &values);
 
 public:
     CartesianHeuristicFunction(
         const std::shared_ptr<AbstractTask> &task,
-        RefinementHierarchy &&hierarchy);
+        const RefinementHierarchy &hierarchy);
 
     // Visual Studio 2013 needs an explicit implementation.
     CartesianHeuristicFunction(CartesianHeuristicFunction &&other)
@@ -33,6 +41,23 @@ public:
 
     int get_value(const State &parent_state) const;
 };
+
+/*
+  Set values[i] to functions[i].get_value(parent_state), where the values
+  of parent_state for parent_task are given. The hierarchies
+  are traversed in lock step, one level of all hierarchies per round, so
+  that the memory accesses for different hierarchies can overlap instead
+  of waiting for each other.
+
+  local_state_values receives the states of the subtasks. Callers keep it
+  between calls, so that its memory is reused.
+*/
+extern void compute_values(
+    const std::vector<CartesianHeuristicFunction> &functions,
+    const AbstractTask &parent_task,
+    const std::vector<int> &parent_state_values,
+    std::vector<std::vector<int>> &local_state_values,
+    std::vector<int> &values);
 }
 
 #endif
@@ -12,9 +12,12 @@
 #include "../utils/countdown_timer.h"
 #include "../utils/logging.h"
 #include "../utils/memory.h"
+#include "../utils/rng.h"
+#include "../utils/thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
 
 using namespace std;
 
@@ -37,7 +40,8 @@ CostSaturation::CostSaturation(
     double max_time,
     bool use_general_costs,
     PickSplit pick_split,
-    utils::RandomNumberGenerator &rng)
+    utils::RandomNumberGenerator &rng,
+    utils::ThreadPool &thread_pool)
     : subtask_generators(subtask_generators),
       max_states(max_states),
       max_non_looping_transitions(max_non_looping_transitions),
@@ -45,6 +49,7 @@ CostSaturation::CostSaturation(
       use_general_costs(use_general_costs),
       pick_split(pick_split),
       rng(rng),
+      thread_pool(thread_pool),
       num_abstractions(0),
       num_states(0),
       num_non_looping_transitions(0) {
@@ -78,7 +83,11 @@ vector<CartesianHeuristicFunction> CostSaturation::generate_heuristic_functions(
     utils::reserve_extra_memory_padding(memory_padding_in_mb);
     for (const shared_ptr<SubtaskGenerator> &subtask_generator : subtask_generators) {
         SharedTasks subtasks = subtask_generator->get_subtasks(task);
-        build_abstractions(subtasks, timer, should_abort);
+        if (thread_pool.get_num_threads() > 1) {
+            build_abstractions_in_parallel(subtasks, timer, should_abort);
+        } else {
+            build_abstractions(subtasks, timer, should_abort);
+        }
         if (should_abort())
             break;
     }
@@ -169,6 +178,81 @@ void CostSaturation::build_abstractions(
     }
 }
 
+void CostSaturation::build_abstractions_in_parallel(
+    const vector<shared_ptr<AbstractTask>> &subtasks,
+    const utils::CountdownTimer &timer,
+    function<bool()> should_abort) {
+    int num_subtasks = subtasks.size();
+    int rem_subtasks = num_subtasks;
+    for (int batch_start = 0; batch_start < num_subtasks;) {
+        int batch_size = min(thread_pool.get_num_threads(),
+                             num_subtasks - batch_start);
+
+        /*
+          Fix the inputs of all abstractions of the batch in the main thread
+          and in subtask order, so that the result does not depend on the
+          order in which the threads finish.
+        */
+        int max_states_per_abstraction =
+            max(1, (max_states - num_states) / rem_subtasks);
+        int max_transitions_per_abstraction =
+            max(1, (max_non_looping_transitions - num_non_looping_transitions) /
+                rem_subtasks);
+        double max_time_per_abstraction =
+            timer.get_remaining_time() / rem_subtasks * batch_size;
+        vector<shared_ptr<AbstractTask>> batch_tasks;
+        vector<int> seeds;
+        for (int i = 0; i < batch_size; ++i) {
+            shared_ptr<AbstractTask> subtask = subtasks[batch_start + i];
+            batch_tasks.push_back(get_remaining_costs_task(subtask));
+            seeds.push_back(rng(numeric_limits<int>::max()));
+        }
+
+        vector<unique_ptr<Abstraction>> abstractions(batch_size);
+        thread_pool.run(
+            batch_size,
+            [&](int i) {
+                utils::RandomNumberGenerator local_rng(seeds[i]);
+                abstractions[i] = utils::make_unique_ptr<Abstraction>(
+                    batch_tasks[i],
+                    max_states_per_abstraction,
+                    max_transitions_per_abstraction,
+                    max_time_per_abstraction,
+                    use_general_costs,
+                    pick_split,
+                    local_rng);
+            });
+
+        for (int i = 0; i < batch_size; ++i) {
+            Abstraction &abstraction = *abstractions[i];
+            ++num_abstractions;
+            num_states += abstraction.get_num_states();
+            num_non_looping_transitions +=
+                abstraction.get_num_non_looping_transitions();
+            assert(num_states <= max_states);
+            /*
+              The abstraction was refined for the remaining costs at the
+              start of the batch. Its goal distances have to respect the
+              current remaining costs to be part of a cost partitioning.
+            */
+            if (i > 0) {
+                abstraction.set_operator_costs(remaining_costs);
+            }
+            reduce_remaining_costs(abstraction.get_saturated_costs());
+            heuristic_functions.emplace_back(
+                batch_tasks[i],
+                abstraction.extract_refinement_hierarchy());
+            abstractions[i] = nullptr;
+
+            if (should_abort())
+                return;
+
+            --rem_subtasks;
+        }
+        batch_start += batch_size;
+    }
+}
+
 void CostSaturation::print_statistics(utils::Duration init_time) const {
     g_log << "Done initializing additive Cartesian heuristic" << endl;
     cout << "Time for initializing additive Cartesian heuristic: "
@@ -10,6 +10,7 @@ namespace utils {
 class CountdownTimer;
 class Duration;
 class RandomNumberGenerator;
+class ThreadPool;
 }
 
 namespace cegar {
@@ -22,6 +23,14 @@ class SubtaskGenerator;
   RefinementHierarchies from Abstractions to
   CartesianHeuristicFunctions, allow extracting
   CartesianHeuristicFunctions into AdditiveCartesianHeuristic.
+
+  With several threads, the abstractions for consecutive subtasks are built
+  concurrently in batches of one subtask per thread. All abstractions of a
+  batch are refined for the remaining costs at the start of the batch.
+  Afterwards, the batch is processed in subtask order: each abstraction
+  recomputes its goal distances for the actual remaining costs before its
+  saturated costs are subtracted. This yields a valid cost partitioning
+  that only depends on the random seed and the number of threads.
 */
 class CostSaturation {
     const std::vector<std::shared_ptr<SubtaskGenerator>> subtask_generators;
@@ -31,6 +40,7 @@ class CostSaturation {
     const bool use_general_costs;
     const PickSplit pick_split;
     utils::RandomNumberGenerator &rng;
+    utils::ThreadPool &thread_pool;
 
     std::vector<CartesianHeuristicFunction> heuristic_functions;
     std::vector<int> remaining_costs;
@@ -47,6 +57,10 @@ class CostSaturation {
         const std::vector<std::shared_ptr<AbstractTask>> &subtasks,
         const utils::CountdownTimer &timer,
         std::function<bool()> should_abort);
+    void build_abstractions_in_parallel(
+        const std::vector<std::shared_ptr<AbstractTask>> &subtasks,
+        const utils::CountdownTimer &timer,
+        std::function<bool()> should_abort);
     void print_statistics(utils::Duration init_time) const;
 
 public:
@@ -57,7 +71,8 @@ public:
         double max_time,
         bool use_general_costs,
         PickSplit pick_split,
-        utils::RandomNumberGenerator &rng);
+        utils::RandomNumberGenerator &rng,
+        utils::ThreadPool &thread_pool);
 
     std::vector<CartesianHeuristicFunction> generate_heuristic_functions(
         const std::shared_ptr<AbstractTask> &task);
@@ -2,6 +2,8 @@
 
 #include "../task_proxy.h"
 
+#include <unordered_map>
+
 using namespace std;
 
 namespace cegar {
@@ -58,4 +60,43 @@ Node *RefinementHierarchy::get_node(const State &state) const {
     }
     return current;
 }
+
+
+FlatRefinementHierarchy::FlatRefinementHierarchy(
+    const RefinementHierarchy &hierarchy) {
+    /*
+      Number the inner nodes in depth-first order, visiting left children
+      first. This stores chains of helper nodes contiguously. Right
+      children can be shared by several helper nodes, so we only number
+      each node once.
+    */
+    unordered_map<const Node *, int> node_to_index;
+    vector<const Node *> ordered_nodes;
+    vector<const Node *> stack = {hierarchy.get_root()};
+    while (!stack.empty()) {
+        const Node *node = stack.back();
+        stack.pop_back();
+        if (!node->is_split() || node_to_index.count(node)) {
+            continue;
+        }
+        node_to_index[node] = ordered_nodes.size();
+        ordered_nodes.push_back(node);
+        stack.push_back(node->get_right_child());
+        stack.push_back(node->get_left_child());
+    }
+
+    auto get_code = [&node_to_index](const Node *node) {
+                        if (node->is_split()) {
+                            return node_to_index.at(node);
+                        }
+                        return ~node->get_h_value();
+                    };
+    nodes.reserve(ordered_nodes.size());
+    for (const Node *node : ordered_nodes) {
+        nodes.push_back({node->get_var(), node->get_split_value(),
+                         get_code(node->get_left_child()),
+                         get_code(node->get_right_child())});
+    }
+    root = get_code(hierarchy.get_root());
+}
 }
@@ -42,6 +42,62 @@ public:
 };
 
 
+/*
+  Read-only copy of a RefinementHierarchy in one contiguous array, built
+  once refinement has finished. Every inner node is a fixed-size record
+  that stores the split variable and value and the codes of its children.
+  A non-negative code is the index of an inner node, a negative code c
+  marks a leaf with h value ~c. This avoids a pointer dereference for the
+  leaves and keeps the nodes of a lookup path close together in memory.
+*/
+class FlatRefinementHierarchy {
+    struct FlatNode {
+        int var;
+        int value;
+        int left_child;
+        int right_child;
+    };
+
+    std::vector<FlatNode> nodes;
+    int root;
+
+public:
+    explicit FlatRefinementHierarchy(const RefinementHierarchy &hierarchy);
+
+    static bool is_leaf(int code) {
+        return code < 0;
+    }
+
+    static int get_h_value_of_leaf(int code) {
+        assert(is_leaf(code));
+        return ~code;
+    }
+
+    int get_root() const {
+        return root;
+    }
+
+    // Follow the inner node with the given code for the given state values.
+    int get_child(int code, const std::vector<int> &values) const {
+        assert(!is_leaf(code));
+        const FlatNode &node = nodes[code];
+        return values[node.var] == node.value ? node.right_child : node.left_child;
+    }
+
+    int get_h_value(const std::vector<int> &values) const {
+        int code = root;
+        while (!is_leaf(code)) {
+            code = get_child(code, values);
+        }
+        return get_h_value_of_leaf(code);
+    }
+
+    int get_num_nodes() const {
+        return nodes.size();
+    }
+};
+
+
 class Node {
     static const int LEAF_NODE = -1;
     /*
@@ -96,11 +152,29 @@ public:
 
     Node *get_child(int value) const;
 
+    int get_split_value() const {
+        assert(is_split());
+        return value;
+    }
+
+    Node *get_left_child() const {
+        return left_child;
+    }
+
+    Node *get_right_child() const {
+        return right_child;
+    }
+
     void increase_h_value_to(int new_h) {
         assert(new_h >= h);
         h = new_h;
     }
 
+    // Only needed if the operator costs change after refinement.
+    void set_h_value(int new_h) {
+        h = new_h;
+    }
+
     int get_h_value() const {
         return h;
     }
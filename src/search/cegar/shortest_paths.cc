@@ -0,0 +1,197 @@
+#include "shortest_paths.h"
+
+#include "abstract_state.h"
+#include "utils.h"
+
+#include "../utils/collections.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace cegar {
+static const Transition UNDEFINED_TRANSITION(-1, nullptr);
+
+ShortestPaths::ShortestPaths(vector<int> &&operator_costs)
+    : operator_costs(move(operator_costs)) {
+}
+
+int ShortestPaths::get_cost(int op_id) const {
+    assert(utils::in_bounds(op_id, operator_costs));
+    return operator_costs[op_id];
+}
+
+int ShortestPaths::add_costs(int op_id, int distance) const {
+    int cost = get_cost(op_id);
+    assert(cost >= 0 && distance >= 0);
+    if (cost == INF || distance == INF)
+        return INF;
+    return cost + distance;
+}
+
+void ShortestPaths::recompute(
+    const AbstractStates &states, const AbstractStates &goals) {
+    open_queue.clear();
+    for (AbstractState *state : states) {
+        state->get_search_info().reset();
+        state->set_shortest_path_transition(UNDEFINED_TRANSITION);
+    }
+    for (AbstractState *goal : goals) {
+        goal->get_search_info().decrease_g_value_to(0);
+        open_queue.push(0, goal);
+    }
+    while (!open_queue.empty()) {
+        pair<int, AbstractState *> top_pair = open_queue.pop();
+        int distance = top_pair.first;
+        AbstractState *state = top_pair.second;
+        if (distance > state->get_search_info().get_g_value())
+            continue;
+        for (const Transition &transition : state->get_incoming_transitions()) {
+            AbstractState *pred = transition.target;
+            int pred_distance = add_costs(transition.op_id, distance);
+            if (pred_distance < pred->get_search_info().get_g_value()) {
+                pred->get_search_info().decrease_g_value_to(pred_distance);
+                pred->set_shortest_path_transition(
+                    Transition(transition.op_id, state));
+                open_queue.push(pred_distance, pred);
+            }
+        }
+    }
+    for (AbstractState *state : states) {
+        state->set_h_value(state->get_search_info().get_g_value());
+    }
+}
+
+vector<AbstractState *> ShortestPaths::get_children(AbstractState *state) const {
+    vector<AbstractState *> children;
+    for (const Transition &transition : state->get_incoming_transitions()) {
+        AbstractState *pred = transition.target;
+        if (pred->get_shortest_path_transition() ==
+            Transition(transition.op_id, state)) {
+            children.push_back(pred);
+        }
+    }
+    return children;
+}
+
+void ShortestPaths::mark_dirty_states(
+    const vector<AbstractState *> &candidates, const AbstractStates &goals) {
+    candidate_queue.clear();
+    pending.clear();
+    dirty.clear();
+    for (AbstractState *state : candidates) {
+        int h = state->get_h_value();
+        if (goals.count(state) == 0 && h != INF && pending.insert(state).second)
+            candidate_queue.push(h, state);
+    }
+    while (!candidate_queue.empty()) {
+        AbstractState *state = candidate_queue.pop().second;
+        if (pending.erase(state) == 0)
+            continue;
+        int h = state->get_h_value();
+        /*
+          Processing candidates by increasing h values guarantees that all
+          states with smaller h values that are not dirty now keep their
+          distances. We only rely on these states and therefore ignore
+          zero-cost transitions here.
+        */
+        bool keeps_distance = false;
+        for (const Transition &transition : state->get_outgoing_transitions()) {
+            AbstractState *succ = transition.target;
+            int succ_h = succ->get_h_value();
+            if (succ_h < h && add_costs(transition.op_id, succ_h) == h &&
+                dirty.count(succ) == 0) {
+                state->set_shortest_path_transition(transition);
+                keeps_distance = true;
+                break;
+            }
+        }
+        if (keeps_distance)
+            continue;
+        dirty.insert(state);
+        for (const Transition &transition : state->get_incoming_transitions()) {
+            AbstractState *pred = transition.target;
+            if (pred->get_shortest_path_transition() ==
+                Transition(transition.op_id, state) &&
+                pending.insert(pred).second) {
+                candidate_queue.push(pred->get_h_value(), pred);
+            }
+        }
+    }
+}
+
+void ShortestPaths::recompute_dirty_states() {
+    open_queue.clear();
+    for (AbstractState *state : dirty) {
+        state->get_search_info().reset();
+        state->set_shortest_path_transition(UNDEFINED_TRANSITION);
+    }
+    // All states that are not dirty have their final goal distances.
+    for (AbstractState *state : dirty) {
+        AbstractSearchInfo &search_info = state->get_search_info();
+        for (const Transition &transition : state->get_outgoing_transitions()) {
+            AbstractState *succ = transition.target;
+            if (dirty.count(succ))
+                continue;
+            int distance = add_costs(transition.op_id, succ->get_h_value());
+            if (distance < search_info.get_g_value()) {
+                search_info.decrease_g_value_to(distance);
+                state->set_shortest_path_transition(transition);
+            }
+        }
+        if (search_info.get_g_value() != INF)
+            open_queue.push(search_info.get_g_value(), state);
+    }
+    while (!open_queue.empty()) {
+        pair<int, AbstractState *> top_pair = open_queue.pop();
+        int distance = top_pair.first;
+        AbstractState *state = top_pair.second;
+        if (distance > state->get_search_info().get_g_value())
+            continue;
+        for (const Transition &transition : state->get_incoming_transitions()) {
+            AbstractState *pred = transition.target;
+            if (dirty.count(pred) == 0)
+                continue;
+            int pred_distance = add_costs(transition.op_id, distance);
+            if (pred_distance < pred->get_search_info().get_g_value()) {
+                pred->get_search_info().decrease_g_value_to(pred_distance);
+                pred->set_shortest_path_transition(
+                    Transition(transition.op_id, state));
+                open_queue.push(pred_distance, pred);
+            }
+        }
+    }
+    for (AbstractState *state : dirty) {
+        // Refining never decreases goal distances.
+        state->set_h_value(state->get_search_info().get_g_value());
+    }
+}
+
+void ShortestPaths::update_incrementally(
+    const vector<AbstractState *> &children,
+    AbstractState *v1,
+    AbstractState *v2,
+    const AbstractStates &goals) {
+    assert(goals.count(v1) == 0);
+    vector<AbstractState *> candidates = children;
+    candidates.push_back(v1);
+    candidates.push_back(v2);
+    mark_dirty_states(candidates, goals);
+    if (!dirty.empty())
+        recompute_dirty_states();
+}
+
+Solution ShortestPaths::extract_solution(
+    AbstractState *init, const AbstractStates &goals) const {
+    assert(init->get_h_value() != INF);
+    Solution solution;
+    AbstractState *current = init;
+    while (goals.count(current) == 0) {
+        const Transition &transition = current->get_shortest_path_transition();
+        assert(transition.target && transition.target != current);
+        solution.push_back(transition);
+        current = transition.target;
+    }
+    return solution;
+}
+}
@@ -0,0 +1,75 @@
+#ifndef CEGAR_SHORTEST_PATHS_H
+#define CEGAR_SHORTEST_PATHS_H
+
+#include "abstract_search.h"
+
+#include "../algorithms/priority_queues.h"
+
+#include <vector>
+
+namespace cegar {
+/*
+  Maintain exact goal distances (stored as h values) and a shortest path
+  tree towards the goal states while the abstraction is refined.
+
+  After a state v is split into v1 and v2, only v1, v2 and the states
+  whose shortest path started with a transition into v can have a larger
+  goal distance than before. update_incrementally() checks these states in
+  the order of their old goal distances. A state keeps its distance if it
+  has a transition into a state with a confirmed distance that realizes
+  the old distance. All other states become "dirty" together with their
+  children in the shortest path tree, and only the dirty states are
+  handed to Dijkstra's algorithm. Since refining never decreases goal
+  distances, this is usually a tiny part of the abstraction.
+
+  This replaces running A* from scratch for each abstract solution: an
+  abstract solution is found by following the shortest path transitions
+  from the initial state.
+*/
+class ShortestPaths {
+    const std::vector<int> operator_costs;
+
+    priority_queues::AdaptiveQueue<AbstractState *> candidate_queue;
+    priority_queues::AdaptiveQueue<AbstractState *> open_queue;
+    // Scratch sets reused across updates.
+    AbstractStates pending;
+    AbstractStates dirty;
+
+    int get_cost(int op_id) const;
+    int add_costs(int op_id, int distance) const;
+
+    void mark_dirty_states(
+        const std::vector<AbstractState *> &candidates,
+        const AbstractStates &goals);
+    void recompute_dirty_states();
+
+public:
+    explicit ShortestPaths(std::vector<int> &&operator_costs);
+
+    // Compute all goal distances and the shortest path tree from scratch.
+    void recompute(const AbstractStates &states, const AbstractStates &goals);
+
+    /*
+      Return the states whose shortest path starts with a transition into
+      state. Must be called before state is split.
+    */
+    std::vector<AbstractState *> get_children(AbstractState *state) const;
+
+    /*
+      Repair goal distances after a state has been split into v1 and v2.
+      "children" must be the result of get_children() for the split state
+      and "goals" must already contain the new goal states.
+    */
+    void update_incrementally(
+        const std::vector<AbstractState *> &children,
+        AbstractState *v1,
+        AbstractState *v2,
+        const AbstractStates &goals);
+
+    // Follow the shortest path tree from init. The goal must be reachable.
+    Solution extract_solution(
+        AbstractState *init, const AbstractStates &goals) const;
+};
+}
+
+#endif
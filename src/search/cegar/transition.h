@@ -13,7 +13,7 @@ struct Transition {
           target(state) {
     }
 
-    bool operator==(const Transition &other) {
+    bool operator==(const Transition &other) const {
         return op_id == other.op_id && target == other.target;
     }
 };
@@ -0,0 +1,118 @@
+#include "bitset_formula.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace conflict_driven_learning
+{
+
+BitsetFormula::BitsetFormula()
+    : m_num_conjunctions(0)
+    , m_num_blocks(0)
+    , m_block_capacity(0)
+{}
+
+void BitsetFormula::initialize(
+    const std::vector<unsigned> &var_offset,
+    const std::vector<int> &domain_sizes)
+{
+    assert(var_offset.size() == domain_sizes.size());
+    m_var_offset = var_offset;
+    unsigned num_facts = 0;
+    if (!var_offset.empty()) {
+        num_facts = var_offset.back() + domain_sizes.back();
+    }
+    m_var_offset.push_back(num_facts);
+    m_fact_to_var.resize(num_facts);
+    for (unsigned var = 0; var < domain_sizes.size(); var++) {
+        std::fill(m_fact_to_var.begin() + m_var_offset[var],
+                  m_fact_to_var.begin() + m_var_offset[var + 1],
+                  var);
+    }
+    m_num_conjunctions = 0;
+    m_num_blocks = 0;
+    m_block_capacity = 0;
+    m_compatible.clear();
+}
+
+void BitsetFormula::reserve_blocks(unsigned num_blocks)
+{
+    if (num_blocks <= m_block_capacity) {
+        return;
+    }
+    unsigned capacity = std::max(num_blocks, 2 * m_block_capacity);
+    std::vector<Block> compatible(m_fact_to_var.size() * capacity, 0);
+    for (unsigned fact = 0; fact < m_fact_to_var.size(); fact++) {
+        const Block *row = get_row(fact);
+        std::copy(row, row + m_num_blocks, &compatible[fact * capacity]);
+    }
+    m_compatible.swap(compatible);
+    m_block_capacity = capacity;
+}
+
+void BitsetFormula::insert(const std::vector<unsigned> &conjunction)
+{
+    unsigned id = m_num_conjunctions++;
+    unsigned block = id / BITS_PER_BLOCK;
+    if (block >= m_num_blocks) {
+        reserve_blocks(block + 1);
+        m_num_blocks = block + 1;
+    }
+    Block mask = Block(1) << (id % BITS_PER_BLOCK);
+    for (unsigned fact = 0; fact < m_fact_to_var.size(); fact++) {
+        get_row(fact)[block] |= mask;
+    }
+    for (const unsigned &p : conjunction) {
+        unsigned var = m_fact_to_var[p];
+        for (unsigned q = m_var_offset[var]; q < m_var_offset[var + 1]; q++) {
+            if (q != p) {
+                get_row(q)[block] &= ~mask;
+            }
+        }
+    }
+}
+
+void BitsetFormula::clear()
+{
+    m_num_conjunctions = 0;
+    m_num_blocks = 0;
+    std::fill(m_compatible.begin(), m_compatible.end(), 0);
+}
+
+bool BitsetFormula::contains_subset_of_state(
+    const std::vector<unsigned> &state) const
+{
+    assert(state.size() + 1 == m_var_offset.size());
+    if (m_num_conjunctions == 0 || state.empty()) {
+        return false;
+    }
+    thread_local std::vector<Block> buffer;
+    const Block *first = get_row(state[0]);
+    buffer.assign(first, first + m_num_blocks);
+    Block *acc = buffer.data();
+    for (unsigned i = 1; i < state.size(); i++) {
+        const Block *row = get_row(state[i]);
+        Block any = 0;
+        for (unsigned b = 0; b < m_num_blocks; b++) {
+            acc[b] &= row[b];
+            any |= acc[b];
+        }
+        if (!any) {
+            return false;
+        }
+    }
+    for (unsigned b = 0; b < m_num_blocks; b++) {
+        if (acc[b]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t BitsetFormula::get_memory_in_bytes() const
+{
+    return m_compatible.capacity() * sizeof(Block)
+           + m_fact_to_var.capacity() * sizeof(unsigned);
+}
+
+}
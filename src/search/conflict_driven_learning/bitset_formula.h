@@ -0,0 +1,66 @@
+#ifndef BITSET_FORMULA_H
+#define BITSET_FORMULA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace conflict_driven_learning
+{
+
+/*
+  Set of conjunctions compiled for checking complete states. For every
+  fact p, m_compatible holds a bitset over all conjunctions that has bit c
+  set iff conjunction c is consistent with p, i.e., c does not mention the
+  variable of p or contains p itself. A complete state (one fact per
+  variable) then satisfies c iff bit c is set in the AND of the rows of all
+  its facts. This checks 64 conjunctions per machine word without any
+  per-conjunction dispatch.
+*/
+class BitsetFormula
+{
+    using Block = std::uint64_t;
+    static const unsigned BITS_PER_BLOCK = 64;
+
+    std::vector<unsigned> m_var_offset;
+    std::vector<unsigned> m_fact_to_var;
+    unsigned m_num_conjunctions;
+    unsigned m_num_blocks;
+    unsigned m_block_capacity;
+    // row-major: m_block_capacity blocks for every fact
+    std::vector<Block> m_compatible;
+
+    void reserve_blocks(unsigned num_blocks);
+    Block *get_row(unsigned fact)
+    {
+        return &m_compatible[fact * m_block_capacity];
+    }
+    const Block *get_row(unsigned fact) const
+    {
+        return &m_compatible[fact * m_block_capacity];
+    }
+public:
+    BitsetFormula();
+    /*
+      domain_sizes[var] facts are expected to have the consecutive ids
+      starting at the id of the first fact of var.
+    */
+    void initialize(const std::vector<unsigned> &var_offset,
+                    const std::vector<int> &domain_sizes);
+    void insert(const std::vector<unsigned> &conjunction);
+    void clear();
+    /*
+      state must contain exactly one fact per variable, ordered by variable.
+      Several threads may check states concurrently.
+    */
+    bool contains_subset_of_state(const std::vector<unsigned> &state) const;
+    unsigned size() const
+    {
+        return m_num_conjunctions;
+    }
+    std::size_t get_memory_in_bytes() const;
+};
+
+}
+
+#endif
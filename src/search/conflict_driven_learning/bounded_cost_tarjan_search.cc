@@ -207,9 +207,9 @@ BoundedCostTarjanSearch::expand(const GlobalState& state)
 bool
 BoundedCostTarjanSearch::expand(const GlobalState& state, PerLayerData* layer)
 {
-    static std::vector<OperatorID> aops;
+    thread_local std::vector<OperatorID> aops;
     assert(aops.empty());
-    static ordered_set::OrderedSet<OperatorID> preferred;
+    thread_local ordered_set::OrderedSet<OperatorID> preferred;
     assert(preferred.empty());
 
     int& status = m_state_information[state];
@@ -294,8 +294,8 @@ BoundedCostTarjanSearch::expand(const GlobalState& state, PerLayerData* layer)
 SearchStatus
 BoundedCostTarjanSearch::step()
 {
-    static std::vector<std::pair<int, GlobalState>> component_neighbors;
-    static std::unordered_map<StateID, int> hashed_neighbors;
+    thread_local std::vector<std::pair<int, GlobalState>> component_neighbors;
+    thread_local std::unordered_map<StateID, int> hashed_neighbors;
 
     if (m_solved) {
         Plan plan;
@@ -308,6 +308,10 @@ BoundedCostTarjanSearch::step()
         return SearchStatus::SOLVED;
     }
 
+    if (m_knowledge_exchange != nullptr) {
+        m_knowledge_exchange->notify_step();
+    }
+
     if (m_call_stack.empty()) {
 #if 0
         if (increment_bound_and_push_initial_state()) {
@@ -534,6 +538,9 @@ BoundedCostTarjanSearch::step()
                     SingletonComponent<GlobalState> component(locals.state);
                     c_refinement_toggle = m_refiner->notify(
                         bound - m_current_g, component, *neighbors);
+                    if (m_knowledge_exchange != nullptr) {
+                        m_knowledge_exchange->synchronize();
+                    }
                 }
             } else {
                 assert(m_last_layer != NULL);
@@ -554,6 +561,9 @@ BoundedCostTarjanSearch::step()
                         component(m_last_layer->stack.begin(), component_end);
                     c_refinement_toggle = m_refiner->notify(
                         bound - m_current_g, component, *neighbors);
+                    if (m_knowledge_exchange != nullptr) {
+                        m_knowledge_exchange->synchronize();
+                    }
                 }
                 m_last_layer->stack.erase(
                     m_last_layer->stack.begin(), component_end);
@@ -602,6 +612,9 @@ BoundedCostTarjanSearch::print_statistics() const
     if (m_refiner != nullptr) {
         m_refiner->print_statistics();
     }
+    if (m_knowledge_exchange != nullptr) {
+        m_knowledge_exchange->print_statistics();
+    }
     if (m_expansion_evaluator != nullptr) {
         m_expansion_evaluator->print_evaluator_statistics();
     }
@@ -624,6 +637,23 @@ BoundedCostTarjanSearch::get_heuristic_refinement_time() const
     return m_refiner != nullptr ? m_refiner->get_refinement_timer()() : 0;
 }
 
+void
+BoundedCostTarjanSearch::connect_knowledge_pool(
+    std::shared_ptr<portfolio::KnowledgePool> pool,
+    int worker,
+    int sync_interval)
+{
+    if (m_refiner == nullptr) {
+        return;
+    }
+    m_knowledge_exchange = std::unique_ptr<portfolio::KnowledgeExchange>(
+        new portfolio::KnowledgeExchange(
+            pool,
+            worker,
+            sync_interval,
+            m_refiner->get_underlying_heuristic().get()));
+}
+
 void
 BoundedCostTarjanSearch::add_options_to_parser(options::OptionParser& parser)
 {
@@ -8,6 +8,7 @@
 #include "../global_state.h"
 #include "../evaluator.h"
 #include "heuristic_refiner.h"
+#include "knowledge_pool.h"
 
 #include <map>
 #include <unordered_map>
@@ -19,11 +20,16 @@ class PruningMethod;
 namespace conflict_driven_learning {
 namespace bounded_cost {
 
-class BoundedCostTarjanSearch : public SearchEngine 
+class BoundedCostTarjanSearch : public SearchEngine,
+                                public portfolio::KnowledgeSharingEngine
 {
 public:
     BoundedCostTarjanSearch(const options::Options& opts);
     virtual ~BoundedCostTarjanSearch() = default;
+    virtual void connect_knowledge_pool(
+        std::shared_ptr<portfolio::KnowledgePool> pool,
+        int worker,
+        int sync_interval) override;
     virtual void print_statistics() const override;
     virtual double get_heuristic_refinement_time() const override;
     static void add_options_to_parser(options::OptionParser& parser);
@@ -87,6 +93,7 @@ protected:
     Evaluator* m_pruning_evaluator;
     std::set<Evaluator*> m_path_dependent_evaluators;
     std::shared_ptr<HeuristicRefiner> m_refiner;
+    std::unique_ptr<portfolio::KnowledgeExchange> m_knowledge_exchange;
 
     std::shared_ptr<PruningMethod> m_pruning_method;
 
@@ -174,6 +174,8 @@ public:
     virtual int evaluate_partial_state(const PartialState& state) override;
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) override;
+    // The estimates depend on g and the conflicts learned by this object.
+    virtual bool supports_thread_local_copies() const override { return false; }
     int compute_heuristic_for_facts(const std::vector<unsigned>& fact_ids);
 
     bool set_early_termination(bool t);
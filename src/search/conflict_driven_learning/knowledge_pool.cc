@@ -0,0 +1,171 @@
+#include "knowledge_pool.h"
+
+#include "hc_heuristic.h"
+#include "trap_unsat_heuristic.h"
+
+#include "../evaluator.h"
+
+#include <cassert>
+#include <iostream>
+
+namespace conflict_driven_learning
+{
+namespace portfolio
+{
+
+KnowledgePool::KnowledgePool(size_t capacity)
+    : m_entries(capacity)
+    , m_published(new std::atomic<bool>[capacity])
+    , m_reserved(0)
+    , m_dropped(0)
+{
+    for (size_t i = 0; i < capacity; i++) {
+        m_published[i].store(false, std::memory_order_relaxed);
+    }
+}
+
+bool KnowledgePool::publish(
+    EntryType type,
+    int origin,
+    const std::vector<unsigned> &facts)
+{
+    size_t slot = m_reserved.fetch_add(1, std::memory_order_acq_rel);
+    if (slot >= m_entries.size()) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    Entry &entry = m_entries[slot];
+    entry.type = type;
+    entry.origin = origin;
+    entry.facts = facts;
+    m_published[slot].store(true, std::memory_order_release);
+    return true;
+}
+
+size_t KnowledgePool::size() const
+{
+    return std::min(m_reserved.load(std::memory_order_acquire),
+                    m_entries.size());
+}
+
+size_t KnowledgePool::num_dropped() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+KnowledgeExchange::KnowledgeExchange(
+    std::shared_ptr<KnowledgePool> pool,
+    int worker,
+    int sync_interval,
+    Evaluator *learned_heuristic)
+    : m_pool(pool)
+    , m_worker(worker)
+    , c_sync_interval(sync_interval)
+    , m_hc(dynamic_cast<hc_heuristic::HCHeuristic *>(learned_heuristic))
+    , m_traps(dynamic_cast<traps::TrapUnsatHeuristic *>(learned_heuristic))
+    , m_cursor(0)
+    , m_num_hc_conjunctions_seen(0)
+    , m_steps_since_sync(0)
+    , m_num_published(0)
+    , m_num_imported(0)
+{
+    if (m_hc == nullptr && m_traps == nullptr) {
+        std::cout << "Worker " << m_worker
+                  << ": learned heuristic does not support knowledge sharing"
+                  << std::endl;
+    }
+    // Conjunctions that exist before the search starts were not learned.
+    if (m_hc != nullptr) {
+        m_num_hc_conjunctions_seen = m_hc->num_conjunctions();
+    }
+    if (m_traps != nullptr) {
+        m_trap_known_dead.resize(m_traps->get_num_conjunctions(), false);
+        for (unsigned i = 0; i < m_trap_known_dead.size(); i++) {
+            m_trap_known_dead[i] = !m_traps->can_reach_goal(i);
+        }
+    }
+}
+
+void KnowledgeExchange::notify_step()
+{
+    if (c_sync_interval > 0 && ++m_steps_since_sync >= c_sync_interval) {
+        synchronize();
+    }
+}
+
+void KnowledgeExchange::synchronize()
+{
+    m_steps_since_sync = 0;
+    if (m_hc != nullptr) {
+        publish_conjunctions();
+    }
+    if (m_traps != nullptr) {
+        publish_traps();
+    }
+    m_pool->import(m_worker, m_cursor, [this](const KnowledgePool::Entry &entry) {
+        import_entry(entry);
+    });
+    if (m_hc != nullptr) {
+        m_num_hc_conjunctions_seen = m_hc->num_conjunctions();
+    }
+}
+
+void KnowledgeExchange::publish_conjunctions()
+{
+    for (; m_num_hc_conjunctions_seen < m_hc->num_conjunctions();
+         m_num_hc_conjunctions_seen++) {
+        const std::vector<unsigned> &conj =
+            m_hc->get_conjunction(m_num_hc_conjunctions_seen);
+        if (conj.size() > 1
+            && m_pool->publish(KnowledgePool::EntryType::CONJUNCTION,
+                               m_worker,
+                               conj)) {
+            m_num_published++;
+        }
+    }
+}
+
+void KnowledgeExchange::publish_traps()
+{
+    m_trap_known_dead.resize(m_traps->get_num_conjunctions(), false);
+    for (unsigned i = 0; i < m_trap_known_dead.size(); i++) {
+        if (!m_trap_known_dead[i] && !m_traps->can_reach_goal(i)) {
+            m_trap_known_dead[i] = true;
+            if (m_pool->publish(KnowledgePool::EntryType::TRAP,
+                                m_worker,
+                                m_traps->get_conjunction(i))) {
+                m_num_published++;
+            }
+        }
+    }
+}
+
+void KnowledgeExchange::import_entry(const KnowledgePool::Entry &entry)
+{
+    switch (entry.type) {
+    case KnowledgePool::EntryType::CONJUNCTION:
+        if (m_hc != nullptr
+            && m_hc->insert_conjunction_and_update_data_structures(
+                   entry.facts).second) {
+            m_num_imported++;
+        }
+        break;
+    case KnowledgePool::EntryType::TRAP:
+        if (m_traps != nullptr
+            && m_traps->add_dead_end_conjunction(entry.facts)) {
+            m_num_imported++;
+        }
+        break;
+    }
+}
+
+void KnowledgeExchange::print_statistics() const
+{
+    std::cout << "Worker " << m_worker << " published: " << m_num_published
+              << " entry(s)" << std::endl;
+    std::cout << "Worker " << m_worker << " imported: " << m_num_imported
+              << " entry(s)" << std::endl;
+}
+
+}
+}
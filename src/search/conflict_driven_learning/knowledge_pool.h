@@ -0,0 +1,134 @@
+#ifndef KNOWLEDGE_POOL_H
+#define KNOWLEDGE_POOL_H
+
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+class Evaluator;
+
+namespace conflict_driven_learning
+{
+
+namespace hc_heuristic {
+class HCHeuristic;
+}
+namespace traps {
+class TrapUnsatHeuristic;
+}
+
+namespace portfolio
+{
+
+/*
+  Append-only log of learned knowledge shared between the workers of a
+  parallel portfolio. The capacity is fixed at construction time, so
+  publishing never reallocates and readers never have to lock: a writer
+  reserves a slot by incrementing an atomic counter, fills the slot and
+  then marks it as published. Readers consume the log in order, stopping
+  at the first slot that is reserved but not yet published. Entries that
+  do not fit into the log anymore are dropped (and counted).
+*/
+class KnowledgePool
+{
+public:
+    enum class EntryType {
+        CONJUNCTION = 0,
+        TRAP = 1,
+    };
+
+    struct Entry {
+        EntryType type;
+        int origin;
+        std::vector<unsigned> facts;
+    };
+
+    explicit KnowledgePool(size_t capacity);
+
+    bool publish(EntryType type, int origin, const std::vector<unsigned> &facts);
+
+    /*
+      Calls callback for every published entry from cursor on that was not
+      published by worker, and advances cursor past the consumed entries.
+    */
+    template<typename Callback>
+    void import(int worker, size_t &cursor, const Callback &callback) const
+    {
+        size_t end = std::min(m_reserved.load(std::memory_order_acquire),
+                              m_entries.size());
+        while (cursor < end
+               && m_published[cursor].load(std::memory_order_acquire)) {
+            const Entry &entry = m_entries[cursor];
+            if (entry.origin != worker) {
+                callback(entry);
+            }
+            cursor++;
+        }
+    }
+
+    size_t size() const;
+    size_t num_dropped() const;
+private:
+    std::vector<Entry> m_entries;
+    std::unique_ptr<std::atomic<bool>[]> m_published;
+    std::atomic<size_t> m_reserved;
+    std::atomic<size_t> m_dropped;
+};
+
+/*
+  Per-worker connection between a learned heuristic and the shared pool.
+  Conjunctions added to an h^C heuristic and conjunctions that a trap
+  heuristic has proven to be dead ends are published; the entries of all
+  other workers are imported into the own heuristic. Both kinds of
+  knowledge are task-global, so importing them never affects soundness.
+*/
+class KnowledgeExchange
+{
+public:
+    KnowledgeExchange(std::shared_ptr<KnowledgePool> pool,
+                      int worker,
+                      int sync_interval,
+                      Evaluator *learned_heuristic);
+
+    void notify_step();
+    void synchronize();
+    void print_statistics() const;
+private:
+    void publish_conjunctions();
+    void publish_traps();
+    void import_entry(const KnowledgePool::Entry &entry);
+
+    std::shared_ptr<KnowledgePool> m_pool;
+    const int m_worker;
+    const int c_sync_interval;
+
+    hc_heuristic::HCHeuristic *m_hc;
+    traps::TrapUnsatHeuristic *m_traps;
+
+    size_t m_cursor;
+    size_t m_num_hc_conjunctions_seen;
+    std::vector<bool> m_trap_known_dead;
+    int m_steps_since_sync;
+
+    size_t m_num_published;
+    size_t m_num_imported;
+};
+
+/*
+  Implemented by search engines that can take part in a parallel portfolio
+  and exchange their learned knowledge with the other workers.
+*/
+class KnowledgeSharingEngine
+{
+public:
+    virtual ~KnowledgeSharingEngine() = default;
+    virtual void connect_knowledge_pool(std::shared_ptr<KnowledgePool> pool,
+                                        int worker,
+                                        int sync_interval) = 0;
+};
+
+}
+}
+
+#endif
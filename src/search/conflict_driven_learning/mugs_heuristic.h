@@ -18,6 +18,8 @@ public:
     virtual void print_evaluator_statistics() const override;
     virtual EvaluationResult
     compute_result(EvaluationContext& context) override;
+    // The estimates depend on g and evaluating states records the MUGS.
+    virtual bool supports_thread_local_copies() const override { return false; }
     static void add_options_to_parser(options::OptionParser& parser);
 
     const subgoal_t& get_hard_goal() const { return hard_goal_; }
@@ -0,0 +1,183 @@
+#include "portfolio_search.h"
+
+#include "../option_parser.h"
+#include "../plugin.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/logging.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+namespace conflict_driven_learning
+{
+namespace portfolio
+{
+
+PortfolioSearch::PortfolioSearch(const options::Options &opts)
+    : SearchEngine(opts)
+    , c_sync_interval(opts.get<int>("sync_interval"))
+    , c_silence_workers(opts.get<bool>("silence_workers"))
+    , m_pool(std::make_shared<KnowledgePool>(opts.get<int>("pool_capacity")))
+    , m_winner(-1)
+{
+    /*
+      The axiom evaluator keeps its working data in the (shared) task
+      information and hence cannot be used by several threads at once.
+    */
+    if (task_properties::has_axioms(task_proxy)) {
+        std::cerr << "dfs_portfolio does not support tasks with axioms, "
+                  << "because all workers would share one axiom evaluator."
+                  << std::endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+
+    // Parsing is not thread-safe, so all workers are created up front.
+    const std::vector<options::ParseTree> configs =
+        opts.get_list<options::ParseTree>("engines");
+    for (unsigned i = 0; i < configs.size(); i++) {
+        options::OptionParser parser(configs[i], false);
+        m_engines.push_back(
+            parser.start_parsing<std::shared_ptr<SearchEngine> >());
+        KnowledgeSharingEngine *sharing =
+            dynamic_cast<KnowledgeSharingEngine *>(m_engines.back().get());
+        if (sharing != nullptr) {
+            sharing->connect_knowledge_pool(m_pool, i, c_sync_interval);
+        } else {
+            std::cout << "Worker " << i
+                      << " does not support knowledge sharing" << std::endl;
+        }
+    }
+}
+
+SearchStatus PortfolioSearch::step()
+{
+    std::cout << "Starting portfolio with " << m_engines.size()
+              << " worker(s) ..." << std::endl;
+    std::atomic<int> winner(-1);
+    // The output of concurrent workers would be interleaved line by line.
+    std::unique_ptr<utils::SilentBlock> silent_block;
+    if (c_silence_workers) {
+        silent_block = utils::make_unique_ptr<utils::SilentBlock>(std::cout);
+    }
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < m_engines.size(); i++) {
+        workers.emplace_back([this, i, &winner]() {
+            m_engines[i]->search();
+            SearchStatus status = m_engines[i]->get_status();
+            if (status != SearchStatus::SOLVED
+                && status != SearchStatus::FAILED) {
+                return;
+            }
+            int expected = -1;
+            if (winner.compare_exchange_strong(expected, i)) {
+                for (unsigned j = 0; j < m_engines.size(); j++) {
+                    if (j != i) {
+                        m_engines[j]->request_stop();
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    silent_block.reset();
+
+    m_winner = winner.load();
+    if (m_winner < 0) {
+        std::cout << "No worker completed its search." << std::endl;
+        return SearchStatus::FAILED;
+    }
+    std::cout << "Worker " << m_winner << " completed its search."
+              << std::endl;
+    const SearchEngine &engine = *m_engines[m_winner];
+    run_finished_successfully = engine.run_finished_successfully;
+    if (engine.found_solution()) {
+        set_plan(engine.get_plan());
+        return SearchStatus::SOLVED;
+    }
+    return SearchStatus::FAILED;
+}
+
+void PortfolioSearch::print_statistics() const
+{
+    for (unsigned i = 0; i < m_engines.size(); i++) {
+        std::cout << "Statistics of worker " << i << ":" << std::endl;
+        m_engines[i]->print_statistics();
+    }
+    std::cout << "Shared knowledge pool: " << m_pool->size() << " entry(s), "
+              << m_pool->num_dropped() << " dropped" << std::endl;
+    if (m_winner >= 0) {
+        std::cout << "Winning worker: " << m_winner << std::endl;
+    }
+}
+
+double PortfolioSearch::get_heuristic_refinement_time() const
+{
+    if (m_winner >= 0) {
+        return m_engines[m_winner]->get_heuristic_refinement_time();
+    }
+    return 0;
+}
+
+void PortfolioSearch::add_options_to_parser(options::OptionParser &parser)
+{
+    parser.add_list_option<options::ParseTree>(
+        "engines",
+        "search engines that are run in parallel, one thread each");
+    parser.add_option<int>(
+        "sync_interval",
+        "number of search steps after which a worker publishes and imports "
+        "learned knowledge (in addition to after every refinement); "
+        "0 only synchronizes after refinements",
+        "1000",
+        options::Bounds("0", "infinity"));
+    parser.add_option<int>(
+        "pool_capacity",
+        "maximal number of entries in the shared knowledge pool",
+        "1000000",
+        options::Bounds("1", "infinity"));
+    parser.add_option<bool>(
+        "silence_workers",
+        "discard the output of the workers while they run, since the lines "
+        "of concurrent workers are interleaved; the statistics of all "
+        "workers are printed afterwards",
+        "true");
+    SearchEngine::add_options_to_parser(parser);
+}
+
+}
+}
+
+static std::shared_ptr<SearchEngine>
+_parse(options::OptionParser& parser)
+{
+    parser.document_synopsis(
+        "Parallel portfolio of conflict-driven searches",
+        "All engines run concurrently on the same task and share their "
+        "learned conjunctions and traps.");
+    parser.document_note(
+        "Note",
+        "Every engine must use its own evaluators. Heuristic predefinitions "
+        "must not be shared between the engines of a portfolio.");
+    parser.document_language_support("axioms", "not supported");
+    conflict_driven_learning::portfolio::PortfolioSearch::add_options_to_parser(parser);
+    options::Options opts = parser.parse();
+    opts.verify_list_non_empty<options::ParseTree>("engines");
+    if (parser.help_mode()) {
+        return nullptr;
+    } else if (parser.dry_run()) {
+        for (const options::ParseTree &config :
+             opts.get_list<options::ParseTree>("engines")) {
+            options::OptionParser test_parser(config, true);
+            test_parser.start_parsing<std::shared_ptr<SearchEngine> >();
+        }
+        return nullptr;
+    }
+    return std::make_shared<conflict_driven_learning::portfolio::PortfolioSearch>(opts);
+}
+
+static PluginShared<SearchEngine> _plugin("dfs_portfolio", _parse);
@@ -0,0 +1,44 @@
+#ifndef PORTFOLIO_SEARCH_H
+#define PORTFOLIO_SEARCH_H
+
+#include "knowledge_pool.h"
+
+#include "../option_parser_util.h"
+#include "../search_engine.h"
+
+#include <memory>
+#include <vector>
+
+namespace conflict_driven_learning
+{
+namespace portfolio
+{
+
+/*
+  Runs several differently configured conflict-driven searches on the same
+  task, each in its own thread. Whatever the workers learn is published to
+  a shared KnowledgePool from which every worker periodically imports. The
+  first worker that either finds a plan or proves the task unsolvable stops
+  all others.
+*/
+class PortfolioSearch : public SearchEngine
+{
+public:
+    PortfolioSearch(const options::Options &opts);
+    virtual void print_statistics() const override;
+    virtual double get_heuristic_refinement_time() const override;
+    static void add_options_to_parser(options::OptionParser &parser);
+protected:
+    virtual SearchStatus step() override;
+
+    const int c_sync_interval;
+    const bool c_silence_workers;
+    std::shared_ptr<KnowledgePool> m_pool;
+    std::vector<std::shared_ptr<SearchEngine> > m_engines;
+    int m_winner;
+};
+
+}
+}
+
+#endif
@@ -141,7 +141,7 @@ void QuantitativeStateMinimizationNoGoods::synchronize_goal(std::shared_ptr<Abst
 {
     m_task = task;
 
-    static std::vector<unsigned> goal_conjunctions;
+    thread_local std::vector<unsigned> goal_conjunctions;
 
     for (int i = m_clause_value.size() - 1; i >= 0; i--) {
         m_clause_value[i] = 0;
@@ -74,8 +74,8 @@ void StateMinimizationNoGoods::refine(
 {
     bool term = m_hc->set_early_termination_and_nogoods(false);
 
-    static std::vector<unsigned> new_facts;
-    static std::vector<unsigned> reachable;
+    thread_local std::vector<unsigned> new_facts;
+    thread_local std::vector<unsigned> reachable;
     for (unsigned i = 0;;) {
         assert(i < m_var_orders.size());
         assert(m_var_orders[i].size() == (unsigned) m_task->get_num_variables());
@@ -131,8 +131,8 @@ void StateMinimizationNoGoods::synchronize_goal(std::shared_ptr<AbstractTask> ta
 {
     m_task = task;
 
-    static std::vector<bool> x;
-    static std::vector<unsigned> goal_conjunctions;
+    thread_local std::vector<bool> x;
+    thread_local std::vector<unsigned> goal_conjunctions;
     x.resize(m_clauses.size());
     std::fill(x.begin(), x.end(), false);
 
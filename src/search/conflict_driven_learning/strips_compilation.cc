@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <iostream>
 #include <cstdio>
+#include <mutex>
 
 namespace conflict_driven_learning
 {
@@ -19,6 +20,27 @@ static size_t _num_facts = -1;
 static Task strips_task;
 static std::vector<unsigned> variable_offset;
 static const AbstractTask* abstract_task_ref = NULL;
+// Serializes the compilation and the goal updates of concurrent users.
+static std::mutex compilation_mutex;
+
+/*
+  The goal is only written if it changes, so that users that share the
+  compiled task and set the same goal do not write concurrently to data
+  that other threads read.
+*/
+static void set_goal(const AbstractTask& task)
+{
+    std::vector<unsigned> goal;
+    goal.reserve(task.get_num_goals());
+    for (int i = 0; i < task.get_num_goals(); i++) {
+        auto g = task.get_goal_fact(i);
+        goal.push_back(variable_offset[g.var] + g.value);
+    }
+    std::sort(goal.begin(), goal.end());
+    if (goal != strips_task.m_goal) {
+        strips_task.m_goal.swap(goal);
+    }
+}
 
 void get_fact_ids(std::vector<unsigned>& fact_ids, const GlobalState& state)
 {
@@ -66,6 +88,7 @@ const Task &get_task()
 
 void initialize(const AbstractTask& task)
 {
+    std::lock_guard<std::mutex> lock(compilation_mutex);
 #if 0
     if (&task == abstract_task_ref) {
         return;
@@ -85,7 +108,7 @@ void initialize(const AbstractTask& task)
     if (_initialized) {
         if (abstract_task_ref != &task) {
             abstract_task_ref = &task;
-            update_goal_set(task);
+            set_goal(task);
         }
         return;
     }
@@ -197,7 +220,7 @@ void initialize(const AbstractTask& task)
         action.del.erase(std::unique(action.del.begin(), action.del.end()), action.del.end());
     }
 
-    update_goal_set(task);
+    set_goal(task);
 
     /* printf("Convertion completed in %.4fs.\n", tconversion()); */
     /* printf("STRIPS task consists of %zu facts and %zu actions.\n", */
@@ -207,13 +230,8 @@ void initialize(const AbstractTask& task)
 
 void update_goal_set(const AbstractTask& task)
 {
-    strips_task.m_goal.clear();
-    strips_task.m_goal.reserve(task.get_num_goals());
-    for (int i = 0; i < task.get_num_goals(); i++) {
-        auto g = task.get_goal_fact(i);
-        strips_task.m_goal.push_back(variable_offset[g.var] + g.value);
-    }
-    std::sort(strips_task.m_goal.begin(), strips_task.m_goal.end());
+    std::lock_guard<std::mutex> lock(compilation_mutex);
+    set_goal(task);
 }
 
 bool Task::contains_mutex(const std::vector<unsigned> &subgoal) const
@@ -75,6 +75,14 @@ struct Task {
                           const std::vector<unsigned> &y);
 };
 
+/*
+  The STRIPS compilation is computed once and shared by all heuristics and
+  refiners, also by those of concurrently running searches (see
+  dfs_portfolio). Initialization and goal updates are serialized, but the
+  compiled task is read without synchronization, so concurrent users must
+  work on the same task with the same goal. Tasks with axioms or
+  conditional effects are not supported.
+*/
 void initialize(const AbstractTask& task);
 void update_goal_set(const AbstractTask& task);
 const Task &get_task();
@@ -74,6 +74,21 @@ TarjanSearch::TarjanSearch(const options::Options &opts)
     }
 }
 
+void TarjanSearch::connect_knowledge_pool(
+    std::shared_ptr<portfolio::KnowledgePool> pool,
+    int worker,
+    int sync_interval)
+{
+    if (m_learner == nullptr) {
+        return;
+    }
+    m_knowledge_exchange = std::unique_ptr<portfolio::KnowledgeExchange>(
+        new portfolio::KnowledgeExchange(pool,
+                                         worker,
+                                         sync_interval,
+                                         m_learner->get_underlying_heuristic()));
+}
+
 void TarjanSearch::initialize()
 {
     std::cout << "Initializing tarjan search ..." << std::endl;
@@ -149,8 +164,8 @@ int TarjanSearch::get_h_value() const
 
 bool TarjanSearch::expand(const GlobalState& state)
 {
-    static std::vector<OperatorID> aops;
-    static ordered_set::OrderedSet<OperatorID> preferred;
+    thread_local std::vector<OperatorID> aops;
+    thread_local ordered_set::OrderedSet<OperatorID> preferred;
 
     SearchNode node = m_search_space[state];
     m_open_states--;
@@ -232,7 +247,7 @@ bool TarjanSearch::expand(const GlobalState& state)
 
 SearchStatus TarjanSearch::step()
 {
-    static StateSet recognized_neighbors;
+    thread_local StateSet recognized_neighbors;
 
     if (m_result == DFSResult::SOLVED) {
         this->run_finished_successfully = true;
@@ -244,6 +259,10 @@ SearchStatus TarjanSearch::step()
         return SearchStatus::FAILED;
     }
 
+    if (m_knowledge_exchange != nullptr) {
+        m_knowledge_exchange->notify_step();
+    }
+
     CallStackElement& elem = m_call_stack.back();
 
     bool in_dead_end_component = false;
@@ -416,6 +435,9 @@ SearchStatus TarjanSearch::step()
                         StateComponentIterator<std::deque<GlobalState>::iterator>(m_stack.begin(), it),
                         StateComponentIterator<StateSet::iterator>(recognized_neighbors.begin(), recognized_neighbors.end()));
                 recognized_neighbors.clear();
+                if (m_knowledge_exchange != nullptr) {
+                    m_knowledge_exchange->synchronize();
+                }
                 if (!c_dead_end_refinement && c_compute_recognized_neighbors) {
                     c_compute_recognized_neighbors = false;
                     m_recognized_neighbors.clear();
@@ -457,6 +479,9 @@ void TarjanSearch::print_statistics() const
     if (m_learner != nullptr) {
         m_learner->print_statistics();
     }
+    if (m_knowledge_exchange != nullptr) {
+        m_knowledge_exchange->print_statistics();
+    }
     if (m_dead_end_identifier != nullptr) {
         m_dead_end_identifier->print_evaluator_statistics();
     }
@@ -10,6 +10,7 @@
 #include "search_space.h"
 #include "layered_map.h"
 #include "conflict_learner.h"
+#include "knowledge_pool.h"
 
 #include <memory>
 #include <vector>
@@ -25,10 +26,14 @@ namespace tarjan_search
 
 using SearchSpace = SearchSpaceBase<SearchNodeInfo, SearchNode>;
 
-class TarjanSearch : public SearchEngine
+class TarjanSearch : public SearchEngine, public portfolio::KnowledgeSharingEngine
 {
 public:
     TarjanSearch(const options::Options &opts);
+    virtual void connect_knowledge_pool(
+        std::shared_ptr<portfolio::KnowledgePool> pool,
+        int worker,
+        int sync_interval) override;
     virtual void print_statistics() const override;
     virtual double get_heuristic_refinement_time() const override;
     static void add_options_to_parser(options::OptionParser &parser);
@@ -69,6 +74,7 @@ protected:
     Evaluator* m_preferred;
     std::set<Evaluator*> m_path_dependent_evaluators;
     std::shared_ptr<ConflictLearner> m_learner;
+    std::unique_ptr<portfolio::KnowledgeExchange> m_knowledge_exchange;
     Evaluator* m_dead_end_identifier;
 
     std::shared_ptr<PruningMethod> m_pruning_method;
@@ -19,6 +19,7 @@ namespace traps {
 TrapUnsatHeuristic::TrapUnsatHeuristic(const options::Options& opts)
     : Heuristic(opts)
     , c_updatable_transitions(opts.get<bool>("update_transitions"))
+    , c_bitset_evaluation(opts.get<bool>("bitset_evaluation"))
     , m_progression_ids(
             10000,
             hash_utils::SegVecIdHash<unsigned>(m_cached_progressions),
@@ -28,6 +29,15 @@ TrapUnsatHeuristic::TrapUnsatHeuristic(const options::Options& opts)
     m_task = &strips::get_task();
     m_formula.set_num_keys(strips::num_facts());
     m_formula_all.set_num_keys(strips::num_facts());
+    if (c_bitset_evaluation) {
+        std::vector<unsigned> var_offset(task->get_num_variables());
+        std::vector<int> domain_sizes(task->get_num_variables());
+        for (int var = 0; var < task->get_num_variables(); var++) {
+            var_offset[var] = strips::get_fact_id(var, 0);
+            domain_sizes[var] = task->get_variable_domain_size(var);
+        }
+        m_bitset_formula.initialize(var_offset, domain_sizes);
+    }
     if (c_updatable_transitions) {
         m_progression_lookup.set_num_keys(strips::num_facts());
     }
@@ -45,6 +55,11 @@ TrapUnsatHeuristic::add_options_to_parser(options::OptionParser& parser)
     parser.add_option<int>("k", "", "0");
     parser.add_list_option<Evaluator *>("evals", "", "[]");
     parser.add_option<bool>("update_transitions", "", "false");
+    parser.add_option<bool>(
+        "bitset_evaluation",
+        "check states against a bitset compilation of the dead-end "
+        "conjunctions instead of traversing the UB-tree",
+        "true");
     Heuristic::add_options_to_parser(parser);
 }
 
@@ -182,6 +197,11 @@ TrapUnsatHeuristic::initialize(unsigned k)
     std::cout << "Initialized trap with " << m_formula.size()
               << " conjunctions after " << initialiation_t
               << std::endl;
+    if (c_bitset_evaluation) {
+        std::cout << "Bitset formula size: "
+                  << m_bitset_formula.get_memory_in_bytes() << " bytes"
+                  << std::endl;
+    }
 }
 
 void
@@ -204,6 +224,7 @@ TrapUnsatHeuristic::set_abstract_task(std::shared_ptr<AbstractTask> task)
         }
     }
     m_formula.clear();
+    m_bitset_formula.clear();
     propagate_reachability_setup_formula();
 }
 
@@ -219,11 +240,15 @@ TrapUnsatHeuristic::compute_heuristic(const std::vector<unsigned> &state)
 int
 TrapUnsatHeuristic::compute_heuristic(const GlobalState &state)
 {
-    static std::vector<unsigned> state_fact_ids;
+    thread_local std::vector<unsigned> state_fact_ids;
     state_fact_ids.clear();
     for (int var = 0; var < task->get_num_variables(); var++) {
         state_fact_ids.push_back(strips::get_fact_id(var, state[var]));
     }
+    if (c_bitset_evaluation) {
+        return m_bitset_formula.contains_subset_of_state(state_fact_ids)
+               ? DEAD_END : 0;
+    }
     return compute_heuristic(state_fact_ids);
 }
 
@@ -279,68 +304,6 @@ TrapUnsatHeuristic::are_mutex(const std::vector<unsigned> &phi,
     return false;
 }
 
-bool
-TrapUnsatHeuristic::for_every_progression_action(
-        const std::vector<unsigned>& phi,
-        std::function<bool(unsigned)> callback)
-{
-    static std::vector<bool> closed;
-    closed.resize(m_task->num_actions());
-    std::fill(closed.begin(), closed.end(), false);
-    bool skip = false;
-    for (const unsigned& p : phi) {
-        const std::vector<unsigned>& ops = m_task->get_actions_with_del(p);
-        for (const unsigned& op : ops) {
-            if (!closed[op]) {
-                closed[op] = true;
-                if (!are_mutex(phi, op)) {
-                    if (callback(op)) {
-                        skip = true;
-                        break;
-                    }
-                }
-            }
-        }
-        if (skip) {
-            break;
-        }
-    }
-    return skip;
-}
-
-bool
-TrapUnsatHeuristic::for_every_regression_action(
-        const std::vector<unsigned>& conj,
-        std::function<bool(unsigned)> callback)
-{
-    static std::vector<bool> closed;
-    closed.resize(m_task->num_actions());
-    std::fill(closed.begin(), closed.end(), false);
-    for (const unsigned& p : conj) {
-        const std::vector<unsigned>& ops = m_task->get_actions_with_del(p);
-        for (const unsigned& op : ops) {
-            closed[op] = true;
-        }
-    }
-    for (const unsigned& p : conj) {
-        const std::vector<unsigned>& ops = m_task->get_actions_with_add(p);
-        bool done = false;
-        for (const unsigned& op : ops) {
-            if (!closed[op]) {
-                closed[op] = true;
-                if (callback(op)) {
-                    done = true;
-                    break;
-                }
-            }
-        }
-        if (done) {
-            return true;
-        }
-    }
-    return false;
-}
-
 void
 TrapUnsatHeuristic::propagate_reachability_setup_formula()
 {
@@ -354,7 +317,7 @@ TrapUnsatHeuristic::propagate_reachability_setup_formula()
         for (unsigned i = 0; i < m_conjunctions.size(); i++) {
             if (m_goal_reachable[i] == 0 && are_dead_ends(m_conjunctions[i])) {
                 m_goal_reachable[i] = -1;
-                m_formula.insert(m_conjunctions[i]);
+                insert_dead_end(m_conjunctions[i]);
             }
         }
         update_reachability_insert_conjunctions<true>();
@@ -404,12 +367,12 @@ TrapUnsatHeuristic::insert_conjunction(
         assert(m_mutex_with_goal[conj_id]);
         if (m_goal_reachable[conj_id] == 1) {
             m_goal_reachable[conj_id] = 0;
-            m_formula.insert(conj);
+            insert_dead_end(conj);
         }
         return std::pair<unsigned, bool>(conj_id, false);
     } else {
         m_conjunctions.push_back(conj);
-        m_formula.insert(conj);
+        insert_dead_end(conj);
         m_formula_all.insert(conj);
         m_mutex_with_goal.push_back(true);
         m_goal_reachable.push_back(0);
@@ -426,6 +389,30 @@ TrapUnsatHeuristic::insert_conjunction(
     }
 }
 
+const std::vector<unsigned>&
+TrapUnsatHeuristic::get_conjunction(unsigned conj_id) const
+{
+    return m_conjunctions[conj_id];
+}
+
+bool
+TrapUnsatHeuristic::add_dead_end_conjunction(const std::vector<unsigned>& conj)
+{
+    if (m_formula.contains_subset_of(conj)) {
+        return false;
+    }
+    insert_dead_end(conj);
+    return true;
+}
+
+void
+TrapUnsatHeuristic::insert_dead_end(const std::vector<unsigned>& conj)
+{
+    if (m_formula.insert(conj).second && c_bitset_evaluation) {
+        m_bitset_formula.insert(conj);
+    }
+}
+
 void
 TrapUnsatHeuristic::set_transitions(
         unsigned conj_id,
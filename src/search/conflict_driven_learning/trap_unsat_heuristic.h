@@ -1,23 +1,20 @@
 #ifndef TRAP_UNSAT_HEURISTIC_H
 #define TRAP_UNSAT_HEURISTIC_H
 
+#include "bitset_formula.h"
 #include "formula.h"
 #include "hash_utils.h"
+#include "strips_compilation.h"
 #include "../heuristic.h"
 #include "../algorithms/segmented_vector.h"
 
 #include <vector>
-#include <functional>
 #include <unordered_set>
 
 namespace conflict_driven_learning {
 
 class PartialStateEvaluator;
 
-namespace strips {
-struct Task;
-}
-
 namespace traps {
 
 struct ForwardHyperTransition {
@@ -39,12 +36,14 @@ public:
     virtual ~TrapUnsatHeuristic() = default;
     virtual void set_abstract_task(std::shared_ptr<AbstractTask> task) override;
 
+    template<typename Callback>
     bool for_every_regression_action(
             const std::vector<unsigned>& conj,
-            std::function<bool(unsigned)> callback);
+            const Callback& callback);
+    template<typename Callback>
     bool for_every_progression_action(
             const std::vector<unsigned>& conj,
-            std::function<bool(unsigned)> callback);
+            const Callback& callback);
     void progression(const std::vector<unsigned>& conj,
                      unsigned op,
                      std::vector<unsigned>& post);
@@ -55,6 +54,10 @@ public:
     bool evaluate_check_dead_end(const GlobalState& state);
 
     std::pair<unsigned, bool> insert_conjunction(const std::vector<unsigned>& conj);
+    const std::vector<unsigned>& get_conjunction(unsigned conj_id) const;
+    // adds a conjunction that is known to be a dead end without computing
+    // its transitions (e.g., when it was proven by another search)
+    bool add_dead_end_conjunction(const std::vector<unsigned>& conj);
     void set_transitions(unsigned conj_id, std::vector<ForwardHyperTransition>&& transitions);
 
     template<bool Eval = false>
@@ -72,6 +75,7 @@ protected:
     bool are_mutex(const std::vector<unsigned>& conj, unsigned op) const;
 
     void propagate_reachability_setup_formula();
+    void insert_dead_end(const std::vector<unsigned>& conj);
 
     struct HyperTransitionReference {
         unsigned label;
@@ -103,6 +107,7 @@ protected:
     };
 
     const bool c_updatable_transitions;
+    const bool c_bitset_evaluation;
 
     std::vector<PartialStateEvaluator*> m_evaluators;
     const conflict_driven_learning::strips::Task *m_task;
@@ -125,9 +130,75 @@ protected:
     CounterBasedFormula m_progression_lookup;
 
     UBTreeFormula<unsigned> m_formula;
+    // same conjunctions as m_formula, compiled for complete states
+    BitsetFormula m_bitset_formula;
     Formula m_formula_all;
 };
 
+template<typename Callback>
+bool
+TrapUnsatHeuristic::for_every_progression_action(
+        const std::vector<unsigned>& phi,
+        const Callback& callback)
+{
+    thread_local std::vector<bool> closed;
+    closed.resize(m_task->num_actions());
+    std::fill(closed.begin(), closed.end(), false);
+    bool skip = false;
+    for (const unsigned& p : phi) {
+        const std::vector<unsigned>& ops = m_task->get_actions_with_del(p);
+        for (const unsigned& op : ops) {
+            if (!closed[op]) {
+                closed[op] = true;
+                if (!are_mutex(phi, op)) {
+                    if (callback(op)) {
+                        skip = true;
+                        break;
+                    }
+                }
+            }
+        }
+        if (skip) {
+            break;
+        }
+    }
+    return skip;
+}
+
+template<typename Callback>
+bool
+TrapUnsatHeuristic::for_every_regression_action(
+        const std::vector<unsigned>& conj,
+        const Callback& callback)
+{
+    thread_local std::vector<bool> closed;
+    closed.resize(m_task->num_actions());
+    std::fill(closed.begin(), closed.end(), false);
+    for (const unsigned& p : conj) {
+        const std::vector<unsigned>& ops = m_task->get_actions_with_del(p);
+        for (const unsigned& op : ops) {
+            closed[op] = true;
+        }
+    }
+    for (const unsigned& p : conj) {
+        const std::vector<unsigned>& ops = m_task->get_actions_with_add(p);
+        bool done = false;
+        for (const unsigned& op : ops) {
+            if (!closed[op]) {
+                closed[op] = true;
+                if (callback(op)) {
+                    done = true;
+                    break;
+                }
+            }
+        }
+        if (done) {
+            return true;
+        }
+    }
+    return false;
+}
+
 
 template<bool Eval>
 void
@@ -192,7 +263,7 @@ TrapUnsatHeuristic::update_reachability_insert_conjunctions()
 
     for (unsigned i = 0; i < m_conjunctions.size(); i++) {
         if (!was_unreachable[i] && m_goal_reachable[i] <= 0) {
-            m_formula.insert(m_conjunctions[i]);
+            insert_dead_end(m_conjunctions[i]);
         }
     }
 }
@@ -2,6 +2,7 @@
 
 #include "evaluation_result.h"
 #include "evaluator.h"
+#include "search_profiler.h"
 #include "search_statistics.h"
 
 #include <cassert>
@@ -34,7 +35,14 @@ EvaluationContext::EvaluationContext(
 const EvaluationResult &EvaluationContext::get_result(Evaluator *evaluator) {
     EvaluationResult &result = cache[evaluator];
     if (result.is_uninitialized()) {
-        result = evaluator->compute_result(*this);
+        if (g_search_profiler.is_enabled()) {
+            SearchProfiler::ScopedTimer timer(
+                g_search_profiler,
+                evaluator->get_profiler_component());
+            result = evaluator->compute_result(*this);
+        } else {
+            result = evaluator->compute_result(*this);
+        }
         if (statistics &&
             evaluator->is_used_for_counting_evaluations() &&
             result.get_count_evaluation()) {
@@ -19,6 +19,7 @@ public:
     EvaluationResult();
     EvaluationResult(const EvaluationResult& other) = default;
     EvaluationResult(EvaluationResult&& other) = default;
+    EvaluationResult& operator=(const EvaluationResult& other) = default;
     EvaluationResult& operator=(EvaluationResult&& other) = default;
 
     /* TODO: Can we do without this "uninitialized" business?
@@ -1,14 +1,48 @@
 #include "evaluator.h"
 
 #include "plugin.h"
+#include "search_profiler.h"
 
 #include "utils/system.h"
 
+#include <algorithm>
 #include <cassert>
+#include <mutex>
 
 using namespace std;
 
 
+/*
+  Existing evaluators indexed by their cache slots. Slots of destroyed
+  evaluators are reused, so the slots stay dense across iterated searches.
+  The vector is never freed because evaluators may be destroyed during
+  static destruction. Evaluators are also created and destroyed by worker
+  threads (e.g. thread-local heuristic copies), so all accesses go through
+  the slots mutex, which is never freed either.
+*/
+static vector<Evaluator *> &get_evaluators_by_slot() {
+    static vector<Evaluator *> *evaluators_by_slot = new vector<Evaluator *>();
+    return *evaluators_by_slot;
+}
+
+static mutex &get_slots_mutex() {
+    static mutex *slots_mutex = new mutex();
+    return *slots_mutex;
+}
+
+static int acquire_cache_slot(Evaluator *evaluator) {
+    lock_guard<mutex> lock(get_slots_mutex());
+    vector<Evaluator *> &evaluators_by_slot = get_evaluators_by_slot();
+    auto it = find(evaluators_by_slot.begin(), evaluators_by_slot.end(), nullptr);
+    int slot = it - evaluators_by_slot.begin();
+    if (it == evaluators_by_slot.end()) {
+        evaluators_by_slot.push_back(evaluator);
+    } else {
+        *it = evaluator;
+    }
+    return slot;
+}
+
 Evaluator::Evaluator(const string &description,
                      bool use_for_reporting_minima,
                      bool use_for_boosting,
@@ -16,7 +50,47 @@ Evaluator::Evaluator(const string &description,
     : description(description),
       use_for_reporting_minima(use_for_reporting_minima),
       use_for_boosting(use_for_boosting),
-      use_for_counting_evaluations(use_for_counting_evaluations) {
+      use_for_counting_evaluations(use_for_counting_evaluations),
+      cache_slot(acquire_cache_slot(this)),
+      profiler_component(-1) {
+}
+
+Evaluator::~Evaluator() {
+    lock_guard<mutex> lock(get_slots_mutex());
+    get_evaluators_by_slot()[cache_slot] = nullptr;
+}
+
+int Evaluator::get_profiler_component() {
+    int component = profiler_component.load(memory_order_relaxed);
+    if (component == -1) {
+        assert(g_search_profiler.is_enabled());
+        /*
+          Only heuristics have descriptions (their configurations). Other
+          evaluators get their own component, so that, e.g., g() and
+          sum([g(), h]) are not reported together.
+        */
+        int new_component;
+        if (description == "<none>") {
+            new_component = g_search_profiler.add_unnamed_evaluator_component();
+        } else {
+            new_component = g_search_profiler.get_evaluator_component(description);
+        }
+        // If another thread was faster, its component is used.
+        if (profiler_component.compare_exchange_strong(
+                component, new_component, memory_order_relaxed)) {
+            component = new_component;
+        }
+    }
+    return component;
+}
+
+void Evaluator::print_all_cache_statistics() {
+    lock_guard<mutex> lock(get_slots_mutex());
+    for (const Evaluator *evaluator : get_evaluators_by_slot()) {
+        if (evaluator) {
+            evaluator->print_cache_statistics();
+        }
+    }
 }
 
 bool Evaluator::dead_ends_are_reliable() const {
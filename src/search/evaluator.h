@@ -3,6 +3,7 @@
 
 #include "evaluation_result.h"
 
+#include <atomic>
 #include <set>
 
 class EvaluationContext;
@@ -13,6 +14,9 @@ class Evaluator {
     const bool use_for_reporting_minima;
     const bool use_for_boosting;
     const bool use_for_counting_evaluations;
+    const int cache_slot;
+    // Component of the search profiler for this evaluator or -1 if unknown.
+    std::atomic<int> profiler_component;
 
 public:
     Evaluator(
@@ -20,7 +24,7 @@ public:
         bool use_for_reporting_minima = false,
         bool use_for_boosting = false,
         bool use_for_counting_evaluations = false);
-    virtual ~Evaluator() = default;
+    virtual ~Evaluator();
 
     /*
       dead_ends_are_reliable should return true if the evaluator is
@@ -84,6 +88,20 @@ public:
     bool is_used_for_boosting() const;
     bool is_used_for_counting_evaluations() const;
 
+    /*
+      Dense index of this evaluator among all existing evaluators, used to
+      look up its result in an EvaluatorCache.
+    */
+    int get_cache_slot() const {
+        return cache_slot;
+    }
+
+    /*
+      Component of the search profiler that accumulates the time of this
+      evaluator. It is looked up once, so the profiler must be enabled.
+    */
+    int get_profiler_component();
+
     virtual bool does_cache_estimates() const;
     virtual bool is_estimate_cached(const GlobalState &state) const;
     /*
@@ -93,6 +111,11 @@ public:
     virtual int get_cached_estimate(const GlobalState &state) const;
 
     virtual void print_evaluator_statistics() const {}
+
+    // Print how often cached estimates were reused.
+    virtual void print_cache_statistics() const {}
+    // Call print_cache_statistics() for all existing evaluators.
+    static void print_all_cache_statistics();
 };
 
 #endif
@@ -1,14 +1,54 @@
 #include "evaluator_cache.h"
 
+#include "evaluator.h"
+
+#include "utils/memory.h"
+
 using namespace std;
 
 
 EvaluatorCache::EvaluatorCache(const GlobalState &state)
     : state(state) {
+    slot_evaluators.fill(nullptr);
+}
+
+EvaluatorCache::EvaluatorCache(const EvaluatorCache &other)
+    : slot_evaluators(other.slot_evaluators),
+      slot_results(other.slot_results),
+      overflow_results(other.overflow_results ?
+                       utils::make_unique_ptr<OverflowResults>(*other.overflow_results) :
+                       nullptr),
+      state(other.state) {
+}
+
+EvaluatorCache &EvaluatorCache::operator=(const EvaluatorCache &other) {
+    if (this != &other) {
+        *this = EvaluatorCache(other);
+    }
+    return *this;
 }
 
 EvaluationResult &EvaluatorCache::operator[](Evaluator *eval) {
-    return eval_results[eval];
+    int slot = eval->get_cache_slot();
+    if (slot < NUM_SLOTS) {
+        Evaluator *&slot_evaluator = slot_evaluators[slot];
+        if (!slot_evaluator) {
+            slot_evaluator = eval;
+        }
+        if (slot_evaluator == eval) {
+            return slot_results[slot];
+        }
+    }
+    if (!overflow_results) {
+        overflow_results = utils::make_unique_ptr<OverflowResults>();
+    }
+    for (auto &element : *overflow_results) {
+        if (element.first == eval) {
+            return element.second;
+        }
+    }
+    overflow_results->emplace_back(eval, EvaluationResult());
+    return overflow_results->back().second;
 }
 
 const GlobalState &EvaluatorCache::get_state() const {
@@ -4,33 +4,66 @@
 #include "evaluation_result.h"
 #include "global_state.h"
 
-#include <unordered_map>
+#include <array>
+#include <deque>
+#include <memory>
+#include <utility>
 
 class Evaluator;
 
-using EvaluationResults = std::unordered_map<Evaluator *, EvaluationResult>;
-
 /*
   Store a state and evaluation results for this state.
+
+  Every evaluator gets a dense cache slot when it is created (see
+  Evaluator::get_cache_slot()). The results of the first NUM_SLOTS
+  evaluators are stored in a fixed array indexed by the slot, so creating
+  a cache does not allocate memory and lookups are array accesses. Results
+  of further evaluators are stored in a list that is searched linearly and
+  only created when the first such result is stored.
 */
 class EvaluatorCache {
-    EvaluationResults eval_results;
+public:
+    static const int NUM_SLOTS = 16;
+
+private:
+    std::array<Evaluator *, NUM_SLOTS> slot_evaluators;
+    std::array<EvaluationResult, NUM_SLOTS> slot_results;
+    /*
+      A deque keeps references to its elements valid when growing. This is
+      necessary because EvaluationContext::get_result holds a reference to
+      the result while nested evaluators store theirs.
+    */
+    using OverflowResults = std::deque<std::pair<Evaluator *, EvaluationResult>>;
+    std::unique_ptr<OverflowResults> overflow_results;
     GlobalState state;
 
 public:
     explicit EvaluatorCache(const GlobalState &state);
+    EvaluatorCache(const EvaluatorCache &other);
+    EvaluatorCache(EvaluatorCache &&other) = default;
     ~EvaluatorCache() = default;
 
+    EvaluatorCache &operator=(const EvaluatorCache &other);
+    EvaluatorCache &operator=(EvaluatorCache &&other) = default;
+
     EvaluationResult &operator[](Evaluator *eval);
 
     const GlobalState &get_state() const;
 
     template<class Callback>
     void for_each_evaluator_result(const Callback &callback) const {
-        for (const auto &element : eval_results) {
-            const Evaluator *eval = element.first;
-            const EvaluationResult &result = element.second;
-            callback(eval, result);
+        for (int slot = 0; slot < NUM_SLOTS; ++slot) {
+            const Evaluator *eval = slot_evaluators[slot];
+            if (eval) {
+                callback(eval, slot_results[slot]);
+            }
+        }
+        if (overflow_results) {
+            for (const auto &element : *overflow_results) {
+                const Evaluator *eval = element.first;
+                const EvaluationResult &result = element.second;
+                callback(eval, result);
+            }
         }
     }
 };
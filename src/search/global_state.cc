@@ -18,6 +18,16 @@ GlobalState::GlobalState(
     assert(id != StateID::no_state);
 }
 
+GlobalState::GlobalState(
+    shared_ptr<const vector<PackedStateBin>> owned_buffer,
+    const StateRegistry &registry, StateID id)
+    : buffer(owned_buffer->data()),
+      owned_buffer(move(owned_buffer)),
+      registry(&registry),
+      id(id) {
+    assert(id != StateID::no_state);
+}
+
 int GlobalState::operator[](int var) const {
     assert(var >= 0);
     assert(var < registry->get_num_variables());
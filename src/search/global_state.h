@@ -7,6 +7,7 @@
 
 #include <cstddef>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 class StateRegistry;
@@ -25,6 +26,11 @@ class GlobalState {
 
     // Values for vars are maintained in a packed state and accessed on demand.
     const PackedStateBin *buffer;
+    /*
+      Registries with compressed state storage do not keep the packed states,
+      so the state owns the (decompressed) buffer in this case.
+    */
+    std::shared_ptr<const std::vector<PackedStateBin>> owned_buffer;
 
     // registry isn't a reference because we want to support operator=
     const StateRegistry *registry;
@@ -33,6 +39,9 @@ class GlobalState {
     // Only used by the state registry.
     GlobalState(
         const PackedStateBin *buffer, const StateRegistry &registry, StateID id);
+    GlobalState(
+        std::shared_ptr<const std::vector<PackedStateBin>> owned_buffer,
+        const StateRegistry &registry, StateID id);
 
     const PackedStateBin *get_packed_buffer() const {
         return buffer;
@@ -17,8 +17,14 @@ using namespace std;
 
 Heuristic::Heuristic(const Options &opts)
     : Evaluator(opts.get_unparsed_config(), true, true, true),
-      heuristic_cache(HEntry(NO_VALUE, true)), //TODO: is true really a good idea here?
+      config(opts.get_parse_tree()),
+      heuristic_cache(HEntry(NO_VALUE, true), "heuristic cache"), //TODO: is true really a good idea here?
       cache_evaluator_values(opts.get<bool>("cache_estimates")),
+      // Heuristics built internally from hand-made options lack this option.
+      report_cache_statistics(opts.contains("report_cache_statistics") &&
+                              opts.get<bool>("report_cache_statistics")),
+      num_cache_hits(0),
+      num_cache_misses(0),
       task(opts.get<shared_ptr<AbstractTask>>("transform")),
       task_proxy(*task) {
 }
@@ -47,7 +53,18 @@ void Heuristic::add_options_to_parser(OptionParser &parser) {
         "Optional task transformation for the heuristic."
         " Currently, adapt_costs() and no_transform() are available.",
         "no_transform()");
-    parser.add_option<bool>("cache_estimates", "cache heuristic estimates", "true");
+    parser.add_option<bool>(
+        "cache_estimates",
+        "cache heuristic estimates for each state. Reopened states and "
+        "states of later iterations of an iterated search with "
+        "share_state_registry=true then reuse the cached estimate unless "
+        "preferred operators are needed",
+        "true");
+    parser.add_option<bool>(
+        "report_cache_statistics",
+        "print the number of cache hits and misses at the end of the search "
+        "(only if cache_estimates=true and the cache was used)",
+        "false");
 }
 
 EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
@@ -64,10 +81,12 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
         heuristic_cache[state].h != NO_VALUE && !heuristic_cache[state].dirty) {
         heuristic = heuristic_cache[state].h;
         result.set_count_evaluation(false);
+        ++num_cache_hits;
     } else {
         heuristic = compute_heuristic(state);
         if (cache_evaluator_values) {
             heuristic_cache[state] = HEntry(heuristic, false);
+            ++num_cache_misses;
         }
         result.set_count_evaluation(true);
     }
@@ -116,6 +135,34 @@ int Heuristic::get_cached_estimate(const GlobalState &state) const {
     return heuristic_cache[state].h;
 }
 
+void Heuristic::set_cached_estimate(const GlobalState &state, int value) {
+    assert(cache_evaluator_values);
+    int heuristic = (value == EvaluationResult::INFTY) ? DEAD_END : value;
+    heuristic_cache[state] = HEntry(heuristic, false);
+}
+
+Heuristic *Heuristic::create_thread_local_copy() const {
+    if (config.empty()) {
+        return nullptr;
+    }
+    OptionParser parser(config, false);
+    Heuristic *copy = dynamic_cast<Heuristic *>(
+        parser.start_parsing<Evaluator *>());
+    if (copy) {
+        copy->cache_evaluator_values = false;
+    }
+    return copy;
+}
+
+void Heuristic::print_cache_statistics() const {
+    if (report_cache_statistics && cache_evaluator_values &&
+        num_cache_hits + num_cache_misses > 0) {
+        cout << "Cache statistics for " << get_description() << ": "
+             << num_cache_hits << " hits, " << num_cache_misses << " misses"
+             << endl;
+    }
+}
+
 std::shared_ptr<AbstractTask> Heuristic::get_abstract_task() const {
     return task;
 }
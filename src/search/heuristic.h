@@ -7,6 +7,7 @@
 #include "task_proxy.h"
 
 #include "algorithms/ordered_set.h"
+#include "options/parse_tree.h"
 
 #include <memory>
 #include <vector>
@@ -44,15 +45,26 @@ class Heuristic : public Evaluator {
     */
     ordered_set::OrderedSet<OperatorID> preferred_operators;
 
+    // Configuration this heuristic was parsed from (empty if unknown).
+    const options::ParseTree config;
+
 protected:
     /*
       Cache for saving h values
       Before accessing this cache always make sure that the cache_evaluator_values
       flag is set to true - as soon as the cache is accessed it will create
       entries for all existing states
+
+      The cache is kept per state registry, so it also serves search engines
+      that reuse the registry of a previous engine (see the
+      share_state_registry option of iterated search).
     */
     PerStateInformation<HEntry> heuristic_cache;
     bool cache_evaluator_values;
+    const bool report_cache_statistics;
+    // Cached values that were reused and values that had to be computed.
+    int num_cache_hits;
+    int num_cache_misses;
 
     // Hold a reference to the task implementation and pass it to objects that need it.
     std::shared_ptr<AbstractTask> task;
@@ -91,6 +103,42 @@ public:
     virtual bool does_cache_estimates() const override;
     virtual bool is_estimate_cached(const GlobalState &state) const override;
     virtual int get_cached_estimate(const GlobalState &state) const override;
+    virtual void print_cache_statistics() const override;
+
+    /*
+      Store a value that was computed elsewhere, e.g., by a copy of this
+      heuristic in another thread. The value is the evaluator value, i.e.,
+      EvaluationResult::INFTY for dead ends. Requires cached estimates.
+      Stored values count neither as cache hits nor as cache misses.
+    */
+    void set_cached_estimate(const GlobalState &state, int value);
+
+    /*
+      Parse a new instance of this heuristic from its configuration for use
+      in another thread. The copy does not cache its estimates, so it can
+      evaluate states of a registry that is not modified at the same time.
+      Objects that the configuration refers to by name (predefinitions) are
+      shared with the copy. Returns nullptr if the configuration is unknown.
+
+      Since the copy is parsed anew, it repeats all preprocessing of the
+      heuristic and keeps its own data structures. For example, each copy
+      of a PDB or merge-and-shrink heuristic computes and stores its own
+      pattern databases or abstractions, so time and memory for these grow
+      linearly with the number of copies.
+    */
+    Heuristic *create_thread_local_copy() const;
+
+    /*
+      Return false if the estimates of this heuristic cannot be computed by
+      a thread-local copy and stored with set_cached_estimate. This is the
+      case for heuristics that override compute_result, e.g., because their
+      estimates depend on the g value or because evaluating a state has
+      side effects (like recording unsolvable goal subsets) that must
+      happen in this object.
+    */
+    virtual bool supports_thread_local_copies() const {
+        return true;
+    }
 
     virtual void set_abstract_task(std::shared_ptr<AbstractTask> task);
     std::shared_ptr<AbstractTask> get_abstract_task() const;
@@ -6,23 +6,52 @@
 #include "../task_utils/task_properties.h"
 #include "../utils/logging.h"
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
-#include <set>
 
 using namespace std;
 
 namespace hm_heuristic {
+static const int INF = numeric_limits<int>::max();
+static const int NO_VALUE = -1;
+static const int CONFLICTING_VALUES = -2;
+
+/*
+  Call callback(subtuple) for all non-empty subtuples of the sorted tuple
+  with at most max_size facts and pairwise different variables. The
+  subtuples are built in the given buffer and keep the order of tuple.
+*/
+template<typename Callback>
+static void for_each_subtuple(
+    const vector<FactPair> &tuple, int max_size, size_t start,
+    vector<FactPair> &subtuple, const Callback &callback) {
+    for (size_t i = start; i < tuple.size(); ++i) {
+        if (!subtuple.empty() && subtuple.back().var == tuple[i].var) {
+            continue;
+        }
+        subtuple.push_back(tuple[i]);
+        callback(subtuple);
+        if (static_cast<int>(subtuple.size()) < max_size) {
+            for_each_subtuple(tuple, max_size, i + 1, subtuple, callback);
+        }
+        subtuple.pop_back();
+    }
+}
+
 HMHeuristic::HMHeuristic(const Options &opts)
     : Heuristic(opts),
       m(opts.get<int>("m")),
       has_cond_effects(task_properties::has_conditional_effects(task_proxy)),
-      goals(task_properties::get_fact_pairs(task_proxy.get_goals())) {
+      was_updated(false) {
     cout << "Using h^" << m << "." << endl;
-    cout << "The implementation of the h^m heuristic is preliminary." << endl
-         << "It is SLOOOOOOOOOOOW." << endl
-         << "Please do not use this for comparison!" << endl;
-    generate_all_tuples();
+    init_ranking();
+    init_operators();
+    Tuple goals = task_properties::get_fact_pairs(task_proxy.get_goals());
+    sort(goals.begin(), goals.end());
+    goal_tuple_ids = get_subtuple_ids(goals);
+    hm_table.resize(tuple_offsets[m + 1]);
+    cout << "h^" << m << " table entries: " << hm_table.size() << endl;
 }
 
 
@@ -31,232 +60,276 @@ bool HMHeuristic::dead_ends_are_reliable() const {
 }
 
 
+void HMHeuristic::init_ranking() {
+    VariablesProxy vars = task_proxy.get_variables();
+    int num_vars = vars.size();
+    for (VariableProxy var : vars) {
+        domain_sizes.push_back(var.get_domain_size());
+    }
+    pre_values.assign(num_vars, NO_VALUE);
+    eff_values.assign(num_vars, NO_VALUE);
+    is_new_pre_var.assign(num_vars, false);
+
+    num_tuples_from.assign(m + 1, vector<size_t>(num_vars + 1, 0));
+    num_tuples_before.assign(m + 1, vector<size_t>(num_vars + 1, 0));
+    fill(num_tuples_from[0].begin(), num_tuples_from[0].end(), 1);
+    for (int k = 1; k <= m; ++k) {
+        for (int var = num_vars - 1; var >= 0; --var) {
+            num_tuples_from[k][var] = num_tuples_from[k][var + 1] +
+                domain_sizes[var] * num_tuples_from[k - 1][var + 1];
+        }
+    }
+    for (int k = 0; k <= m; ++k) {
+        for (int var = 0; var < num_vars; ++var) {
+            num_tuples_before[k][var + 1] = num_tuples_before[k][var] +
+                domain_sizes[var] * num_tuples_from[k][var + 1];
+        }
+    }
+    tuple_offsets.assign(m + 2, 0);
+    for (int k = 1; k <= m; ++k) {
+        tuple_offsets[k + 1] = tuple_offsets[k] + num_tuples_from[k][0];
+    }
+}
+
+
+size_t HMHeuristic::get_tuple_id(const Tuple &tuple) const {
+    int size = tuple.size();
+    assert(size >= 1 && size <= m);
+    size_t id = tuple_offsets[size];
+    int start_var = 0;
+    for (int i = 0; i < size; ++i) {
+        int rest = size - 1 - i;
+        int var = tuple[i].var;
+        assert(var >= start_var);
+        id += num_tuples_before[rest][var] - num_tuples_before[rest][start_var] +
+            tuple[i].value * num_tuples_from[rest][var + 1];
+        start_var = var + 1;
+    }
+    assert(id < tuple_offsets[size + 1]);
+    return id;
+}
+
+
+vector<size_t> HMHeuristic::get_subtuple_ids(const Tuple &facts) const {
+    vector<size_t> ids;
+    Tuple subtuple;
+    for_each_subtuple(
+        facts, m, 0, subtuple,
+        [&](const Tuple &t) {
+            ids.push_back(get_tuple_id(t));
+        });
+    return ids;
+}
+
+
+void HMHeuristic::init_operators() {
+    OperatorsProxy ops = task_proxy.get_operators();
+    operators.reserve(ops.size());
+    for (OperatorProxy op : ops) {
+        HMOperator hm_op;
+        hm_op.cost = op.get_cost();
+        hm_op.pre = task_properties::get_fact_pairs(op.get_preconditions());
+        sort(hm_op.pre.begin(), hm_op.pre.end());
+        for (EffectProxy eff : op.get_effects()) {
+            hm_op.eff.push_back(eff.get_fact().get_pair());
+        }
+        sort(hm_op.eff.begin(), hm_op.eff.end());
+        hm_op.eff.erase(unique(hm_op.eff.begin(), hm_op.eff.end()),
+                        hm_op.eff.end());
+        hm_op.pre_tuple_ids = get_subtuple_ids(hm_op.pre);
+        hm_op.eff_tuple_ids = get_subtuple_ids(hm_op.eff);
+        if (m > 1) {
+            Tuple subtuple;
+            for_each_subtuple(
+                hm_op.eff, m - 1, 0, subtuple,
+                [&](const Tuple &t) {
+                    hm_op.extendable_effs.push_back(t);
+                });
+        }
+        operators.push_back(move(hm_op));
+    }
+}
+
+
 int HMHeuristic::compute_heuristic(const GlobalState &global_state) {
     State state = convert_global_state(global_state);
     if (task_properties::is_goal_state(task_proxy, state)) {
         return 0;
     } else {
-        Tuple s_tup = task_properties::get_fact_pairs(state);
-
-        init_hm_table(s_tup);
+        init_hm_table(state);
         update_hm_table();
 
-        int h = eval(goals);
+        int h = eval(goal_tuple_ids);
 
-        if (h == numeric_limits<int>::max())
+        if (h == INF)
             return DEAD_END;
         return h;
     }
 }
 
 
-void HMHeuristic::init_hm_table(const Tuple &t) {
-    for (auto &hm_ent : hm_table) {
-        const Tuple &tuple = hm_ent.first;
-        int h_val = check_tuple_in_tuple(tuple, t);
-        hm_table[tuple] = h_val;
+void HMHeuristic::init_hm_table(const State &state) {
+    fill(hm_table.begin(), hm_table.end(), INF);
+    extended_pre.clear();
+    const vector<int> &values = state.get_values();
+    for (size_t var = 0; var < values.size(); ++var) {
+        extended_pre.emplace_back(var, values[var]);
     }
+    for_each_subtuple(
+        extended_pre, m, 0, tuple_buffer,
+        [&](const Tuple &t) {
+            hm_table[get_tuple_id(t)] = 0;
+        });
 }
 
 
 void HMHeuristic::update_hm_table() {
-    int round = 0;
     do {
-        ++round;
         was_updated = false;
 
-        for (OperatorProxy op : task_proxy.get_operators()) {
-            Tuple pre = get_operator_pre(op);
-
-            int c1 = eval(pre);
-            if (c1 != numeric_limits<int>::max()) {
-                Tuple eff = get_operator_eff(op);
-                vector<Tuple> partial_effs;
-                generate_all_partial_tuples(eff, partial_effs);
-                for (Tuple &partial_eff : partial_effs) {
-                    update_hm_entry(partial_eff, c1 + op.get_cost());
-
-                    int eff_size = partial_eff.size();
-                    if (eff_size < m) {
-                        extend_tuple(partial_eff, op);
-                    }
-                }
+        for (const HMOperator &op : operators) {
+            int c1 = eval(op.pre_tuple_ids);
+            if (c1 == INF) {
+                continue;
             }
-        }
-    } while (was_updated);
-}
-
-
-void HMHeuristic::extend_tuple(const Tuple &t, const OperatorProxy &op) {
-    for (auto &hm_ent : hm_table) {
-        const Tuple &tuple = hm_ent.first;
-        bool contradict = false;
-        for (const FactPair &fact : tuple) {
-            if (contradict_effect_of(op, fact.var, fact.value)) {
-                contradict = true;
-                break;
-            }
-        }
-        if (!contradict && (tuple.size() > t.size()) && (check_tuple_in_tuple(t, tuple) == 0)) {
-            Tuple pre = get_operator_pre(op);
-
-            Tuple others;
-            for (const FactPair &fact : tuple) {
-                if (find(t.begin(), t.end(), fact) == t.end()) {
-                    others.push_back(fact);
-                    if (find(pre.begin(), pre.end(), fact) == pre.end()) {
-                        pre.push_back(fact);
-                    }
-                }
+            for (size_t tuple_id : op.eff_tuple_ids) {
+                update_hm_entry(tuple_id, c1 + op.cost);
             }
-
-            sort(pre.begin(), pre.end());
-
-            set<int> vars;
-            bool is_valid = true;
-            for (const FactPair &fact : pre) {
-                if (vars.count(fact.var) != 0) {
-                    is_valid = false;
-                    break;
-                }
-                vars.insert(fact.var);
-            }
-
-            if (is_valid) {
-                int c2 = eval(pre);
-                if (c2 != numeric_limits<int>::max()) {
-                    update_hm_entry(tuple, c2 + op.get_cost());
+            if (!op.extendable_effs.empty()) {
+                set_operator_values(op, true);
+                for (const Tuple &t : op.extendable_effs) {
+                    extend_tuple(t, op, c1);
                 }
+                set_operator_values(op, false);
             }
         }
-    }
+    } while (was_updated);
 }
 
 
-int HMHeuristic::eval(const Tuple &t) const {
-    vector<Tuple> partial;
-    generate_all_partial_tuples(t, partial);
-    int max = 0;
-    for (Tuple &tuple : partial) {
-        assert(hm_table.count(tuple) == 1);
-
-        int h = hm_table.at(tuple);
-        if (h > max) {
-            max = h;
+void HMHeuristic::set_operator_values(const HMOperator &op, bool set) {
+    for (const FactPair &fact : op.pre) {
+        pre_values[fact.var] = set ? fact.value : NO_VALUE;
+    }
+    for (const FactPair &fact : op.eff) {
+        int &value = eff_values[fact.var];
+        if (!set) {
+            value = NO_VALUE;
+        } else if (value == NO_VALUE) {
+            value = fact.value;
+        } else if (value != fact.value) {
+            // Conditional effects can set a variable to different values.
+            value = CONFLICTING_VALUES;
         }
     }
-    return max;
 }
 
 
-int HMHeuristic::update_hm_entry(const Tuple &t, int val) {
-    assert(hm_table.count(t) == 1);
-    if (hm_table[t] > val) {
-        hm_table[t] = val;
-        was_updated = true;
+void HMHeuristic::extend_tuple(
+    const Tuple &t, const HMOperator &op, int pre_cost) {
+    for (const FactPair &fact : t) {
+        if (eff_values[fact.var] == CONFLICTING_VALUES) {
+            return;
+        }
     }
-    return val;
+    assert(extension.empty());
+    add_extension_facts(t, op, pre_cost, 0);
 }
 
 
-int HMHeuristic::check_tuple_in_tuple(
-    const Tuple &tuple, const Tuple &big_tuple) const {
-    for (const FactPair &fact0 : tuple) {
-        bool found = false;
-        for (auto &fact1 : big_tuple) {
-            if (fact0 == fact1) {
-                found = true;
-                break;
-            }
+void HMHeuristic::add_extension_facts(
+    const Tuple &t, const HMOperator &op, int pre_cost, int start_var) {
+    int num_vars = domain_sizes.size();
+    for (int var = start_var; var < num_vars; ++var) {
+        int pre_value = pre_values[var];
+        int eff_value = eff_values[var];
+        if (eff_value == CONFLICTING_VALUES ||
+            (pre_value != NO_VALUE && eff_value != NO_VALUE &&
+             pre_value != eff_value) ||
+            any_of(t.begin(), t.end(),
+                   [var](const FactPair &fact) {return fact.var == var;})) {
+            continue;
         }
-        if (!found) {
-            return numeric_limits<int>::max();
+        // Added facts must not contradict the precondition or the effect.
+        int fixed_value = (pre_value != NO_VALUE) ? pre_value : eff_value;
+        int min_value = (fixed_value == NO_VALUE) ? 0 : fixed_value;
+        int max_value =
+            (fixed_value == NO_VALUE) ? domain_sizes[var] - 1 : fixed_value;
+        for (int value = min_value; value <= max_value; ++value) {
+            extension.emplace_back(var, value);
+            tuple_buffer.clear();
+            merge(t.begin(), t.end(), extension.begin(), extension.end(),
+                  back_inserter(tuple_buffer));
+            size_t tuple_id = get_tuple_id(tuple_buffer);
+            // The extended precondition costs at least as much as pre.
+            if (hm_table[tuple_id] > pre_cost + op.cost) {
+                int c2 = eval_extended_pre(op, pre_cost);
+                if (c2 != INF) {
+                    update_hm_entry(tuple_id, c2 + op.cost);
+                }
+            }
+            if (static_cast<int>(t.size() + extension.size()) < m) {
+                add_extension_facts(t, op, pre_cost, var + 1);
+            }
+            extension.pop_back();
         }
     }
-    return 0;
-}
-
-
-HMHeuristic::Tuple HMHeuristic::get_operator_pre(const OperatorProxy &op) const {
-    Tuple preconditions = task_properties::get_fact_pairs(op.get_preconditions());
-    sort(preconditions.begin(), preconditions.end());
-    return preconditions;
-}
-
-
-HMHeuristic::Tuple HMHeuristic::get_operator_eff(const OperatorProxy &op) const {
-    Tuple effects;
-    for (EffectProxy eff : op.get_effects()) {
-        effects.push_back(eff.get_fact().get_pair());
-    }
-    sort(effects.begin(), effects.end());
-    return effects;
 }
 
 
-bool HMHeuristic::contradict_effect_of(
-    const OperatorProxy &op, int var, int val) const {
-    for (EffectProxy eff : op.get_effects()) {
-        FactProxy fact = eff.get_fact();
-        if (fact.get_variable().get_id() == var && fact.get_value() != val) {
-            return true;
+int HMHeuristic::eval_extended_pre(const HMOperator &op, int pre_cost) {
+    extended_pre = op.pre;
+    for (const FactPair &fact : extension) {
+        if (pre_values[fact.var] == NO_VALUE) {
+            extended_pre.push_back(fact);
+            is_new_pre_var[fact.var] = true;
         }
     }
-    return false;
-}
-
-
-void HMHeuristic::generate_all_tuples() {
-    Tuple t;
-    generate_all_tuples_aux(0, m, t);
-}
-
-
-void HMHeuristic::generate_all_tuples_aux(int var, int sz, const Tuple &base) {
-    int num_variables = task_proxy.get_variables().size();
-    for (int i = var; i < num_variables; ++i) {
-        int domain_size = task_proxy.get_variables()[i].get_domain_size();
-        for (int j = 0; j < domain_size; ++j) {
-            Tuple tuple(base);
-            tuple.emplace_back(i, j);
-            hm_table[tuple] = 0;
-            if (sz > 1) {
-                generate_all_tuples_aux(i + 1, sz - 1, tuple);
-            }
-        }
+    if (extended_pre.size() == op.pre.size()) {
+        return pre_cost;
     }
-}
-
+    sort(extended_pre.begin(), extended_pre.end());
+
+    // Subtuples of pre are already covered by pre_cost.
+    int result = pre_cost;
+    for_each_subtuple(
+        extended_pre, m, 0, subtuple_buffer,
+        [&](const Tuple &subtuple) {
+            if (result != INF &&
+                any_of(subtuple.begin(), subtuple.end(),
+                       [this](const FactPair &fact) {
+                           return is_new_pre_var[fact.var];
+                       })) {
+                result = max(result, hm_table[get_tuple_id(subtuple)]);
+            }
+        });
 
-void HMHeuristic::generate_all_partial_tuples(
-    const Tuple &base_tuple, vector<Tuple> &res) const {
-    Tuple t;
-    generate_all_partial_tuples_aux(base_tuple, t, 0, m, res);
+    for (const FactPair &fact : extension) {
+        is_new_pre_var[fact.var] = false;
+    }
+    return result;
 }
 
 
-void HMHeuristic::generate_all_partial_tuples_aux(
-    const Tuple &base_tuple, const Tuple &t, int index, int sz, vector<Tuple> &res) const {
-    if (sz == 1) {
-        for (size_t i = index; i < base_tuple.size(); ++i) {
-            Tuple tuple(t);
-            tuple.push_back(base_tuple[i]);
-            res.push_back(tuple);
-        }
-    } else {
-        for (size_t i = index; i < base_tuple.size(); ++i) {
-            Tuple tuple(t);
-            tuple.push_back(base_tuple[i]);
-            res.push_back(tuple);
-            generate_all_partial_tuples_aux(base_tuple, tuple, i + 1, sz - 1, res);
+int HMHeuristic::eval(const vector<size_t> &tuple_ids) const {
+    int max = 0;
+    for (size_t tuple_id : tuple_ids) {
+        int h = hm_table[tuple_id];
+        if (h > max) {
+            if (h == INF) {
+                return INF;
+            }
+            max = h;
         }
     }
+    return max;
 }
 
 
-void HMHeuristic::dump_table() const {
-    for (auto &hm_ent : hm_table) {
-        cout << "h(" << hm_ent.first << ") = " << hm_ent.second << endl;
+void HMHeuristic::update_hm_entry(size_t tuple_id, int val) {
+    if (hm_table[tuple_id] > val) {
+        hm_table[tuple_id] = val;
+        was_updated = true;
     }
 }
 
@@ -276,6 +349,10 @@ static Heuristic *_parse(OptionParser &parser) {
                              "yes for tasks without conditional "
                              "effects or axioms");
     parser.document_property("preferred operators", "no");
+    parser.document_note(
+        "Memory",
+        "The table has one entry for each tuple of at most m facts with "
+        "different variables, i.e., roughly (number of facts)^m / m! entries.");
 
     parser.add_option<int>("m", "subset size", "2", Bounds("1", "infinity"));
     Heuristic::add_options_to_parser(parser);
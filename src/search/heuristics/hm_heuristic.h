@@ -3,10 +3,7 @@
 
 #include "../heuristic.h"
 
-#include <algorithm>
-#include <iostream>
-#include <map>
-#include <string>
+#include <cstddef>
 #include <vector>
 
 namespace options {
@@ -17,45 +14,85 @@ namespace hm_heuristic {
 /*
   Haslum's h^m heuristic family ("critical path heuristics").
 
-  This is a very slow implementation and should not be used for
-  speed benchmarks.
+  The table stores one value for each tuple of at most m facts with
+  pairwise different variables. Tuples are sorted by variable and ranked
+  combinatorially, which yields a perfect index into a flat array. For each
+  operator we precompute the indices of the subtuples of its precondition
+  and effect, so the fixpoint iteration only looks up array entries.
 */
-
 class HMHeuristic : public Heuristic {
     using Tuple = std::vector<FactPair>;
+
+    struct HMOperator {
+        int cost;
+        // Facts sorted by variable. Effects ignore effect conditions.
+        Tuple pre;
+        Tuple eff;
+        // Table indices of all subtuples of the precondition and effect.
+        std::vector<std::size_t> pre_tuple_ids;
+        std::vector<std::size_t> eff_tuple_ids;
+        // Subtuples of the effect with fewer than m facts.
+        std::vector<Tuple> extendable_effs;
+    };
+
     // parameters
     const int m;
     const bool has_cond_effects;
 
-    const Tuple goals;
+    std::vector<int> domain_sizes;
+    /*
+      num_tuples_from[k][var] is the number of k-tuples that only use
+      variables >= var. num_tuples_before[k][var] is the number of
+      (k+1)-tuples whose first variable is < var.
+    */
+    std::vector<std::vector<std::size_t>> num_tuples_from;
+    std::vector<std::vector<std::size_t>> num_tuples_before;
+    // tuple_offsets[k] is the index of the first k-tuple in hm_table.
+    std::vector<std::size_t> tuple_offsets;
+
+    std::vector<HMOperator> operators;
+    std::vector<std::size_t> goal_tuple_ids;
 
     // h^m table
-    std::map<Tuple, int> hm_table;
+    std::vector<int> hm_table;
     bool was_updated;
 
-    // auxiliary methods
-    void init_hm_table(const Tuple &t);
+    /*
+      Values of the precondition and effect of the current operator for
+      each variable (NO_VALUE if the operator does not mention the variable
+      and CONFLICTING_VALUES if it has effects with different values).
+    */
+    std::vector<int> pre_values;
+    std::vector<int> eff_values;
+    // Buffers reused during the fixpoint iteration.
+    Tuple extension;
+    Tuple tuple_buffer;
+    Tuple extended_pre;
+    Tuple subtuple_buffer;
+    std::vector<bool> is_new_pre_var;
+
+    std::size_t get_tuple_id(const Tuple &tuple) const;
+    std::vector<std::size_t> get_subtuple_ids(const Tuple &facts) const;
+    void init_ranking();
+    void init_operators();
+
+    void init_hm_table(const State &state);
     void update_hm_table();
-    int eval(const Tuple &t) const;
-    int update_hm_entry(const Tuple &t, int val);
-    void extend_tuple(const Tuple &t, const OperatorProxy &op);
-
-    int check_tuple_in_tuple(const Tuple &tuple, const Tuple &big_tuple) const;
-
-    int get_operator_pre_value(const OperatorProxy &op, int var) const;
-    Tuple get_operator_pre(const OperatorProxy &op) const;
-    Tuple get_operator_eff(const OperatorProxy &op) const;
-    bool contradict_effect_of(const OperatorProxy &op, int var, int val) const;
-
-    void generate_all_tuples();
-    void generate_all_tuples_aux(int var, int sz, const Tuple &base);
-
-    void generate_all_partial_tuples(const Tuple &base_tuple,
-                                     std::vector<Tuple> &res) const;
-    void generate_all_partial_tuples_aux(const Tuple &base_tuple, const Tuple &t, int index,
-                                         int sz, std::vector<Tuple> &res) const;
-
-    void dump_table() const;
+    int eval(const std::vector<std::size_t> &tuple_ids) const;
+    void update_hm_entry(std::size_t tuple_id, int val);
+
+    void set_operator_values(const HMOperator &op, bool set);
+    /*
+      Update all tuples that consist of the effect subtuple t and facts
+      that do not contradict the operator. Such a tuple is reached by
+      applying op in a state that satisfies the precondition and the added
+      facts.
+    */
+    void extend_tuple(const Tuple &t, const HMOperator &op, int pre_cost);
+    void add_extension_facts(
+        const Tuple &t, const HMOperator &op, int pre_cost, int start_var);
+    // Evaluate the precondition of op extended by the current extension.
+    int eval_extended_pre(const HMOperator &op, int pre_cost);
 
 protected:
     virtual int compute_heuristic(const GlobalState &global_state);
@@ -36,6 +36,10 @@ protected:
 
     int compute_heuristic(const GlobalState &global_state) override ;
     EvaluationResult compute_result(EvaluationContext &eval_context) override ;
+    // The estimates depend on g and evaluating states records the MUGS.
+    virtual bool supports_thread_local_copies() const override {
+        return false;
+    }
 
 public:
     explicit MugsHmaxHeuristic(const options::Options &options);
@@ -39,20 +39,21 @@ Exploration::Exploration(const options::Options &opts)
     // Build propositions.
     for (VariableProxy var : task_proxy.get_variables()) {
         int var_id = var.get_id();
-        propositions.push_back(vector<ExProposition>(var.get_domain_size()));
+        proposition_offsets.push_back(propositions.size());
         for (int value = 0; value < var.get_domain_size(); ++value) {
-            propositions[var_id][value].fact = FactPair(var_id, value);
+            propositions.emplace_back();
+            propositions.back().fact = FactPair(var_id, value);
         }
     }
+    is_target_landmark.resize(propositions.size(), false);
 
     // Build goal propositions.
     for (FactProxy goal_fact : task_proxy.get_goals()) {
-        int var_id = goal_fact.get_variable().get_id();
-        int value = goal_fact.get_value();
-        propositions[var_id][value].is_goal_condition = true;
-        propositions[var_id][value].is_termination_condition = true;
-        goal_propositions.push_back(&propositions[var_id][value]);
-        termination_propositions.push_back(&propositions[var_id][value]);
+        int prop_id = get_proposition_id(goal_fact.get_pair());
+        propositions[prop_id].is_goal_condition = true;
+        propositions[prop_id].is_termination_condition = true;
+        goal_propositions.push_back(prop_id);
+        termination_propositions.push_back(prop_id);
     }
 
     // Build unary operators for operators and axioms.
@@ -62,17 +63,34 @@ Exploration::Exploration(const options::Options &opts)
     AxiomsProxy axioms = task_proxy.get_axioms();
     for (OperatorProxy op : axioms)
         build_unary_operators(op);
+    in_relaxed_plan.resize(operators.size() + axioms.size(), false);
 
-    // Cross-reference unary operators.
-    for (ExUnaryOperator &op : unary_operators) {
-        for (ExProposition *pre : op.precondition)
-            pre->precondition_of.push_back(&op);
-    }
+    cross_reference_unary_operators();
     // Set flag that before heuristic values can be used, computation
     // (relaxed exploration) needs to be done
     heuristic_recomputation_needed = true;
 }
 
+void Exploration::cross_reference_unary_operators() {
+    // Store the unary operators of each precondition in one flat vector.
+    int num_propositions = propositions.size();
+    precondition_of_start.assign(num_propositions + 1, 0);
+    for (int pre : unary_operator_preconditions)
+        ++precondition_of_start[pre + 1];
+    for (int prop_id = 0; prop_id < num_propositions; ++prop_id)
+        precondition_of_start[prop_id + 1] += precondition_of_start[prop_id];
+    precondition_of.resize(unary_operator_preconditions.size());
+    vector<int> next_position(
+        precondition_of_start.begin(), precondition_of_start.end() - 1);
+    for (size_t op_id = 0; op_id < unary_operators.size(); ++op_id) {
+        const ExUnaryOperator &op = unary_operators[op_id];
+        for (int i = 0; i < op.num_preconditions; ++i) {
+            int pre = unary_operator_preconditions[op.preconditions_start + i];
+            precondition_of[next_position[pre]++] = op_id;
+        }
+    }
+}
+
 void Exploration::increase_cost(int &cost, int amount) {
     assert(cost >= 0);
     assert(amount >= 0);
@@ -95,25 +113,45 @@ void Exploration::write_overflow_warning() {
     }
 }
 
+int Exploration::get_relaxed_plan_index(int op_or_axiom_id) const {
+    if (op_or_axiom_id >= 0)
+        return op_or_axiom_id;
+    // Axioms are stored behind the operators (see get_operator_or_axiom_id).
+    return task_proxy.get_operators().size() - op_or_axiom_id - 1;
+}
+
+bool Exploration::add_to_relaxed_plan(int op_or_axiom_id) {
+    int index = get_relaxed_plan_index(op_or_axiom_id);
+    assert(utils::in_bounds(index, in_relaxed_plan));
+    if (in_relaxed_plan[index])
+        return false;
+    in_relaxed_plan[index] = true;
+    relaxed_plan.push_back(op_or_axiom_id);
+    return true;
+}
+
+void Exploration::clear_relaxed_plan() {
+    for (int op_or_axiom_id : relaxed_plan)
+        in_relaxed_plan[get_relaxed_plan_index(op_or_axiom_id)] = false;
+    relaxed_plan.clear();
+}
+
 void Exploration::set_additional_goals(const vector<FactPair> &add_goals) {
     //Clear previous additional goals.
-    for (ExProposition *prop : termination_propositions) {
-        propositions[prop->fact.var][prop->fact.value].is_termination_condition = false;
+    for (int prop_id : termination_propositions) {
+        propositions[prop_id].is_termination_condition = false;
     }
     termination_propositions.clear();
-    for (FactProxy goal_fact : task_proxy.get_goals()) {
-        int var_id = goal_fact.get_variable().get_id();
-        int value = goal_fact.get_value();
-        propositions[var_id][value].is_termination_condition = true;
-        termination_propositions.push_back(&propositions[var_id][value]);
+    for (int prop_id : goal_propositions) {
+        propositions[prop_id].is_termination_condition = true;
+        termination_propositions.push_back(prop_id);
     }
     // Build new additional goal propositions.
     for (const FactPair &fact : add_goals) {
-        int var_id = fact.var;
-        int value = fact.value;
-        if (!propositions[var_id][value].is_goal_condition) {
-            propositions[var_id][value].is_termination_condition = true;
-            termination_propositions.push_back(&propositions[var_id][value]);
+        int prop_id = get_proposition_id(fact);
+        if (!propositions[prop_id].is_goal_condition) {
+            propositions[prop_id].is_termination_condition = true;
+            termination_propositions.push_back(prop_id);
         }
     }
     heuristic_recomputation_needed = true;
@@ -122,7 +160,6 @@ void Exploration::set_additional_goals(const vector<FactPair> &add_goals) {
 void Exploration::build_unary_operators(const OperatorProxy &op) {
     // Note: changed from the original to allow sorting of operator conditions
     int base_cost = op.get_cost();
-    vector<ExProposition *> precondition;
     vector<FactPair> precondition_facts1;
 
     for (FactProxy pre : op.get_preconditions()) {
@@ -137,52 +174,52 @@ void Exploration::build_unary_operators(const OperatorProxy &op) {
 
         sort(precondition_facts2.begin(), precondition_facts2.end());
 
+        int preconditions_start = unary_operator_preconditions.size();
         for (const FactPair &precondition_fact : precondition_facts2)
-            precondition.push_back(&propositions[precondition_fact.var]
-                                   [precondition_fact.value]);
+            unary_operator_preconditions.push_back(
+                get_proposition_id(precondition_fact));
 
-        FactProxy effect_fact = effect.get_fact();
-        ExProposition *effect_proposition = &propositions[effect_fact.get_variable().get_id()][effect_fact.get_value()];
+        int effect_proposition = get_proposition_id(effect.get_fact().get_pair());
         int op_or_axiom_id = get_operator_or_axiom_id(op);
-        unary_operators.emplace_back(precondition, effect_proposition, op_or_axiom_id, base_cost);
-        precondition.clear();
-        precondition_facts2.clear();
+        unary_operators.emplace_back(
+            preconditions_start, precondition_facts2.size(), effect_proposition,
+            op_or_axiom_id, base_cost);
     }
 }
 
 // heuristic computation
-void Exploration::setup_exploration_queue(const State &state,
-                                          const vector<FactPair> &excluded_props,
-                                          const unordered_set<int> &excluded_op_ids,
-                                          bool use_h_max) {
+void Exploration::setup_exploration_queue(
+    const State &state,
+    const vector<FactPair> &excluded_props,
+    const dynamic_bitset::DynamicBitset<> *excluded_op_ids,
+    bool use_h_max) {
     prop_queue.clear();
 
-    for (size_t var_id = 0; var_id < propositions.size(); ++var_id) {
-        for (size_t value = 0; value < propositions[var_id].size(); ++value) {
-            ExProposition &prop = propositions[var_id][value];
-            prop.h_add_cost = -1;
-            prop.h_max_cost = -1;
-            prop.depth = -1;
-            prop.marked = false;
-        }
+    for (ExProposition &prop : propositions) {
+        prop.h_add_cost = -1;
+        prop.h_max_cost = -1;
+        prop.depth = -1;
+        prop.marked = false;
     }
 
     for (const FactPair &fact : excluded_props) {
-        ExProposition &prop = propositions[fact.var][fact.value];
-        prop.h_add_cost = -2;
+        propositions[get_proposition_id(fact)].h_add_cost = -2;
     }
 
     // Deal with current state.
     for (FactProxy fact : state) {
-        ExProposition *init_prop = &propositions[fact.get_variable().get_id()][fact.get_value()];
-        enqueue_if_necessary(init_prop, 0, 0, 0, use_h_max);
+        enqueue_if_necessary(get_proposition_id(fact.get_pair()), 0, 0, -1,
+                             use_h_max);
     }
 
     // Initialize operator data, deal with precondition-free operators/axioms.
-    for (ExUnaryOperator &op : unary_operators) {
-        op.unsatisfied_preconditions = op.precondition.size();
-        if (!excluded_op_ids.empty() &&
-            (op.effect->h_add_cost == -2 || excluded_op_ids.count(op.op_or_axiom_id))) {
+    bool exclude_ops = excluded_op_ids && !excluded_op_ids->none();
+    for (size_t op_id = 0; op_id < unary_operators.size(); ++op_id) {
+        ExUnaryOperator &op = unary_operators[op_id];
+        op.unsatisfied_preconditions = op.num_preconditions;
+        if (exclude_ops &&
+            (propositions[op.effect].h_add_cost == -2 ||
+             (!op.is_induced_by_axiom && excluded_op_ids->test(op.op_or_axiom_id)))) {
             op.h_add_cost = -2; // operator will not be applied during relaxed exploration
             continue;
         }
@@ -192,8 +229,8 @@ void Exploration::setup_exploration_queue(const State &state,
 
         if (op.unsatisfied_preconditions == 0) {
             op.depth = 0;
-            int depth = op.is_induced_by_axiom(task_proxy) ? 0 : 1;
-            enqueue_if_necessary(op.effect, op.base_cost, depth, &op, use_h_max);
+            int depth = op.is_induced_by_axiom ? 0 : 1;
+            enqueue_if_necessary(op.effect, op.base_cost, depth, op_id, use_h_max);
         }
     }
 }
@@ -201,73 +238,75 @@ void Exploration::setup_exploration_queue(const State &state,
 void Exploration::relaxed_exploration(bool use_h_max, bool level_out) {
     int unsolved_goals = termination_propositions.size();
     while (!prop_queue.empty()) {
-        pair<int, ExProposition *> top_pair = prop_queue.pop();
+        pair<int, int> top_pair = prop_queue.pop();
         int distance = top_pair.first;
-        ExProposition *prop = top_pair.second;
+        const ExProposition &prop = propositions[top_pair.second];
 
         int prop_cost;
         if (use_h_max)
-            prop_cost = prop->h_max_cost;
+            prop_cost = prop.h_max_cost;
         else
-            prop_cost = prop->h_add_cost;
+            prop_cost = prop.h_add_cost;
         assert(prop_cost <= distance);
         if (prop_cost < distance)
             continue;
-        if (!level_out && prop->is_termination_condition && --unsolved_goals == 0)
+        if (!level_out && prop.is_termination_condition && --unsolved_goals == 0)
             return;
-        const vector<ExUnaryOperator *> &triggered_operators = prop->precondition_of;
-        for (size_t i = 0; i < triggered_operators.size(); ++i) {
-            ExUnaryOperator *unary_op = triggered_operators[i];
-            if (unary_op->h_add_cost == -2) // operator is not applied
+        int prop_depth = prop.depth;
+        int end = precondition_of_start[top_pair.second + 1];
+        for (int i = precondition_of_start[top_pair.second]; i < end; ++i) {
+            int op_id = precondition_of[i];
+            ExUnaryOperator &unary_op = unary_operators[op_id];
+            if (unary_op.h_add_cost == -2) // operator is not applied
                 continue;
-            --unary_op->unsatisfied_preconditions;
-            increase_cost(unary_op->h_add_cost, prop_cost);
-            unary_op->h_max_cost = max(prop_cost + unary_op->base_cost,
-                                       unary_op->h_max_cost);
-            unary_op->depth = max(unary_op->depth, prop->depth);
-            assert(unary_op->unsatisfied_preconditions >= 0);
-            if (unary_op->unsatisfied_preconditions == 0) {
-                int depth = unary_op->is_induced_by_axiom(task_proxy)
-                            ? unary_op->depth : unary_op->depth + 1;
+            --unary_op.unsatisfied_preconditions;
+            increase_cost(unary_op.h_add_cost, prop_cost);
+            unary_op.h_max_cost = max(prop_cost + unary_op.base_cost,
+                                      unary_op.h_max_cost);
+            unary_op.depth = max(unary_op.depth, prop_depth);
+            assert(unary_op.unsatisfied_preconditions >= 0);
+            if (unary_op.unsatisfied_preconditions == 0) {
+                int depth = unary_op.is_induced_by_axiom
+                            ? unary_op.depth : unary_op.depth + 1;
                 if (use_h_max)
-                    enqueue_if_necessary(unary_op->effect, unary_op->h_max_cost,
-                                         depth, unary_op, use_h_max);
+                    enqueue_if_necessary(unary_op.effect, unary_op.h_max_cost,
+                                         depth, op_id, use_h_max);
                 else
-                    enqueue_if_necessary(unary_op->effect, unary_op->h_add_cost,
-                                         depth, unary_op, use_h_max);
+                    enqueue_if_necessary(unary_op.effect, unary_op.h_add_cost,
+                                         depth, op_id, use_h_max);
             }
         }
     }
 }
 
-void Exploration::enqueue_if_necessary(ExProposition *prop, int cost, int depth,
-                                       ExUnaryOperator *op,
-                                       bool use_h_max) {
+void Exploration::enqueue_if_necessary(int prop_id, int cost, int depth,
+                                       int op_id, bool use_h_max) {
     assert(cost >= 0);
-    if (use_h_max && (prop->h_max_cost == -1 || prop->h_max_cost > cost)) {
-        prop->h_max_cost = cost;
-        prop->depth = depth;
-        prop->reached_by = op;
-        prop_queue.push(cost, prop);
-    } else if (!use_h_max && (prop->h_add_cost == -1 || prop->h_add_cost > cost)) {
-        prop->h_add_cost = cost;
-        prop->depth = depth;
-        prop->reached_by = op;
-        prop_queue.push(cost, prop);
+    ExProposition &prop = propositions[prop_id];
+    if (use_h_max && (prop.h_max_cost == -1 || prop.h_max_cost > cost)) {
+        prop.h_max_cost = cost;
+        prop.depth = depth;
+        prop.reached_by = op_id;
+        prop_queue.push(cost, prop_id);
+    } else if (!use_h_max && (prop.h_add_cost == -1 || prop.h_add_cost > cost)) {
+        prop.h_add_cost = cost;
+        prop.depth = depth;
+        prop.reached_by = op_id;
+        prop_queue.push(cost, prop_id);
     }
     if (use_h_max)
-        assert(prop->h_max_cost != -1 &&
-               prop->h_max_cost <= cost);
+        assert(prop.h_max_cost != -1 &&
+               prop.h_max_cost <= cost);
     else
-        assert(prop->h_add_cost != -1 &&
-               prop->h_add_cost <= cost);
+        assert(prop.h_add_cost != -1 &&
+               prop.h_add_cost <= cost);
 }
 
 
 int Exploration::compute_hsp_add_heuristic() {
     int total_cost = 0;
-    for (const ExProposition *goal : goal_propositions) {
-        int prop_cost = goal->h_add_cost;
+    for (int goal : goal_propositions) {
+        int prop_cost = propositions[goal].h_add_cost;
         if (prop_cost == -1)
             return DEAD_END;
         increase_cost(total_cost, prop_cost);
@@ -281,10 +320,10 @@ int Exploration::compute_ff_heuristic(const State &state) {
     if (h_add_heuristic == DEAD_END) {
         return DEAD_END;
     } else {
-        relaxed_plan.clear();
+        clear_relaxed_plan();
         // Collecting the relaxed plan also marks helpful actions as preferred.
-        for (ExProposition *goal : goal_propositions)
-            collect_relaxed_plan(goal, relaxed_plan, state);
+        for (int goal : goal_propositions)
+            collect_relaxed_plan(goal, state);
         int cost = 0;
         for (int op_or_axiom_id : relaxed_plan)
             cost += get_operator_or_axiom(task_proxy, op_or_axiom_id).get_cost();
@@ -292,25 +331,27 @@ int Exploration::compute_ff_heuristic(const State &state) {
     }
 }
 
-void Exploration::collect_relaxed_plan(ExProposition *goal,
-                                       RelaxedPlan &relaxed_plan, const State &state) {
-    if (!goal->marked) { // Only consider each subgoal once.
-        goal->marked = true;
-        ExUnaryOperator *unary_op = goal->reached_by;
-        if (unary_op) { // We have not yet chained back to a start node.
-            for (ExProposition *pre : unary_op->precondition)
-                collect_relaxed_plan(pre, relaxed_plan, state);
-            int op_or_axiom_id = unary_op->op_or_axiom_id;
-            bool added_to_relaxed_plan = false;
+void Exploration::collect_relaxed_plan(int goal, const State &state) {
+    ExProposition &goal_prop = propositions[goal];
+    if (!goal_prop.marked) { // Only consider each subgoal once.
+        goal_prop.marked = true;
+        int op_id = goal_prop.reached_by;
+        if (op_id != -1) { // We have not yet chained back to a start node.
+            const ExUnaryOperator &unary_op = unary_operators[op_id];
+            for (int i = 0; i < unary_op.num_preconditions; ++i)
+                collect_relaxed_plan(
+                    unary_operator_preconditions[unary_op.preconditions_start + i],
+                    state);
+            int op_or_axiom_id = unary_op.op_or_axiom_id;
             /* Using axioms in the relaxed plan actually improves
                performance in many domains. We should look into this. */
-            added_to_relaxed_plan = relaxed_plan.insert(op_or_axiom_id).second;
+            bool added_to_relaxed_plan = add_to_relaxed_plan(op_or_axiom_id);
 
-            assert(unary_op->depth != -1);
+            assert(unary_op.depth != -1);
             if (added_to_relaxed_plan
-                && unary_op->h_add_cost == unary_op->base_cost
-                && unary_op->depth == 0
-                && !unary_op->is_induced_by_axiom(task_proxy)) {
+                && unary_op.h_add_cost == unary_op.base_cost
+                && unary_op.depth == 0
+                && !unary_op.is_induced_by_axiom) {
                 set_preferred(get_operator_or_axiom(task_proxy, op_or_axiom_id));
                 assert(task_properties::is_applicable(get_operator_or_axiom(task_proxy, op_or_axiom_id), state));
             }
@@ -322,39 +363,39 @@ void Exploration::compute_reachability_with_excludes(vector<vector<int>> &lvl_va
                                                      vector<unordered_map<FactPair, int>> &lvl_op,
                                                      bool level_out,
                                                      const vector<FactPair> &excluded_props,
-                                                     const unordered_set<int> &excluded_op_ids,
+                                                     const dynamic_bitset::DynamicBitset<> &excluded_op_ids,
                                                      bool compute_lvl_ops) {
+    assert(excluded_op_ids.size() == task_proxy.get_operators().size());
     // Perform exploration using h_max-values
-    setup_exploration_queue(task_proxy.get_initial_state(), excluded_props, excluded_op_ids, true);
+    setup_exploration_queue(task_proxy.get_initial_state(), excluded_props, &excluded_op_ids, true);
     relaxed_exploration(true, level_out);
 
     // Copy reachability information into lvl_var and lvl_op
-    for (size_t var_id = 0; var_id < propositions.size(); ++var_id) {
-        for (size_t value = 0; value < propositions[var_id].size(); ++value) {
-            ExProposition &prop = propositions[var_id][value];
-            if (prop.h_max_cost >= 0)
-                lvl_var[var_id][value] = prop.h_max_cost;
-        }
+    for (const ExProposition &prop : propositions) {
+        if (prop.h_max_cost >= 0)
+            lvl_var[prop.fact.var][prop.fact.value] = prop.h_max_cost;
     }
     if (compute_lvl_ops) {
         for (ExUnaryOperator &op : unary_operators) {
             // H_max_cost of operator might be wrongly 0 or 1, if the operator
             // did not get applied during relaxed exploration. Look through
             // preconditions and adjust.
-            for (ExProposition *prop : op.precondition) {
-                if (prop->h_max_cost == -1) {
+            for (int i = 0; i < op.num_preconditions; ++i) {
+                const ExProposition &prop =
+                    propositions[unary_operator_preconditions[op.preconditions_start + i]];
+                if (prop.h_max_cost == -1) {
                     // Operator cannot be applied due to unreached precondition
                     op.h_max_cost = numeric_limits<int>::max();
                     break;
-                } else if (op.h_max_cost < prop->h_max_cost + op.base_cost)
-                    op.h_max_cost = prop->h_max_cost + op.base_cost;
+                } else if (op.h_max_cost < prop.h_max_cost + op.base_cost)
+                    op.h_max_cost = prop.h_max_cost + op.base_cost;
             }
             if (op.h_max_cost == numeric_limits<int>::max())
                 break;
             // We subtract 1 to keep semantics for landmark code:
             // if op can achieve prop at time step i+1,
             // its index (for prop) is i, where the initial state is time step 0.
-            const FactPair &effect = op.effect->fact;
+            const FactPair &effect = propositions[op.effect].fact;
             assert(lvl_op[op.op_or_axiom_id].count(effect));
             int new_lvl = op.h_max_cost - 1;
             // If we have found a cheaper achieving operator, adjust h_max cost of proposition.
@@ -380,69 +421,75 @@ int Exploration::compute_heuristic(const GlobalState &global_state) {
 }
 
 
-void Exploration::collect_helpful_actions(
-    ExProposition *goal, RelaxedPlan &relaxed_plan, const State &state) {
+void Exploration::collect_helpful_actions(int goal, const State &state) {
     // This is the same as collect_relaxed_plan, except that preferred operators
     // are saved in exported_ops rather than preferred_operators
 
-    ExUnaryOperator *unary_op = goal->reached_by;
-    if (unary_op) { // We have not yet chained back to a start node.
-        for (ExProposition *pre : unary_op->precondition)
-            collect_helpful_actions(pre, relaxed_plan, state);
-        int op_or_axiom_id = unary_op->op_or_axiom_id;
+    int op_id = propositions[goal].reached_by;
+    if (op_id != -1) { // We have not yet chained back to a start node.
+        const ExUnaryOperator &unary_op = unary_operators[op_id];
+        for (int i = 0; i < unary_op.num_preconditions; ++i)
+            collect_helpful_actions(
+                unary_operator_preconditions[unary_op.preconditions_start + i],
+                state);
+        int op_or_axiom_id = unary_op.op_or_axiom_id;
         bool added_to_relaxed_plan = false;
-        if (!unary_op->is_induced_by_axiom(task_proxy)) {
-            added_to_relaxed_plan = relaxed_plan.insert(op_or_axiom_id).second;
+        if (!unary_op.is_induced_by_axiom) {
+            added_to_relaxed_plan = add_to_relaxed_plan(op_or_axiom_id);
         }
         if (added_to_relaxed_plan
-            && unary_op->h_add_cost == unary_op->base_cost
-            && unary_op->depth == 0
-            && !unary_op->is_induced_by_axiom(task_proxy)) {
+            && unary_op.h_add_cost == unary_op.base_cost
+            && unary_op.depth == 0
+            && !unary_op.is_induced_by_axiom) {
             exported_op_ids.push_back(op_or_axiom_id); // This is a helpful action.
             assert(task_properties::is_applicable(get_operator_or_axiom(task_proxy, op_or_axiom_id), state));
         }
     }
 }
 
-// TODO: this should be in landmark class
-static bool is_landmark(vector<FactPair> &landmarks, const FactPair &fact) {
-    // TODO: change landmarks to set or unordered_set
-    return find(landmarks.begin(), landmarks.end(), fact) != landmarks.end();
-}
-
 bool Exploration::plan_for_disj(
     vector<FactPair> &landmarks, const State &state) {
-    relaxed_plan.clear();
+    clear_relaxed_plan();
     // generate plan to reach part of disj. goal OR if no landmarks given, plan to real goal
     if (!landmarks.empty()) {
         // search for quickest achievable landmark leaves
         if (heuristic_recomputation_needed) {
             prepare_heuristic_computation(state);
         }
+        for (const FactPair &fact : landmarks)
+            is_target_landmark[get_proposition_id(fact)] = true;
         int min_cost = numeric_limits<int>::max();
-        ExProposition *target = nullptr;
-        for (ExProposition *prop : termination_propositions) {
-            const int prop_cost = prop->h_add_cost;
-            if (prop_cost == -1 && is_landmark(landmarks, prop->fact)) {
-                return false; // dead end
+        int target = -1;
+        bool dead_end = false;
+        for (int prop_id : termination_propositions) {
+            if (!is_target_landmark[prop_id])
+                continue;
+            const int prop_cost = propositions[prop_id].h_add_cost;
+            if (prop_cost == -1) {
+                dead_end = true;
+                break;
             }
-            if (prop_cost < min_cost && is_landmark(landmarks, prop->fact)) {
-                target = prop;
+            if (prop_cost < min_cost) {
+                target = prop_id;
                 min_cost = prop_cost;
             }
         }
-        assert(target);
+        for (const FactPair &fact : landmarks)
+            is_target_landmark[get_proposition_id(fact)] = false;
+        if (dead_end)
+            return false;
+        assert(target != -1);
         assert(exported_op_ids.empty());
-        collect_helpful_actions(target, relaxed_plan, state);
+        collect_helpful_actions(target, state);
     } else {
         // search for original goals of the task
         if (heuristic_recomputation_needed) {
             prepare_heuristic_computation(state);
         }
-        for (ExProposition *prop : goal_propositions) {
-            if (prop->h_add_cost == -1)
+        for (int prop_id : goal_propositions) {
+            if (propositions[prop_id].h_add_cost == -1)
                 return false;  // dead end
-            collect_helpful_actions(prop, relaxed_plan, state);
+            collect_helpful_actions(prop_id, state);
         }
     }
     return true;
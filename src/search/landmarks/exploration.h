@@ -6,30 +6,31 @@
 #include "../abstract_task.h"
 #include "../heuristic.h"
 
+#include "../algorithms/dynamic_bitset.h"
 #include "../algorithms/priority_queues.h"
 
 #include <cassert>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 class OperatorProxy;
 
 namespace landmarks {
-struct ExProposition;
-struct ExUnaryOperator;
-
+/*
+  Propositions and unary operators refer to each other by their index in
+  the flat vectors of Exploration. This keeps all exploration data in a
+  few contiguous arrays that are reused for every exploration.
+*/
 struct ExProposition {
     FactPair fact;
     bool is_goal_condition;
     bool is_termination_condition;
-    std::vector<ExUnaryOperator *> precondition_of;
 
     int h_add_cost;
     int h_max_cost;
     int depth;
     bool marked; // used when computing preferred operators
-    ExUnaryOperator *reached_by;
+    int reached_by; // index of a unary operator or -1
 
     ExProposition()
         : fact(FactPair::no_fact),
@@ -39,90 +40,96 @@ struct ExProposition {
           h_max_cost(-1),
           depth(-1),
           marked(false),
-          reached_by(nullptr)
+          reached_by(-1)
     {}
-
-    bool operator<(const ExProposition &other) const {
-        return fact < other.fact;
-    }
 };
 
 struct ExUnaryOperator {
     int op_or_axiom_id;
-    std::vector<ExProposition *> precondition;
-    ExProposition *effect;
+    // Preconditions are stored in Exploration::unary_operator_preconditions.
+    int preconditions_start;
+    int num_preconditions;
+    int effect;
     int base_cost; // 0 for axioms, 1 for regular operators
+    bool is_induced_by_axiom;
 
     int unsatisfied_preconditions;
     int h_add_cost;
     int h_max_cost;
     int depth;
-    ExUnaryOperator(const std::vector<ExProposition *> &pre, ExProposition *eff,
+    ExUnaryOperator(int preconditions_start, int num_preconditions, int effect,
                     int op_or_axiom_id, int base)
-        : op_or_axiom_id(op_or_axiom_id), precondition(pre), effect(eff), base_cost(base) {}
-
-
-    bool operator<(const ExUnaryOperator &other) const {
-        if (*(other.effect) < *effect)
-            return false;
-        else if (*effect < *(other.effect))
-            return true;
-
-        else {
-            for (size_t i = 0; i < precondition.size(); ++i) {
-                if (i == other.precondition.size() ||
-                    *(other.precondition[i]) < *(precondition[i]))
-                    return false;
-                else if (*(precondition[i]) < *(other.precondition[i]))
-                    return true;
-            }
-            return true;
-        }
-    }
-
-    bool is_induced_by_axiom(const TaskProxy &task_proxy) const {
-        return get_operator_or_axiom(task_proxy, op_or_axiom_id).is_axiom();
-    }
+        : op_or_axiom_id(op_or_axiom_id),
+          preconditions_start(preconditions_start),
+          num_preconditions(num_preconditions),
+          effect(effect),
+          base_cost(base),
+          is_induced_by_axiom(op_or_axiom_id < 0),
+          unsatisfied_preconditions(0),
+          h_add_cost(-1),
+          h_max_cost(-1),
+          depth(-1) {}
 };
 
 class Exploration : public Heuristic {
     static const int MAX_COST_VALUE = 100000000; // See additive_heuristic.h.
 
-    using RelaxedPlan = std::set<int>;
-    RelaxedPlan relaxed_plan;
-    std::vector<ExUnaryOperator> unary_operators;
-    std::vector<std::vector<ExProposition>> propositions;
-    std::vector<ExProposition *> goal_propositions;
-    std::vector<ExProposition *> termination_propositions;
+    /*
+      The relaxed plan is a set of operator and axiom IDs. We store it as a
+      list of IDs together with a flag per ID so that it can be reset in
+      time proportional to its size.
+    */
+    std::vector<int> relaxed_plan;
+    std::vector<bool> in_relaxed_plan;
 
-    priority_queues::AdaptiveQueue<ExProposition *> prop_queue;
+    std::vector<int> proposition_offsets;
+    std::vector<ExProposition> propositions;
+    std::vector<ExUnaryOperator> unary_operators;
+    std::vector<int> unary_operator_preconditions;
+    // Unary operators having proposition p as precondition are stored at
+    // positions precondition_of_start[p] to precondition_of_start[p + 1] - 1.
+    std::vector<int> precondition_of_start;
+    std::vector<int> precondition_of;
+    std::vector<int> goal_propositions;
+    std::vector<int> termination_propositions;
+
+    // Reused buffer for plan_for_disj.
+    std::vector<bool> is_target_landmark;
+
+    priority_queues::AdaptiveQueue<int> prop_queue;
     bool did_write_overflow_warning;
 
     bool heuristic_recomputation_needed;
 
-    void build_unary_operators(const OperatorProxy &op);
-    void simplify();
+    int get_proposition_id(const FactPair &fact) const {
+        return proposition_offsets[fact.var] + fact.value;
+    }
+    int get_relaxed_plan_index(int op_or_axiom_id) const;
+    bool add_to_relaxed_plan(int op_or_axiom_id);
+    void clear_relaxed_plan();
 
-    void setup_exploration_queue(const State &state,
-                                 const std::vector<FactPair> &excluded_props,
-                                 const std::unordered_set<int> &excluded_op_ids,
-                                 bool use_h_max);
+    void build_unary_operators(const OperatorProxy &op);
+    void cross_reference_unary_operators();
+
+    // excluded_op_ids may be nullptr if no operators are excluded.
+    void setup_exploration_queue(
+        const State &state,
+        const std::vector<FactPair> &excluded_props,
+        const dynamic_bitset::DynamicBitset<> *excluded_op_ids,
+        bool use_h_max);
     void setup_exploration_queue(const State &state, bool h_max) {
-        std::vector<FactPair> excluded_props;
-        std::unordered_set<int> excluded_op_ids;
-        setup_exploration_queue(state, excluded_props, excluded_op_ids, h_max);
+        setup_exploration_queue(state, std::vector<FactPair>(), nullptr, h_max);
     }
     void relaxed_exploration(bool use_h_max, bool level_out);
     void prepare_heuristic_computation(const State &state);
-    void collect_relaxed_plan(ExProposition *goal, RelaxedPlan &relaxed_plan, const State &state);
+    void collect_relaxed_plan(int goal, const State &state);
 
     int compute_hsp_add_heuristic();
     int compute_ff_heuristic(const State &state);
 
-    void collect_helpful_actions(
-        ExProposition *goal, RelaxedPlan &relaxed_plan, const State &state);
+    void collect_helpful_actions(int goal, const State &state);
 
-    void enqueue_if_necessary(ExProposition *prop, int cost, int depth, ExUnaryOperator *op,
+    void enqueue_if_necessary(int prop_id, int cost, int depth, int op_id,
                               bool use_h_max);
     void increase_cost(int &cost, int amount);
     void write_overflow_warning();
@@ -133,11 +140,16 @@ public:
 
     void set_additional_goals(const std::vector<FactPair> &goals);
     void set_recompute_heuristic() {heuristic_recomputation_needed = true;}
+    /*
+      excluded_op_ids has one bit per operator (axioms cannot be excluded).
+      Excluded propositions are only taken into account if at least one
+      operator is excluded.
+    */
     void compute_reachability_with_excludes(std::vector<std::vector<int>> &lvl_var,
                                             std::vector<std::unordered_map<FactPair, int>> &lvl_op,
                                             bool level_out,
                                             const std::vector<FactPair> &excluded_props,
-                                            const std::unordered_set<int> &excluded_op_ids,
+                                            const dynamic_bitset::DynamicBitset<> &excluded_op_ids,
                                             bool compute_lvl_ops);
     // Only needed for computing helpful actions for landmark count heuristic.
     std::vector<int> exported_op_ids;
@@ -19,6 +19,10 @@ public:
     explicit FFSynergyHeuristic(const options::Options &opts);
 
     virtual EvaluationResult compute_result(EvaluationContext &eval_context) override;
+    // The value is computed by the master, not stored in this cache.
+    virtual bool supports_thread_local_copies() const override {
+        return false;
+    }
 };
 }
 #endif
@@ -49,6 +49,10 @@ public:
 
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) override;
+    // The results of both heuristics are computed together in this object.
+    virtual bool supports_thread_local_copies() const override {
+        return false;
+    }
 
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) override {
@@ -88,10 +88,9 @@ LandmarkCountHeuristic::~LandmarkCountHeuristic() {
 
 void LandmarkCountHeuristic::set_exploration_goals(const GlobalState &global_state) {
     // Set additional goals for FF exploration
-    BitsetView landmark_info = lm_status_manager->get_reached_landmarks(global_state);
-    LandmarkSet reached_landmarks = convert_to_landmark_set(landmark_info);
+    BitsetView reached_lms = lm_status_manager->get_reached_landmarks(global_state);
     vector<FactPair> lm_leaves = collect_lm_leaves(
-        ff_search_disjunctive_lms, reached_landmarks);
+        ff_search_disjunctive_lms, reached_lms);
     exploration.set_additional_goals(lm_leaves);
 }
 
@@ -116,11 +115,9 @@ int LandmarkCountHeuristic::get_heuristic_value(const GlobalState &global_state)
         double h_val = lm_cost_assignment->cost_sharing_h_value();
         h = static_cast<int>(ceil(h_val - epsilon));
     } else {
-        lgraph->count_costs();
-
         int total_cost = lgraph->cost_of_landmarks();
-        int reached_cost = lgraph->get_reached_cost();
-        int needed_cost = lgraph->get_needed_cost();
+        int reached_cost = lm_status_manager->get_reached_cost();
+        int needed_cost = lm_status_manager->get_needed_cost();
 
         h = total_cost - reached_cost + needed_cost;
     }
@@ -147,12 +144,11 @@ int LandmarkCountHeuristic::compute_heuristic(const GlobalState &global_state) {
     // reached within next step, helpful actions are those occuring in a plan
     // to achieve one of the LM leaves.
 
-    BitsetView landmark_info = lm_status_manager->get_reached_landmarks(global_state);
-    LandmarkSet reached_lms = convert_to_landmark_set(landmark_info);
+    BitsetView reached_lms = lm_status_manager->get_reached_landmarks(global_state);
 
-    int num_reached = reached_lms.size();
-    if (num_reached == lgraph->number_of_landmarks() ||
-        !generate_helpful_actions(state, reached_lms)) {
+    bool all_lms_reached = reached_lms.count() == lgraph->number_of_landmarks();
+    if (all_lms_reached ||
+        !generate_helpful_actions(state, reached_lms, all_lms_reached)) {
         set_exploration_goals(global_state);
 
         // Use FF to plan to a landmark leaf.
@@ -173,14 +169,15 @@ int LandmarkCountHeuristic::compute_heuristic(const GlobalState &global_state) {
 }
 
 vector<FactPair> LandmarkCountHeuristic::collect_lm_leaves(
-    bool disjunctive_lms, const LandmarkSet &reached_lms) {
+    bool disjunctive_lms, const BitsetView &reached_lms) {
     vector<FactPair> leaves;
     for (const LandmarkNode *node_p : lgraph->get_nodes()) {
         if (!disjunctive_lms && node_p->disjunctive)
             continue;
 
-        if (!reached_lms.count(node_p) &&
-            !check_node_orders_disobeyed(*node_p, reached_lms)) {
+        int id = node_p->get_id();
+        if (!reached_lms.test(id) &&
+            lm_status_manager->landmark_is_leaf(id, reached_lms)) {
             leaves.insert(
                 leaves.end(), node_p->facts.begin(), node_p->facts.end());
         }
@@ -188,18 +185,8 @@ vector<FactPair> LandmarkCountHeuristic::collect_lm_leaves(
     return leaves;
 }
 
-bool LandmarkCountHeuristic::check_node_orders_disobeyed(const LandmarkNode &node,
-                                                         const LandmarkSet &reached) const {
-    for (const auto &parent : node.parents) {
-        if (reached.count(parent.first) == 0) {
-            return true;
-        }
-    }
-    return false;
-}
-
-bool LandmarkCountHeuristic::generate_helpful_actions(const State &state,
-                                                      const LandmarkSet &reached) {
+bool LandmarkCountHeuristic::generate_helpful_actions(
+    const State &state, const BitsetView &reached, bool all_lms_reached) {
     /* Find actions that achieve new landmark leaves. If no such action exist,
      return false. If a simple landmark can be achieved, return only operators
      that achieve simple landmarks, else return operators that achieve
@@ -218,7 +205,8 @@ bool LandmarkCountHeuristic::generate_helpful_actions(const State &state,
                 continue;
             FactProxy fact_proxy = effect.get_fact();
             LandmarkNode *lm_p = lgraph->get_landmark(fact_proxy.get_pair());
-            if (lm_p != 0 && landmark_is_interesting(state, reached, *lm_p)) {
+            if (lm_p != 0 &&
+                landmark_is_interesting(state, reached, all_lms_reached, *lm_p)) {
                 if (lm_p->disjunctive) {
                     ha_disj.push_back(op_id);
                 } else {
@@ -244,17 +232,18 @@ bool LandmarkCountHeuristic::generate_helpful_actions(const State &state,
 }
 
 bool LandmarkCountHeuristic::landmark_is_interesting(
-    const State &state, const LandmarkSet &reached, LandmarkNode &lm) const {
+    const State &state, const BitsetView &reached, bool all_lms_reached,
+    LandmarkNode &lm) const {
     /* A landmark is interesting if it hasn't been reached before and
      its parents have all been reached, or if all landmarks have been
      reached before, the LM is a goal, and it's not true at moment */
 
-    int num_reached = reached.size();
-    if (num_reached != lgraph->number_of_landmarks()) {
-        if (reached.find(&lm) != reached.end())
+    if (!all_lms_reached) {
+        int id = lm.get_id();
+        if (reached.test(id))
             return false;
         else
-            return !check_node_orders_disobeyed(lm, reached);
+            return lm_status_manager->landmark_is_leaf(id, reached);
     }
     return lm.is_goal() && !lm.is_true_in_state(state);
 }
@@ -278,18 +267,6 @@ bool LandmarkCountHeuristic::dead_ends_are_reliable() const {
     return dead_ends_reliable;
 }
 
-// This function exists purely so we don't have to change all the
-// functions in this class that use LandmarkSets for the reached LMs
-// (HACK).
-LandmarkSet LandmarkCountHeuristic::convert_to_landmark_set(
-    const BitsetView &landmark_bitset) {
-    LandmarkSet landmark_set;
-    for (int i = 0; i < landmark_bitset.size(); ++i)
-        if (landmark_bitset.test(i))
-            landmark_set.insert(lgraph->get_lm_for_index(i));
-    return landmark_set;
-}
-
 
 static Heuristic *_parse(OptionParser &parser) {
     parser.document_synopsis("Landmark-count heuristic",
@@ -33,20 +33,16 @@ class LandmarkCountHeuristic : public Heuristic {
     int get_heuristic_value(const GlobalState &global_state);
 
     std::vector<FactPair> collect_lm_leaves(
-        bool disjunctive_lms, const LandmarkSet &result);
-
-    bool check_node_orders_disobeyed(
-        const LandmarkNode &node, const LandmarkSet &reached) const;
+        bool disjunctive_lms, const BitsetView &reached);
 
     void add_node_children(LandmarkNode &node, const LandmarkSet &reached) const;
 
     bool landmark_is_interesting(
-        const State &state, const LandmarkSet &reached, LandmarkNode &lm) const;
+        const State &state, const BitsetView &reached, bool all_lms_reached,
+        LandmarkNode &lm) const;
     bool generate_helpful_actions(
-        const State &state, const LandmarkSet &reached);
+        const State &state, const BitsetView &reached, bool all_lms_reached);
     void set_exploration_goals(const GlobalState &global_state);
-
-    LandmarkSet convert_to_landmark_set(const BitsetView &landmark_bitset);
 protected:
     virtual int compute_heuristic(const GlobalState &state) override;
 public:
@@ -161,12 +161,12 @@ bool LandmarkFactory::relaxed_task_solvable(const TaskProxy &task_proxy,
                                      numeric_limits<int>::max());
     }
     // Extract propositions from "exclude"
-    unordered_set<int> exclude_op_ids;
+    dynamic_bitset::DynamicBitset<> exclude_op_ids(operators.size());
     vector<FactPair> exclude_props;
     if (exclude) {
         for (OperatorProxy op : operators) {
             if (achieves_non_conditional(op, exclude))
-                exclude_op_ids.insert(op.get_id());
+                exclude_op_ids.set(op.get_id());
         }
         exclude_props.insert(exclude_props.end(),
                              exclude->facts.begin(), exclude->facts.end());
@@ -210,11 +210,12 @@ bool LandmarkFactory::is_causal_landmark(const TaskProxy &task_proxy, Exploratio
         lvl_var[var.get_id()].resize(var.get_domain_size(),
                                      numeric_limits<int>::max());
     }
-    unordered_set<int> exclude_op_ids;
+    OperatorsProxy operators = task_proxy.get_operators();
+    dynamic_bitset::DynamicBitset<> exclude_op_ids(operators.size());
     vector<FactPair> exclude_props;
-    for (OperatorProxy op : task_proxy.get_operators()) {
+    for (OperatorProxy op : operators) {
         if (is_landmark_precondition(op, &landmark)) {
-            exclude_op_ids.insert(op.get_id());
+            exclude_op_ids.set(op.get_id());
         }
     }
     // Do relaxed exploration
@@ -133,10 +133,7 @@ public:
     // ------------------------------------------------------------------------------
     // methods needed only by non-landmarkgraph-factories
     inline int cost_of_landmarks() const {return landmarks_cost;}
-    void count_costs();
     LandmarkNode *get_lm_for_index(int) const;
-    int get_needed_cost() const {return needed_cost;}
-    int get_reached_cost() const {return reached_cost;}
     LandmarkNode *get_landmark(const FactPair &fact) const;
 
     // ------------------------------------------------------------------------------
@@ -197,8 +194,6 @@ private:
     void generate_operators_lookups(const TaskProxy &task_proxy);
     int landmarks_count;
     int conj_lms;
-    int reached_cost;
-    int needed_cost;
     int landmarks_cost;
     std::unordered_map<FactPair, LandmarkNode *> simple_lms_to_nodes;
     std::unordered_map<FactPair, LandmarkNode *> disj_lms_to_nodes;
@@ -2,60 +2,173 @@
 
 #include "landmark_graph.h"
 
+#include <algorithm>
+#include <iostream>
+
 using namespace std;
 
 namespace landmarks {
+using Block = BitsetMath::Block;
+
+static void set_bit(Block *blocks, int index) {
+    blocks[BitsetMath::block_index(index)] |= BitsetMath::bit_mask(index);
+}
+
+static bool test_bit(const Block *blocks, int index) {
+    return (blocks[BitsetMath::block_index(index)] & BitsetMath::bit_mask(index)) != 0;
+}
+
+// Remove the lowest set bit from bits and return its position.
+static int pop_lowest_bit(Block &bits) {
+    assert(bits);
+    Block lowest_bit = bits & (~bits + 1);
+    bits ^= lowest_bit;
+    return BitsetMath::count_bits(lowest_bit - 1);
+}
+
 /*
   By default we mark all landmarks as reached, since we do an intersection when
   computing new landmark information.
 */
 LandmarkStatusManager::LandmarkStatusManager(LandmarkGraph &graph)
     : reached_lms(vector<bool>(graph.number_of_landmarks(), true)),
-      lm_graph(graph) {
+      lm_graph(graph),
+      num_landmarks(graph.number_of_landmarks()),
+      num_blocks(BitsetMath::compute_num_blocks(num_landmarks)),
+      parent_masks(num_landmarks * num_blocks, 0),
+      greedy_necessary_children_masks(num_landmarks * num_blocks, 0),
+      goal_lms(num_blocks, 0),
+      lms_without_first_achievers(num_blocks, 0),
+      lms_without_possible_achievers(num_blocks, 0),
+      uniform_landmark_cost(-1),
+      true_lms(num_blocks, 0),
+      needed_again_lms(num_blocks, 0),
+      reached_cost(0),
+      needed_cost(0) {
+    nodes_by_id.reserve(num_landmarks);
+    landmark_costs.reserve(num_landmarks);
+    for (int id = 0; id < num_landmarks; ++id) {
+        LandmarkNode *node = lm_graph.get_lm_for_index(id);
+        nodes_by_id.push_back(node);
+        landmark_costs.push_back(node->min_cost);
+    }
+    if (!landmark_costs.empty() &&
+        all_of(landmark_costs.begin(), landmark_costs.end(),
+               [this](int cost) {return cost == landmark_costs[0];})) {
+        uniform_landmark_cost = landmark_costs[0];
+    }
+
+    for (const LandmarkNode *node : nodes_by_id) {
+        int id = node->get_id();
+        for (const auto &parent : node->parents) {
+            set_bit(&parent_masks[id * num_blocks], parent.first->get_id());
+        }
+        for (const auto &child : node->children) {
+            if (child.second >= EdgeType::greedy_necessary) {
+                set_bit(&greedy_necessary_children_masks[id * num_blocks],
+                        child.first->get_id());
+            }
+        }
+        if (node->is_goal()) {
+            set_bit(goal_lms.data(), id);
+        }
+        if (!node->is_derived) {
+            if (node->first_achievers.empty()) {
+                set_bit(lms_without_first_achievers.data(), id);
+            }
+            if (node->possible_achievers.empty()) {
+                set_bit(lms_without_possible_achievers.data(), id);
+            }
+        }
+
+        if (node->conjunctive) {
+            conjunctive_lm_ids.push_back(id);
+            continue;
+        }
+        for (const FactPair &fact : node->facts) {
+            if (fact.var >= static_cast<int>(fact_mask_ids.size())) {
+                fact_mask_ids.resize(fact.var + 1);
+            }
+            vector<int> &mask_ids = fact_mask_ids[fact.var];
+            if (fact.value >= static_cast<int>(mask_ids.size())) {
+                mask_ids.resize(fact.value + 1, -1);
+            }
+            if (mask_ids[fact.value] == -1) {
+                mask_ids[fact.value] = fact_masks.size() / num_blocks;
+                fact_masks.resize(fact_masks.size() + num_blocks, 0);
+            }
+            set_bit(&fact_masks[mask_ids[fact.value] * num_blocks], id);
+        }
+    }
+    for (size_t var = 0; var < fact_mask_ids.size(); ++var) {
+        if (!fact_mask_ids[var].empty()) {
+            vars_in_landmarks.push_back(var);
+        }
+    }
 }
 
 BitsetView LandmarkStatusManager::get_reached_landmarks(const GlobalState &state) {
     return reached_lms[state];
 }
 
+void LandmarkStatusManager::compute_true_landmarks(const GlobalState &global_state) {
+    fill(true_lms.begin(), true_lms.end(), 0);
+    for (int var : vars_in_landmarks) {
+        const vector<int> &mask_ids = fact_mask_ids[var];
+        int value = global_state[var];
+        if (value < static_cast<int>(mask_ids.size()) && mask_ids[value] != -1) {
+            const Block *mask = &fact_masks[mask_ids[value] * num_blocks];
+            for (int i = 0; i < num_blocks; ++i) {
+                true_lms[i] |= mask[i];
+            }
+        }
+    }
+    for (int id : conjunctive_lm_ids) {
+        if (nodes_by_id[id]->is_true_in_state(global_state)) {
+            set_bit(true_lms.data(), id);
+        }
+    }
+}
+
+bool LandmarkStatusManager::is_subset(
+    const Block *mask, const BitsetView &reached) const {
+    for (int i = 0; i < num_blocks; ++i) {
+        if (mask[i] & ~reached.get_block(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int LandmarkStatusManager::compute_cost(Block landmarks, int block) const {
+    if (uniform_landmark_cost != -1) {
+        return BitsetMath::count_bits(landmarks) * uniform_landmark_cost;
+    }
+    int cost = 0;
+    while (landmarks) {
+        int id = block * BitsetMath::bits_per_block + pop_lowest_bit(landmarks);
+        cost += landmark_costs[id];
+    }
+    return cost;
+}
+
 void LandmarkStatusManager::set_landmarks_for_initial_state(
     const GlobalState &initial_state) {
     BitsetView reached = get_reached_landmarks(initial_state);
     // This is necessary since the default is "true for all" (see comment above).
     reached.reset();
 
+    compute_true_landmarks(initial_state);
     int inserted = 0;
     int num_goal_lms = 0;
-    const set<LandmarkNode *> &nodes = lm_graph.get_nodes();
-    for (set<LandmarkNode *>::iterator it = nodes.begin(); it != nodes.end(); ++it) {
-        LandmarkNode *node_p = *it;
-        if (node_p->in_goal) {
+    for (const LandmarkNode *node : nodes_by_id) {
+        if (node->in_goal) {
             ++num_goal_lms;
         }
-
-        if (!node_p->parents.empty()) {
-            continue;
-        }
-        if (node_p->conjunctive) {
-            bool lm_true = true;
-            for (const FactPair &fact : node_p->facts) {
-                if (initial_state[fact.var] != fact.value) {
-                    lm_true = false;
-                    break;
-                }
-            }
-            if (lm_true) {
-                reached.set(node_p->get_id());
-                ++inserted;
-            }
-        } else {
-            for (const FactPair &fact : node_p->facts) {
-                if (initial_state[fact.var] == fact.value) {
-                    reached.set(node_p->get_id());
-                    ++inserted;
-                    break;
-                }
-            }
+        int id = node->get_id();
+        if (node->parents.empty() && test_bit(true_lms.data(), id)) {
+            reached.set(id);
+            ++inserted;
         }
     }
     cout << inserted << " initial landmarks, "
@@ -74,7 +187,6 @@ bool LandmarkStatusManager::update_reached_lms(const GlobalState &parent_global_
     const BitsetView parent_reached = get_reached_landmarks(parent_global_state);
     BitsetView reached = get_reached_landmarks(global_state);
 
-    int num_landmarks = lm_graph.number_of_landmarks();
     assert(reached.size() == num_landmarks);
     assert(parent_reached.size() == num_landmarks);
 
@@ -90,15 +202,19 @@ bool LandmarkStatusManager::update_reached_lms(const GlobalState &parent_global_
     */
     reached.intersect(parent_reached);
 
-
-    // Mark landmarks reached right now as "reached" (if they are "leaves").
-    for (int id = 0; id < num_landmarks; ++id) {
-        if (!reached.test(id)) {
-            LandmarkNode *node = lm_graph.get_lm_for_index(id);
-            if (node->is_true_in_state(global_state)) {
-                if (landmark_is_leaf(*node, reached)) {
-                    reached.set(id);
-                }
+    /*
+      Mark landmarks reached right now as "reached" (if they are "leaves").
+      We consider the candidates by increasing id and test each one against
+      the current reached set, so landmarks marked here can make their
+      children leaves.
+    */
+    compute_true_landmarks(global_state);
+    for (int block = 0; block < num_blocks; ++block) {
+        Block candidates = true_lms[block] & ~reached.get_block(block);
+        while (candidates) {
+            int id = block * BitsetMath::bits_per_block + pop_lowest_bit(candidates);
+            if (is_subset(&parent_masks[id * num_blocks], reached)) {
+                reached.set(id);
             }
         }
     }
@@ -108,75 +224,71 @@ bool LandmarkStatusManager::update_reached_lms(const GlobalState &parent_global_
 
 bool LandmarkStatusManager::update_lm_status(const GlobalState &global_state) {
     const BitsetView reached = get_reached_landmarks(global_state);
+    compute_true_landmarks(global_state);
 
-    const set<LandmarkNode *> &nodes = lm_graph.get_nodes();
-    // initialize all nodes to not reached and not effect of unused ALM
-    for (LandmarkNode *node : nodes) {
-        node->status = lm_not_reached;
-        if (reached.test(node->get_id())) {
-            node->status = lm_reached;
-        }
-    }
-
+    /*
+      A reached landmark that is false now is needed again if it is a goal
+      or if it has a greedy-necessary child that is not reached.
+    */
     bool dead_end_found = false;
-
-    // mark reached and find needed again landmarks
-    for (LandmarkNode *node : nodes) {
-        if (node->status == lm_reached) {
-            if (!node->is_true_in_state(global_state)) {
-                if (node->is_goal()) {
-                    node->status = lm_needed_again;
-                } else {
-                    if (check_lost_landmark_children_needed_again(*node)) {
-                        node->status = lm_needed_again;
-                    }
-                }
+    reached_cost = 0;
+    needed_cost = 0;
+    for (int block = 0; block < num_blocks; ++block) {
+        Block reached_block = reached.get_block(block);
+        Block lost = reached_block & ~true_lms[block];
+        Block needed_again = lost & goal_lms[block];
+        Block candidates = lost & ~goal_lms[block];
+        while (candidates) {
+            int id = block * BitsetMath::bits_per_block + pop_lowest_bit(candidates);
+            if (!is_subset(&greedy_necessary_children_masks[id * num_blocks],
+                           reached)) {
+                needed_again |= BitsetMath::bit_mask(id);
             }
         }
+        needed_again_lms[block] = needed_again;
+        reached_cost += compute_cost(reached_block, block);
+        needed_cost += compute_cost(needed_again, block);
 
-        // This dead-end detection works for the following case:
-        // X is a goal, it is true in the initial state, and has no achievers.
-        // Some action A has X as a delete effect. Then using this,
-        // we can detect that applying A leads to a dead-end.
-        //
-        // Note: this only tests for reachability of the landmark from the initial state.
-        // A (possibly) more effective option would be to test reachability of the landmark
-        // from the current state.
+        /*
+          This dead-end detection works for the following case:
+          X is a goal, it is true in the initial state, and has no achievers.
+          Some action A has X as a delete effect. Then using this,
+          we can detect that applying A leads to a dead-end.
 
-        if (!node->is_derived) {
-            if ((node->status == lm_not_reached) &&
-                node->first_achievers.empty()) {
-                dead_end_found = true;
-            }
-            if ((node->status == lm_needed_again) &&
-                node->possible_achievers.empty()) {
-                dead_end_found = true;
-            }
+          Note: this only tests for reachability of the landmark from the
+          initial state. A (possibly) more effective option would be to test
+          reachability of the landmark from the current state.
+
+          Padding bits are zero in both achiever masks.
+        */
+        if ((~reached_block & lms_without_first_achievers[block]) ||
+            (needed_again & lms_without_possible_achievers[block])) {
+            dead_end_found = true;
         }
     }
 
+    write_node_statuses(reached);
+
     return dead_end_found;
 }
 
-
-bool LandmarkStatusManager::check_lost_landmark_children_needed_again(const LandmarkNode &node) const {
-    for (const auto &child : node.children) {
-        LandmarkNode *child_node = child.first;
-        if (child.second >= EdgeType::greedy_necessary && child_node->status == lm_not_reached)
-            return true;
+void LandmarkStatusManager::write_node_statuses(const BitsetView &reached) {
+    // The cost assignments read the status from the landmark nodes.
+    for (int id = 0; id < num_landmarks; ++id) {
+        LandmarkNode *node = nodes_by_id[id];
+        if (!reached.test(id)) {
+            node->status = lm_not_reached;
+        } else if (test_bit(needed_again_lms.data(), id)) {
+            node->status = lm_needed_again;
+        } else {
+            node->status = lm_reached;
+        }
     }
-    return false;
 }
 
-bool LandmarkStatusManager::landmark_is_leaf(const LandmarkNode &node, const BitsetView &reached) const {
+bool LandmarkStatusManager::landmark_is_leaf(
+    int lm_id, const BitsetView &reached) const {
     //Note: this is the same as !check_node_orders_disobeyed
-    for (const auto &parent : node.parents) {
-        LandmarkNode *parent_node = parent.first;
-        // Note: no condition on edge type here
-        if (!reached.test(parent_node->get_id())) {
-            return false;
-        }
-    }
-    return true;
+    return is_subset(&parent_masks[lm_id * num_blocks], reached);
 }
 }
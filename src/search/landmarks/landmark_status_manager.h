@@ -3,24 +3,87 @@
 
 #include "../per_state_bitset.h"
 
+#include <vector>
+
 namespace landmarks {
 class LandmarkGraph;
 class LandmarkNode;
 
+/*
+  All status computations work on whole words of landmark bitsets. We
+  precompute for every fact the set of (simple and disjunctive) landmarks
+  containing it and for every landmark the sets of its parents and of its
+  greedy-necessary children. A landmark set is stored as num_blocks
+  consecutive blocks; the sets of all landmarks are stored in flat arrays.
+*/
 class LandmarkStatusManager {
+    using Block = BitsetMath::Block;
+
     PerStateBitset reached_lms;
 
     LandmarkGraph &lm_graph;
+    const int num_landmarks;
+    const int num_blocks;
+    std::vector<LandmarkNode *> nodes_by_id;
+
+    /*
+      fact_mask_ids[var][value] is the index of the landmark set of the fact
+      in fact_masks or -1 if no simple or disjunctive landmark contains it.
+    */
+    std::vector<int> vars_in_landmarks;
+    std::vector<std::vector<int>> fact_mask_ids;
+    std::vector<Block> fact_masks;
+    std::vector<int> conjunctive_lm_ids;
+
+    std::vector<Block> parent_masks;
+    std::vector<Block> greedy_necessary_children_masks;
+
+    std::vector<Block> goal_lms;
+    // Non-derived landmarks without first and possible achievers.
+    std::vector<Block> lms_without_first_achievers;
+    std::vector<Block> lms_without_possible_achievers;
 
-    bool landmark_is_leaf(const LandmarkNode &node, const BitsetView &reached) const;
-    bool check_lost_landmark_children_needed_again(const LandmarkNode &node) const;
+    /*
+      If all landmarks have the same cost, this is the cost. Otherwise it
+      is -1 and we have to sum up the individual costs.
+    */
+    int uniform_landmark_cost;
+    std::vector<int> landmark_costs;
+
+    // Status of the state passed to the last call of update_lm_status().
+    std::vector<Block> true_lms;
+    std::vector<Block> needed_again_lms;
+    int reached_cost;
+    int needed_cost;
+
+    void compute_true_landmarks(const GlobalState &global_state);
+    bool is_subset(const Block *mask, const BitsetView &reached) const;
+    // Summed cost of the given landmarks, which form the given block.
+    int compute_cost(Block landmarks, int block) const;
+    void write_node_statuses(const BitsetView &reached);
 public:
     explicit LandmarkStatusManager(LandmarkGraph &graph);
 
     BitsetView get_reached_landmarks(const GlobalState &state);
 
+    /*
+      Compute which landmarks are reached and needed again in the given
+      state and store the status in the landmark nodes. Return true if the
+      state is detected to be a dead end.
+    */
     bool update_lm_status(const GlobalState &state);
 
+    // Summed costs of the last state passed to update_lm_status().
+    int get_reached_cost() const {
+        return reached_cost;
+    }
+    int get_needed_cost() const {
+        return needed_cost;
+    }
+
+    // Return true if all parents of the landmark are reached.
+    bool landmark_is_leaf(int lm_id, const BitsetView &reached) const;
+
     void set_landmarks_for_initial_state(const GlobalState &initial_state);
     bool update_reached_lms(const GlobalState &parent_state,
                             OperatorID op_id,
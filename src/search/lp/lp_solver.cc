@@ -13,13 +13,14 @@
 #endif
 #include <OsiSolverInterface.hpp>
 #include <CoinPackedMatrix.hpp>
-#include <CoinPackedVector.hpp>
+#include <CoinWarmStartBasis.hpp>
 #ifdef __GNUG__
 #pragma GCC diagnostic pop
 #endif
 #endif
 
 #include <cassert>
+#include <iostream>
 #include <numeric>
 
 using namespace std;
@@ -78,12 +79,25 @@ LPSolver::~LPSolver() {
 
 #ifdef USE_LP
 
+class LPBasis {
+public:
+    const CoinWarmStartBasis basis;
+
+    explicit LPBasis(const CoinWarmStartBasis &basis)
+        : basis(basis) {
+    }
+};
+
 LPSolver::LPSolver(LPSolverType solver_type)
     : is_initialized(false),
       is_solved(false),
       num_permanent_constraints(0),
-      has_temporary_constraints_(false) {
+      has_temporary_constraints_(false),
+      num_solves(0),
+      num_warm_starts(0),
+      num_iterations(0) {
     lp_solver = create_lp_solver(solver_type);
+    solve_timer.stop();
 }
 
 void LPSolver::clear_temporary_data() {
@@ -95,7 +109,6 @@ void LPSolver::clear_temporary_data() {
     objective.clear();
     row_lb.clear();
     row_ub.clear();
-    rows.clear();
 }
 
 void LPSolver::load_problem(LPObjectiveSense sense,
@@ -168,24 +181,24 @@ void LPSolver::add_temporary_constraints(const vector<LPConstraint> &constraints
         clear_temporary_data();
         int num_rows = constraints.size();
         for (const LPConstraint &constraint : constraints) {
+            const vector<int> &vars = constraint.get_variables();
+            const vector<double> &coeffs = constraint.get_coefficients();
+            assert(vars.size() == coeffs.size());
             row_lb.push_back(constraint.get_lower_bound());
             row_ub.push_back(constraint.get_upper_bound());
-            rows.push_back(new CoinShallowPackedVector(
-                               constraint.get_variables().size(),
-                               constraint.get_variables().data(),
-                               constraint.get_coefficients().data(),
-                               false));
+            starts.push_back(elements.size());
+            indices.insert(indices.end(), vars.begin(), vars.end());
+            elements.insert(elements.end(), coeffs.begin(), coeffs.end());
         }
+        // See load_problem() for the last entry of 'starts'.
+        starts.push_back(elements.size());
 
         try {
-            lp_solver->addRows(num_rows,
-                               rows.data(), row_lb.data(), row_ub.data());
+            lp_solver->addRows(num_rows, starts.data(), indices.data(),
+                               elements.data(), row_lb.data(), row_ub.data());
         } catch (CoinError &error) {
             handle_coin_error(error);
         }
-        for (CoinPackedVectorBase *row : rows) {
-            delete row;
-        }
         clear_temporary_data();
         has_temporary_constraints_ = true;
         is_solved = false;
@@ -278,12 +291,16 @@ void LPSolver::set_variable_upper_bound(int index, double bound) {
 
 void LPSolver::solve() {
     try {
+        solve_timer.resume();
         if (is_initialized) {
             lp_solver->resolve();
         } else {
             lp_solver->initialSolve();
             is_initialized = true;
         }
+        solve_timer.stop();
+        ++num_solves;
+        num_iterations += lp_solver->getIterationCount();
         if (lp_solver->isAbandoned()) {
             // The documentation of OSI is not very clear here but memory seems
             // to be the most common cause for this in our case.
@@ -297,6 +314,43 @@ void LPSolver::solve() {
     }
 }
 
+shared_ptr<const LPBasis> LPSolver::get_basis() const {
+    assert(is_solved);
+    unique_ptr<CoinWarmStart> warm_start;
+    try {
+        warm_start.reset(lp_solver->getWarmStart());
+    } catch (CoinError &error) {
+        handle_coin_error(error);
+    }
+    const CoinWarmStartBasis *basis =
+        dynamic_cast<const CoinWarmStartBasis *>(warm_start.get());
+    if (!basis)
+        return nullptr;
+    return make_shared<LPBasis>(*basis);
+}
+
+bool LPSolver::set_basis(const LPBasis &stored_basis) {
+    if (!is_initialized)
+        return false;
+    CoinWarmStartBasis basis(stored_basis.basis);
+    /*
+      Removing rows with non-basic slack variables leaves too many basic
+      variables. The solvers repair such bases when factorizing them.
+    */
+    basis.resize(get_num_constraints(), get_num_variables());
+    bool loaded = false;
+    try {
+        loaded = lp_solver->setWarmStart(&basis);
+    } catch (CoinError &error) {
+        handle_coin_error(error);
+    }
+    if (loaded) {
+        ++num_warm_starts;
+        is_solved = false;
+    }
+    return loaded;
+}
+
 bool LPSolver::has_optimal_solution() const {
     assert(is_solved);
     try {
@@ -350,6 +404,10 @@ int LPSolver::has_temporary_constraints() const {
 void LPSolver::print_statistics() const {
     cout << "LP variables: " << get_num_variables() << endl;
     cout << "LP constraints: " << get_num_constraints() << endl;
+    cout << "LP solves: " << num_solves << endl;
+    cout << "LP simplex iterations: " << num_iterations << endl;
+    cout << "LP warm starts from stored bases: " << num_warm_starts << endl;
+    cout << "LP solve time: " << solve_timer << endl;
 }
 
 #endif
@@ -3,6 +3,7 @@
 
 #include "../utils/language.h"
 #include "../utils/system.h"
+#include "../utils/timer.h"
 
 #include <functional>
 #include <memory>
@@ -23,7 +24,6 @@
 }
 #endif
 
-class CoinPackedVectorBase;
 class OsiSolverInterface;
 
 namespace options {
@@ -41,6 +41,12 @@ enum class LPObjectiveSense {
 
 void add_lp_solver_option_to_parser(options::OptionParser &parser);
 
+/*
+  Simplex basis of a solved LP (see LPSolver::get_basis()). The class is
+  only defined if the planner is built with LP support.
+*/
+class LPBasis;
+
 class LPConstraint {
     std::vector<int> variables;
     std::vector<double> coefficients;
@@ -86,6 +92,12 @@ class LPSolver {
     std::unique_ptr<OsiSolverInterface> lp_solver;
 #endif
 
+    // Statistics
+    int num_solves;
+    int num_warm_starts;
+    long long num_iterations;
+    utils::Timer solve_timer;
+
     /*
       Temporary data for assigning a new problem. We keep the vectors
       around to avoid recreating them in every assignment.
@@ -98,7 +110,6 @@ class LPSolver {
     std::vector<double> objective;
     std::vector<double> row_lb;
     std::vector<double> row_ub;
-    std::vector<CoinPackedVectorBase *> rows;
     void clear_temporary_data();
 public:
     LP_METHOD(explicit LPSolver(LPSolverType solver_type))
@@ -114,6 +125,10 @@ public:
                   LPObjectiveSense sense,
                   const std::vector<LPVariable> &variables,
                   const std::vector<LPConstraint> &constraints))
+    /*
+      All given constraints are passed to the solver in a single call and
+      all temporary constraints are removed at once.
+    */
     LP_METHOD(void add_temporary_constraints(const std::vector<LPConstraint> &constraints))
     LP_METHOD(void clear_temporary_constraints())
     LP_METHOD(double get_infinity() const)
@@ -127,6 +142,18 @@ public:
 
     LP_METHOD(void solve())
 
+    /*
+      Warm starts: get_basis() returns the basis of the last solved LP (or
+      nullptr if the solver does not provide one) and set_basis() makes a
+      basis the starting point of the next call to solve(). Rows that were
+      added or removed in the meantime (e.g., temporary constraints) are
+      handled by resizing the basis; new rows start with a basic slack
+      variable. set_basis() returns false if the solver rejects the basis.
+      Where bases are kept is up to the user of the solver.
+    */
+    LP_METHOD(std::shared_ptr<const LPBasis> get_basis() const)
+    LP_METHOD(bool set_basis(const LPBasis &basis))
+
     /*
       Return true if the solving the LP showed that it is bounded feasible and
       the discovered solution is guaranteed to be optimal. We test for
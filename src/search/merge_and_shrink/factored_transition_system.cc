@@ -93,10 +93,8 @@ bool FactoredTransitionSystem::is_component_valid(int index) const {
     if (compute_init_distances && !distances[index]->are_init_distances_computed()) {
         return false;
     }
-    if (compute_goal_distances && !distances[index]->are_goal_distances_computed()) {
-        return false;
-    }
-    return transition_systems[index]->are_transitions_sorted_unique();
+    // Transitions are sorted and unique by construction (see CompressedTransitions).
+    return !compute_goal_distances || distances[index]->are_goal_distances_computed();
 }
 
 void FactoredTransitionSystem::assert_all_components_valid() const {
@@ -346,11 +346,18 @@ vector<unique_ptr<TransitionSystem>> FTSFactory::create_transition_systems() {
     const bool compute_label_equivalence_relation = true;
     for (int var_no = 0; var_no < num_variables; ++var_no) {
         TransitionSystemData &ts_data = transition_system_data_by_var[var_no];
+        vector<CompressedTransitions> transitions_by_group_id;
+        transitions_by_group_id.reserve(ts_data.transitions_by_label.size());
+        for (vector<Transition> &transitions : ts_data.transitions_by_label) {
+            transitions_by_group_id.emplace_back(transitions);
+            utils::release_vector_memory(transitions);
+        }
+        utils::release_vector_memory(ts_data.transitions_by_label);
         result.push_back(utils::make_unique_ptr<TransitionSystem>(
                              ts_data.num_variables,
                              move(ts_data.incorporated_variables),
                              move(ts_data.label_equivalence_relation),
-                             move(ts_data.transitions_by_label),
+                             move(transitions_by_group_id),
                              ts_data.num_states,
                              move(ts_data.goal_states),
                              ts_data.init_state,
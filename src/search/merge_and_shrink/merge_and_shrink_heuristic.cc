@@ -20,8 +20,11 @@
 #include "../utils/markup.h"
 #include "../utils/math.h"
 #include "../utils/system.h"
+#include "../utils/thread_pool.h"
+#include "../utils/thread_pool_options.h"
 #include "../utils/timer.h"
 
+#include <atomic>
 #include <cassert>
 #include <iostream>
 #include <string>
@@ -47,8 +50,14 @@ MergeAndShrinkHeuristic::MergeAndShrinkHeuristic(const Options &opts)
       prune_unreachable_states(opts.get<bool>("prune_unreachable_states")),
       prune_irrelevant_states(opts.get<bool>("prune_irrelevant_states")),
       verbosity(static_cast<Verbosity>(opts.get_enum("verbosity"))),
+      thread_pool(utils::parse_thread_pool_from_options(opts)),
       starting_peak_memory(-1),
-      mas_representation(nullptr) {
+      mas_representation(nullptr),
+      memory_reporter(
+          "merge-and-shrink",
+          [this]() {
+              return mas_representation ? mas_representation->get_num_bytes() : 0;
+          }) {
     assert(max_states_before_merge > 0);
     assert(max_states >= max_states_before_merge);
     assert(shrink_threshold_before_merge <= max_states_before_merge);
@@ -181,29 +190,44 @@ int MergeAndShrinkHeuristic::prune_fts(
     FactoredTransitionSystem &fts, const utils::Timer &timer) const {
     /*
       Prune all factors according to the chosen options. Stop early if one
-      factor is unsolvable and return its index.
+      factor is unsolvable and return its index. The atomic factors are
+      independent, so we prune them concurrently. Factors after an
+      unsolvable factor are skipped, so that the first unsolvable factor is
+      found as in sequential pruning. Output of concurrent pruning would
+      interleave, so it only happens with a single thread.
     */
-    int unsolvable_index = -1;
-    bool pruned = false;
-    for (int index = 0; index < fts.get_size(); ++index) {
-        if (prune_unreachable_states || prune_irrelevant_states) {
-            bool pruned_factor = prune_step(
-                fts,
-                index,
-                prune_unreachable_states,
-                prune_irrelevant_states,
-                verbosity);
-            pruned = pruned || pruned_factor;
-        }
-        if (!fts.is_factor_solvable(index)) {
-            unsolvable_index = index;
-            break;
-        }
-    }
+    int num_factors = fts.get_size();
+    bool prune = prune_unreachable_states || prune_irrelevant_states;
+    Verbosity prune_verbosity =
+        thread_pool->get_num_threads() > 1 ? Verbosity::SILENT : verbosity;
+    // Written by concurrent tasks, hence atomic flags instead of vectors.
+    atomic<bool> pruned(false);
+    atomic<int> unsolvable_index(num_factors);
+    thread_pool->run(
+        num_factors,
+        [&](int index) {
+            if (index > unsolvable_index.load()) {
+                return;
+            }
+            if (prune && prune_step(
+                    fts,
+                    index,
+                    prune_unreachable_states,
+                    prune_irrelevant_states,
+                    prune_verbosity)) {
+                pruned = true;
+            }
+            if (!fts.is_factor_solvable(index)) {
+                int first = unsolvable_index.load();
+                while (index < first &&
+                       !unsolvable_index.compare_exchange_weak(first, index)) {
+                }
+            }
+        });
     if (verbosity >= Verbosity::NORMAL && pruned) {
         print_time(timer, "after pruning atomic factors");
     }
-    return unsolvable_index;
+    return unsolvable_index == num_factors ? -1 : unsolvable_index.load();
 }
 
 int MergeAndShrinkHeuristic::main_loop(
@@ -255,6 +279,7 @@ int MergeAndShrinkHeuristic::main_loop(
             max_states_before_merge,
             shrink_threshold_before_merge,
             *shrink_strategy,
+            *thread_pool,
             verbosity);
         if (verbosity >= Verbosity::NORMAL && shrunk) {
             print_time(timer, "after shrinking");
@@ -554,6 +579,14 @@ static Heuristic *_parse(OptionParser &parser) {
         "Note that for versions of Fast Downward prior to 2016-08-19, the "
         "syntax differs. See the recommendation in the file "
         "merge_and_shrink_heuristic.cc for an example configuration.");
+    parser.document_note(
+        "Parallel computation",
+        "With num_threads > 1, the atomic factors are pruned concurrently, "
+        "and the two factors of a merge are shrunk concurrently unless the "
+        "shrink strategy is randomized. The result does not depend on the "
+        "number of threads, but the output of concurrent computations is "
+        "suppressed. Merge scoring functions have their own num_threads "
+        "option.");
 
     // Merge strategy option.
     parser.add_option<shared_ptr<MergeStrategyFactory>>(
@@ -591,6 +624,7 @@ static Heuristic *_parse(OptionParser &parser) {
         "true");
 
     MergeAndShrinkHeuristic::add_shrink_limit_options_to_parser(parser);
+    utils::add_thread_pool_options(parser);
     Heuristic::add_options_to_parser(parser);
 
     vector<string> verbosity_levels;
@@ -3,9 +3,12 @@
 
 #include "../heuristic.h"
 
+#include "../utils/memory_accounting.h"
+
 #include <memory>
 
 namespace utils {
+class ThreadPool;
 class Timer;
 }
 
@@ -39,9 +42,12 @@ class MergeAndShrinkHeuristic : public Heuristic {
     const bool prune_irrelevant_states;
 
     const Verbosity verbosity;
+    // Runs independent per-factor computations concurrently.
+    std::shared_ptr<utils::ThreadPool> thread_pool;
     long starting_peak_memory;
     // The final merge-and-shrink representation, storing goal distances.
     std::unique_ptr<MergeAndShrinkRepresentation> mas_representation;
+    utils::MemoryReporter memory_reporter;
 
     void finalize_factor(FactoredTransitionSystem &fts, int index);
     int prune_fts(FactoredTransitionSystem &fts, const utils::Timer &timer) const;
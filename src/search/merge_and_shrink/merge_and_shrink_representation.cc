@@ -68,6 +68,10 @@ void MergeAndShrinkRepresentationLeaf::dump() const {
     cout << endl;
 }
 
+size_t MergeAndShrinkRepresentationLeaf::get_num_bytes() const {
+    return lookup_table.capacity() * sizeof(int);
+}
+
 
 MergeAndShrinkRepresentationMerge::MergeAndShrinkRepresentationMerge(
     unique_ptr<MergeAndShrinkRepresentation> left_child_,
@@ -136,4 +140,13 @@ void MergeAndShrinkRepresentationMerge::dump() const {
     cout << "dump right child:" << endl;
     right_child->dump();
 }
+
+size_t MergeAndShrinkRepresentationMerge::get_num_bytes() const {
+    size_t num_bytes = lookup_table.capacity() * sizeof(vector<int>);
+    for (const vector<int> &row : lookup_table) {
+        num_bytes += row.capacity() * sizeof(int);
+    }
+    return num_bytes + left_child->get_num_bytes() +
+           right_child->get_num_bytes();
+}
 }
@@ -1,6 +1,7 @@
 #ifndef MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 #define MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -26,6 +27,8 @@ public:
     virtual void apply_abstraction_to_lookup_table(
         const std::vector<int> &abstraction_mapping) = 0;
     virtual void dump() const = 0;
+    // Number of bytes of the lookup tables of this node and its children.
+    virtual std::size_t get_num_bytes() const = 0;
 };
 
 
@@ -42,6 +45,7 @@ public:
         const std::vector<int> &abstraction_mapping) override;
     virtual int get_value(const State &state) const override;
     virtual void dump() const override;
+    virtual std::size_t get_num_bytes() const override;
 };
 
 
@@ -60,6 +64,7 @@ public:
         const std::vector<int> &abstraction_mapping) override;
     virtual int get_value(const State &state) const override;
     virtual void dump() const override;
+    virtual std::size_t get_num_bytes() const override;
 };
 }
 
@@ -7,15 +7,23 @@
 #include "transition_system.h"
 
 #include "../options/option_parser.h"
+#include "../options/options.h"
 #include "../options/plugin.h"
 
 #include "../utils/markup.h"
+#include "../utils/thread_pool.h"
+#include "../utils/thread_pool_options.h"
 
 #include <cassert>
 
 using namespace std;
 
 namespace merge_and_shrink {
+MergeScoringFunctionDFP::MergeScoringFunctionDFP(
+    const options::Options &options)
+    : thread_pool(utils::parse_thread_pool_from_options(options)) {
+}
+
 vector<int> MergeScoringFunctionDFP::compute_label_ranks(
     const FactoredTransitionSystem &fts, int index) const {
     const TransitionSystem &ts = fts.get_ts(index);
@@ -27,7 +35,7 @@ vector<int> MergeScoringFunctionDFP::compute_label_ranks(
 
     for (const GroupAndTransitions &gat : ts) {
         const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
+        const CompressedTransitions &transitions = gat.transitions;
         // Relevant labels with no transitions have a rank of infinity.
         int label_rank = INF;
         bool group_relevant = false;
@@ -66,36 +74,49 @@ vector<double> MergeScoringFunctionDFP::compute_scores(
     const vector<pair<int, int>> &merge_candidates) {
     int num_ts = fts.get_size();
 
-    vector<vector<int>> transition_system_label_ranks(num_ts);
-    vector<double> scores;
-    scores.reserve(merge_candidates.size());
-
-    // Go over all pairs of transition systems and compute their weight.
+    // Compute the label ranks of all transition systems that are involved.
+    vector<int> involved_indices;
+    vector<bool> is_involved(num_ts, false);
     for (pair<int, int> merge_candidate : merge_candidates) {
-        int ts_index1 = merge_candidate.first;
-        int ts_index2 = merge_candidate.second;
-
-        vector<int> &label_ranks1 = transition_system_label_ranks[ts_index1];
-        if (label_ranks1.empty()) {
-            label_ranks1 = compute_label_ranks(fts, ts_index1);
-        }
-        vector<int> &label_ranks2 = transition_system_label_ranks[ts_index2];
-        if (label_ranks2.empty()) {
-            label_ranks2 = compute_label_ranks(fts, ts_index2);
-        }
-        assert(label_ranks1.size() == label_ranks2.size());
-
-        // Compute the weight associated with this pair
-        int pair_weight = INF;
-        for (size_t i = 0; i < label_ranks1.size(); ++i) {
-            if (label_ranks1[i] != -1 && label_ranks2[i] != -1) {
-                // label is relevant in both transition_systems
-                int max_label_rank = max(label_ranks1[i], label_ranks2[i]);
-                pair_weight = min(pair_weight, max_label_rank);
+        for (int index : {merge_candidate.first, merge_candidate.second}) {
+            if (!is_involved[index]) {
+                is_involved[index] = true;
+                involved_indices.push_back(index);
             }
         }
-        scores.push_back(pair_weight);
     }
+    vector<vector<int>> transition_system_label_ranks(num_ts);
+    thread_pool->run(
+        involved_indices.size(),
+        [&](int i) {
+            int index = involved_indices[i];
+            transition_system_label_ranks[index] =
+                compute_label_ranks(fts, index);
+        });
+
+    // Go over all pairs of transition systems and compute their weight.
+    int num_candidates = merge_candidates.size();
+    vector<double> scores(num_candidates);
+    thread_pool->run(
+        num_candidates,
+        [&](int i) {
+            const vector<int> &label_ranks1 =
+                transition_system_label_ranks[merge_candidates[i].first];
+            const vector<int> &label_ranks2 =
+                transition_system_label_ranks[merge_candidates[i].second];
+            assert(label_ranks1.size() == label_ranks2.size());
+
+            // Compute the weight associated with this pair
+            int pair_weight = INF;
+            for (size_t j = 0; j < label_ranks1.size(); ++j) {
+                if (label_ranks1[j] != -1 && label_ranks2[j] != -1) {
+                    // label is relevant in both transition_systems
+                    int max_label_rank = max(label_ranks1[j], label_ranks2[j]);
+                    pair_weight = min(pair_weight, max_label_rank);
+                }
+            }
+            scores[i] = pair_weight;
+        });
     return scores;
 }
 
@@ -118,10 +139,12 @@ static shared_ptr<MergeScoringFunction>_parse(options::OptionParser &parser) {
             "2358-2366",
             "AAAI Press 2014"));
 
+    utils::add_thread_pool_options(parser);
+    options::Options options = parser.parse();
     if (parser.dry_run())
         return nullptr;
     else
-        return make_shared<MergeScoringFunctionDFP>();
+        return make_shared<MergeScoringFunctionDFP>(options);
 }
 
 static options::PluginShared<MergeScoringFunction> _plugin("dfp", _parse);
@@ -12,6 +12,11 @@
 #include "../options/plugin.h"
 
 #include "../utils/markup.h"
+#include "../utils/thread_pool.h"
+#include "../utils/thread_pool_options.h"
+
+#include <cassert>
+#include <functional>
 
 using namespace std;
 
@@ -21,49 +26,64 @@ MergeScoringFunctionMIASM::MergeScoringFunctionMIASM(
     : shrink_strategy(options.get<shared_ptr<ShrinkStrategy>>("shrink_strategy")),
       max_states(options.get<int>("max_states")),
       max_states_before_merge(options.get<int>("max_states_before_merge")),
-      shrink_threshold_before_merge(options.get<int>("threshold_before_merge")) {
+      shrink_threshold_before_merge(options.get<int>("threshold_before_merge")),
+      thread_pool(utils::parse_thread_pool_from_options(options)) {
+}
+
+double MergeScoringFunctionMIASM::compute_score(
+    const FactoredTransitionSystem &fts, int index1, int index2) const {
+    unique_ptr<TransitionSystem> product = shrink_before_merge_externally(
+        fts,
+        index1,
+        index2,
+        *shrink_strategy,
+        max_states,
+        max_states_before_merge,
+        shrink_threshold_before_merge);
+
+    // Compute distances for the product and count the alive states.
+    unique_ptr<Distances> distances = utils::make_unique_ptr<Distances>(*product);
+    const bool compute_init_distances = true;
+    const bool compute_goal_distances = true;
+    const Verbosity verbosity = Verbosity::SILENT;
+    distances->compute_distances(compute_init_distances, compute_goal_distances, verbosity);
+    int num_states = product->get_size();
+    int alive_states_count = 0;
+    for (int state = 0; state < num_states; ++state) {
+        if (distances->get_init_distance(state) != INF &&
+            distances->get_goal_distance(state) != INF) {
+            ++alive_states_count;
+        }
+    }
+
+    /*
+      Compute the score as the ratio of alive states of the product
+      compared to the number of states of the full product.
+    */
+    assert(num_states);
+    return static_cast<double>(alive_states_count) /
+           static_cast<double>(num_states);
 }
 
 vector<double> MergeScoringFunctionMIASM::compute_scores(
     const FactoredTransitionSystem &fts,
     const vector<pair<int, int>> &merge_candidates) {
-    vector<double> scores;
-    scores.reserve(merge_candidates.size());
-    for (pair<int, int> merge_candidate : merge_candidates) {
-        int index1 = merge_candidate.first;
-        int index2 = merge_candidate.second;
-        unique_ptr<TransitionSystem> product = shrink_before_merge_externally(
-            fts,
-            index1,
-            index2,
-            *shrink_strategy,
-            max_states,
-            max_states_before_merge,
-            shrink_threshold_before_merge);
-
-        // Compute distances for the product and count the alive states.
-        unique_ptr<Distances> distances = utils::make_unique_ptr<Distances>(*product);
-        const bool compute_init_distances = true;
-        const bool compute_goal_distances = true;
-        const Verbosity verbosity = Verbosity::SILENT;
-        distances->compute_distances(compute_init_distances, compute_goal_distances, verbosity);
-        int num_states = product->get_size();
-        int alive_states_count = 0;
-        for (int state = 0; state < num_states; ++state) {
-            if (distances->get_init_distance(state) != INF &&
-                distances->get_goal_distance(state) != INF) {
-                ++alive_states_count;
-            }
+    int num_candidates = merge_candidates.size();
+    vector<double> scores(num_candidates);
+    function<void(int)> compute_candidate_score = [&](int i) {
+        scores[i] = compute_score(
+            fts, merge_candidates[i].first, merge_candidates[i].second);
+    };
+    /*
+      The tentative products are independent of each other, so we compute
+      them concurrently unless shrinking them draws random numbers.
+    */
+    if (shrink_strategy->supports_concurrent_use()) {
+        thread_pool->run(num_candidates, compute_candidate_score);
+    } else {
+        for (int i = 0; i < num_candidates; ++i) {
+            compute_candidate_score(i);
         }
-
-        /*
-          Compute the score as the ratio of alive states of the product
-          compared to the number of states of the full product.
-        */
-        assert(num_states);
-        double score = static_cast<double>(alive_states_count) /
-                       static_cast<double>(num_states);
-        scores.push_back(score);
     }
     return scores;
 }
@@ -116,6 +136,12 @@ static shared_ptr<MergeScoringFunction>_parse(options::OptionParser &parser) {
         "amount of possible pruning, merge-and-shrink should be configured to "
         "use full pruning, i.e. {{{prune_unreachable_states=true}}} and {{{"
         "prune_irrelevant_states=true}}} (the default).");
+    parser.document_note(
+        "Parallel computation",
+        "With num_threads > 1, the tentative products of the merge candidates "
+        "are computed concurrently. This is skipped if the shrink strategy is "
+        "randomized, because the result would depend on the order of the "
+        "computations.");
 
     // TODO: use shrink strategy and limit options from MergeAndShrinkHeuristic
     // instead of having the identical options here again.
@@ -124,6 +150,7 @@ static shared_ptr<MergeScoringFunction>_parse(options::OptionParser &parser) {
         "We recommend setting this to match the shrink strategy configuration "
         "given to {{{merge_and_shrink}}}, see note below.");
     MergeAndShrinkHeuristic::add_shrink_limit_options_to_parser(parser);
+    utils::add_thread_pool_options(parser);
 
     options::Options options = parser.parse();
     if (parser.help_mode()) {
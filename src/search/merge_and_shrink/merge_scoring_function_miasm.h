@@ -11,6 +11,10 @@ namespace options {
 class Options;
 }
 
+namespace utils {
+class ThreadPool;
+}
+
 namespace merge_and_shrink {
 class Distances;
 class ShrinkStrategy;
@@ -20,6 +24,10 @@ class MergeScoringFunctionMIASM : public MergeScoringFunction {
     const int max_states;
     const int max_states_before_merge;
     const int shrink_threshold_before_merge;
+    std::shared_ptr<utils::ThreadPool> thread_pool;
+
+    double compute_score(
+        const FactoredTransitionSystem &fts, int index1, int index2) const;
 protected:
     virtual std::string name() const override;
 public:
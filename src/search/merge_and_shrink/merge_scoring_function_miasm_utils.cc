@@ -28,10 +28,11 @@ unique_ptr<TransitionSystem> copy_and_shrink_ts(
     Verbosity verbosity) {
     /*
       TODO: think about factoring out common logic of this function and the
-      function shrink_factor in utils.cc
+      function shrink_before_merge_step in utils.cc
     */
     StateEquivalenceRelation equivalence_relation =
-        shrink_strategy.compute_equivalence_relation(ts, distances, new_size);
+        shrink_strategy.compute_equivalence_relation(
+            ts, distances, new_size, verbosity);
     // TODO: We currently violate this; see issue250
     //assert(equivalence_relation.size() <= target_size);
     int new_num_states = equivalence_relation.size();
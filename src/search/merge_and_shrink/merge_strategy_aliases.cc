@@ -12,6 +12,7 @@
 #include "../options/plugin.h"
 
 #include "../utils/markup.h"
+#include "../utils/thread_pool_options.h"
 
 using namespace std;
 
@@ -46,6 +47,8 @@ static shared_ptr<MergeStrategyFactory>_parse_dfp(options::OptionParser &parser)
         "systems are considered in an arbitrary order. This renders all other "
         "ordering options void.",
         "false");
+    // This is the num_threads option for MergeScoringFunctionDFP.
+    utils::add_thread_pool_options(parser);
     if (parser.dry_run() && !parser.help_mode())
         cout << "Warning: this command line option has been deprecated. Please "
             "consult fast-downward.org for equivalent new command line options."
@@ -57,7 +60,7 @@ static shared_ptr<MergeStrategyFactory>_parse_dfp(options::OptionParser &parser)
 
     vector<shared_ptr<MergeScoringFunction>> scoring_functions;
     scoring_functions.push_back(make_shared<MergeScoringFunctionGoalRelevance>());
-    scoring_functions.push_back(make_shared<MergeScoringFunctionDFP>());
+    scoring_functions.push_back(make_shared<MergeScoringFunctionDFP>(options));
 
     bool randomized_order = options.get<bool>("randomized_order");
     if (randomized_order) {
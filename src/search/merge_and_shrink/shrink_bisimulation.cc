@@ -8,12 +8,14 @@
 #include "../option_parser.h"
 #include "../plugin.h"
 
-#include "../utils/collections.h"
+#include "../utils/hash.h"
 #include "../utils/markup.h"
 #include "../utils/system.h"
+#include "../utils/timer.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <limits>
 #include <iostream>
 #include <memory>
@@ -22,73 +24,191 @@
 using namespace std;
 
 namespace merge_and_shrink {
-/* A successor signature characterizes the behaviour of an abstract
-   state in so far as bisimulation cares about it. States with
-   identical successor signature are not distinguished by
-   bisimulation.
-
-   Each entry in the vector is a pair of (label group ID, equivalence class of
-   successor). The bisimulation algorithm requires that the vector is
-   sorted and uniquified. */
-using SuccessorSignature = vector<pair<int, int>>;
+/*
+  A successor signature characterizes the behaviour of an abstract state in
+  so far as bisimulation cares about it. States with identical successor
+  signature are not distinguished by bisimulation.
+
+  Each entry is a pair of (label group ID, equivalence class of successor).
+  The entries of a signature are sorted and uniquified. We store the
+  signatures of all states that are refined in a round consecutively in one
+  flat vector.
+*/
+using SignatureEntry = pair<int, int>;
 
 /*
-  As we use SENTINEL numeric_limits<int>::max() as a sentinel signature and
-  irrelevant states have a distance of INF = numeric_limits<int>::max(), we
-  use INF - 1 as the distance value for all irrelevant states. This guarantees
-  that also irrelevant states are always ordered before the sentinel.
+  Irrelevant states have a distance of INF = numeric_limits<int>::max(). They
+  form their own groups, which we order after all relevant groups.
 */
-const int SENTINEL = numeric_limits<int>::max();
-const int IRRELEVANT = SENTINEL - 1;
+const int IRRELEVANT = numeric_limits<int>::max() - 1;
 
 /*
-  The following class encodes all we need to know about a state for
-  bisimulation: its h value, which equivalence class ("group") it currently
-  belongs to, its successor signature (see above), and what the original
-  state is.
+  Transitions of the transition system in compressed sparse row form, built
+  once per shrink call. The outgoing (label group, target) pairs of state s
+  are stored at positions succ_start[s] to succ_start[s + 1] - 1, the sources
+  of its incoming transitions at pred_start[s] to pred_start[s + 1] - 1.
 */
+struct BisimulationTransitions {
+    vector<int> succ_start;
+    vector<SignatureEntry> successors;
+    vector<int> pred_start;
+    vector<int> predecessors;
+
+    template<typename Callback>
+    static void for_each_transition(
+        const TransitionSystem &ts, const Distances &distances, bool greedy,
+        const Callback &callback) {
+        int label_group_counter = 0;
+        /*
+          Note that the final result of the bisimulation may depend on the
+          order in which transitions are considered below.
+
+          If label groups were sorted (every group by increasing label
+          numbers, groups by smallest label number), then the following
+          configuration gives a different result on
+          parcprinter-08-strips:p06.pddl:
+          astar(merge_and_shrink(
+                merge_strategy=merge_stateless(merge_selector=
+                    score_based_filtering(scoring_functions=[goal_relevance,
+                                                             dfp,
+                                                             total_order])),
+                shrink_strategy=shrink_bisimulation(greedy=false),
+                label_reduction=exact(before_shrinking=true,
+                                      before_merging=false),
+                max_states=50000,threshold_before_merge=1))
+
+          The same behavioral difference can be obtained even without
+          modifying the merge-and-shrink code, using the two revisions
+          c66ee00a250a and d2e317621f2c. Running the above config, adapted to
+          the old syntax, yields the same difference:
+          astar(merge_and_shrink(merge_strategy=merge_dfp,
+                shrink_strategy=shrink_bisimulation(greedy=false,
+                                                    max_states=50000,
+                                                    threshold=1),
+                label_reduction=exact(before_shrinking=true,
+                                      before_merging=false)))
+        */
+        for (const GroupAndTransitions &gat : ts) {
+            const LabelGroup &label_group = gat.label_group;
+            for (const Transition &transition : gat.transitions) {
+                bool skip_transition = false;
+                if (greedy) {
+                    int src_h = distances.get_goal_distance(transition.src);
+                    int target_h = distances.get_goal_distance(transition.target);
+                    if (src_h == INF || target_h == INF) {
+                        // We skip transitions connected to an irrelevant state.
+                        skip_transition = true;
+                    } else {
+                        int cost = label_group.get_cost();
+                        assert(target_h + cost >= src_h);
+                        skip_transition = (target_h + cost != src_h);
+                    }
+                }
+                if (!skip_transition) {
+                    callback(label_group_counter, transition);
+                }
+            }
+            ++label_group_counter;
+        }
+    }
 
-struct Signature {
-    int h_and_goal; // -1 for goal states; h value for non-goal states
-    int group;
-    SuccessorSignature succ_signature;
-    int state;
-
-    Signature(int h, bool is_goal, int group_,
-              const SuccessorSignature &succ_signature_,
-              int state_)
-        : group(group_), succ_signature(succ_signature_), state(state_) {
-        if (is_goal) {
-            assert(h == 0);
-            h_and_goal = -1;
-        } else {
-            h_and_goal = h;
+    BisimulationTransitions(
+        const TransitionSystem &ts, const Distances &distances, bool greedy)
+        : succ_start(ts.get_size() + 1, 0),
+          pred_start(ts.get_size() + 1, 0) {
+        int num_states = ts.get_size();
+        for_each_transition(
+            ts, distances, greedy,
+            [this](int, const Transition &transition) {
+                ++succ_start[transition.src + 1];
+                ++pred_start[transition.target + 1];
+            });
+        for (int state = 0; state < num_states; ++state) {
+            succ_start[state + 1] += succ_start[state];
+            pred_start[state + 1] += pred_start[state];
         }
+        successors.resize(succ_start[num_states]);
+        predecessors.resize(pred_start[num_states]);
+        vector<int> next_succ(succ_start.begin(), succ_start.end() - 1);
+        vector<int> next_pred(pred_start.begin(), pred_start.end() - 1);
+        for_each_transition(
+            ts, distances, greedy,
+            [&](int label_group, const Transition &transition) {
+                successors[next_succ[transition.src]++] =
+                    make_pair(label_group, transition.target);
+                predecessors[next_pred[transition.target]++] = transition.src;
+            });
     }
+};
 
-    bool operator<(const Signature &other) const {
-        if (h_and_goal != other.h_and_goal)
-            return h_and_goal < other.h_and_goal;
-        if (group != other.group)
-            return group < other.group;
-        if (succ_signature != other.succ_signature)
-            return succ_signature < other.succ_signature;
-        return state < other.state;
+/*
+  Signatures of the states that are refined in the current round. The
+  signature of the i-th state is stored at positions start[i] to
+  start[i + 1] - 1 of entries.
+*/
+struct SignatureTable {
+    vector<SignatureEntry> entries;
+    vector<int> start;
+    vector<uint64_t> hashes;
+
+    void clear() {
+        entries.clear();
+        start.assign(1, 0);
+        hashes.clear();
     }
 
-    void dump() const {
-        cout << "Signature(h_and_goal = " << h_and_goal
-             << ", group = " << group
-             << ", state = " << state
-             << ", succ_sig = [";
-        for (size_t i = 0; i < succ_signature.size(); ++i) {
-            if (i)
-                cout << ", ";
-            cout << "(" << succ_signature[i].first
-                 << "," << succ_signature[i].second
-                 << ")";
+    void add_signature(
+        const BisimulationTransitions &transitions,
+        const vector<int> &state_to_group,
+        int state) {
+        int begin = entries.size();
+        for (int i = transitions.succ_start[state];
+             i < transitions.succ_start[state + 1]; ++i) {
+            const SignatureEntry &succ = transitions.successors[i];
+            int target_group = state_to_group[succ.second];
+            assert(target_group != -1);
+            entries.emplace_back(succ.first, target_group);
         }
-        cout << "])" << endl;
+        sort(entries.begin() + begin, entries.end());
+        entries.erase(unique(entries.begin() + begin, entries.end()),
+                      entries.end());
+        start.push_back(entries.size());
+
+        utils::HashState hash_state;
+        for (size_t i = begin; i < entries.size(); ++i) {
+            hash_state.feed(entries[i].first);
+            hash_state.feed(entries[i].second);
+        }
+        hashes.push_back(hash_state.get_hash64());
+    }
+
+    int get_size(int i) const {
+        return start[i + 1] - start[i];
+    }
+
+    bool equal(int i, int j) const {
+        return hashes[i] == hashes[j] &&
+               get_size(i) == get_size(j) &&
+               std::equal(entries.begin() + start[i],
+                          entries.begin() + start[i + 1],
+                          entries.begin() + start[j]);
+    }
+
+    /*
+      Total order that puts equal signatures next to each other. Cheap
+      hash comparisons decide almost all cases. Ties are broken by index.
+    */
+    bool less(int i, int j) const {
+        if (hashes[i] != hashes[j])
+            return hashes[i] < hashes[j];
+        if (get_size(i) != get_size(j))
+            return get_size(i) < get_size(j);
+        auto mismatch = std::mismatch(
+            entries.begin() + start[i], entries.begin() + start[i + 1],
+            entries.begin() + start[j]);
+        if (mismatch.first != entries.begin() + start[i + 1])
+            return *mismatch.first < *mismatch.second;
+        return i < j;
     }
 };
 
@@ -101,7 +221,8 @@ ShrinkBisimulation::ShrinkBisimulation(const Options &opts)
 int ShrinkBisimulation::initialize_groups(
     const TransitionSystem &ts,
     const Distances &distances,
-    vector<int> &state_to_group) const {
+    vector<int> &state_to_group,
+    vector<int> &group_to_h_and_goal) const {
     /* Group 0 holds all goal states.
 
        Each other group holds all states with one particular h value.
@@ -115,6 +236,7 @@ int ShrinkBisimulation::initialize_groups(
     typedef unordered_map<int, int> GroupMap;
     GroupMap h_to_group;
     int num_groups = 1; // Group 0 is for goal states.
+    group_to_h_and_goal.assign(1, -1);
     for (int state = 0; state < ts.get_size(); ++state) {
         int h = distances.get_goal_distance(state);
         if (h == INF) {
@@ -130,218 +252,176 @@ int ShrinkBisimulation::initialize_groups(
             if (result.second) {
                 // We inserted a new element => a new group was started.
                 ++num_groups;
+                group_to_h_and_goal.push_back(h);
             }
         }
     }
     return num_groups;
 }
 
-void ShrinkBisimulation::compute_signatures(
-    const TransitionSystem &ts,
-    const Distances &distances,
-    vector<Signature> &signatures,
-    const vector<int> &state_to_group) const {
-    assert(signatures.empty());
-
-    // Step 1: Compute bare state signatures (without transition information).
-    signatures.push_back(Signature(-2, false, -1, SuccessorSignature(), -1));
-    for (int state = 0; state < ts.get_size(); ++state) {
-        int h = distances.get_goal_distance(state);
-        if (h == INF) {
-            h = IRRELEVANT;
-        }
-        Signature signature(h, ts.is_goal_state(state),
-                            state_to_group[state], SuccessorSignature(),
-                            state);
-        signatures.push_back(signature);
-    }
-    signatures.push_back(Signature(SENTINEL, false, -1, SuccessorSignature(), -1));
-
-    // Step 2: Add transition information.
-    int label_group_counter = 0;
-    /*
-      Note that the final result of the bisimulation may depend on the
-      order in which transitions are considered below.
-
-      If label groups were sorted (every group by increasing label numbers,
-      groups by smallest label number), then the following configuration
-      gives a different result on parcprinter-08-strips:p06.pddl:
-      astar(merge_and_shrink(
-            merge_strategy=merge_stateless(merge_selector=
-                score_based_filtering(scoring_functions=[goal_relevance,dfp,
-                                                         total_order])),
-            shrink_strategy=shrink_bisimulation(greedy=false),
-            label_reduction=exact(before_shrinking=true,before_merging=false),
-            max_states=50000,threshold_before_merge=1))
-
-      The same behavioral difference can be obtained even without modifying
-      the merge-and-shrink code, using the two revisions c66ee00a250a and
-      d2e317621f2c. Running the above config, adapted to the old syntax,
-      yields the same difference:
-      astar(merge_and_shrink(merge_strategy=merge_dfp,
-            shrink_strategy=shrink_bisimulation(greedy=false,max_states=50000,
-                                                threshold=1),
-            label_reduction=exact(before_shrinking=true,before_merging=false)))
-    */
-    for (const GroupAndTransitions &gat : ts) {
-        const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
-        for (const Transition &transition : transitions) {
-            assert(signatures[transition.src + 1].state == transition.src);
-            bool skip_transition = false;
-            if (greedy) {
-                int src_h = distances.get_goal_distance(transition.src);
-                int target_h = distances.get_goal_distance(transition.target);
-                if (src_h == INF || target_h == INF) {
-                    // We skip transitions connected to an irrelevant state.
-                    skip_transition = true;
-                } else {
-                    int cost = label_group.get_cost();
-                    assert(target_h + cost >= src_h);
-                    skip_transition = (target_h + cost != src_h);
-                }
-            }
-            if (!skip_transition) {
-                int target_group = state_to_group[transition.target];
-                assert(target_group != -1 && target_group != SENTINEL);
-                signatures[transition.src + 1].succ_signature.push_back(
-                    make_pair(label_group_counter, target_group));
-            }
-        }
-        ++label_group_counter;
-    }
-
-    /* Step 3: Canonicalize the representation. The resulting
-       signatures must satisfy the following properties:
-
-       1. Signature::operator< defines a total order with the correct
-          sentinels at the start and end. The signatures vector is
-          sorted according to that order.
-       2. Goal states come before non-goal states, and low-h states come
-          before high-h states.
-       3. States that currently fall into the same group form contiguous
-          subsequences.
-       4. Two signatures compare equal according to Signature::operator<
-          iff we don't want to distinguish their states in the current
-          bisimulation round.
-     */
-
-    for (size_t i = 0; i < signatures.size(); ++i) {
-        SuccessorSignature &succ_sig = signatures[i].succ_signature;
-        ::sort(succ_sig.begin(), succ_sig.end());
-        succ_sig.erase(::unique(succ_sig.begin(), succ_sig.end()),
-                       succ_sig.end());
-    }
-
-    ::sort(signatures.begin(), signatures.end());
-}
-
 StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
     const TransitionSystem &ts,
     const Distances &distances,
-    int target_size) const {
+    int target_size,
+    Verbosity verbosity) const {
     assert(distances.are_goal_distances_computed());
+    utils::Timer timer;
     int num_states = ts.get_size();
 
     vector<int> state_to_group(num_states);
-    vector<Signature> signatures;
-    signatures.reserve(num_states + 2);
-
-    int num_groups = initialize_groups(ts, distances, state_to_group);
-    // cout << "number of initial groups: " << num_groups << endl;
+    // -1 for goal groups, h value (or IRRELEVANT) for all other groups.
+    vector<int> group_to_h_and_goal;
+    int num_groups = initialize_groups(
+        ts, distances, state_to_group, group_to_h_and_goal);
 
     // TODO: We currently violate this; see issue250
     // assert(num_groups <= target_size);
 
-    bool stable = false;
-    bool stop_requested = false;
-    while (!stable && !stop_requested && num_groups < target_size) {
-        stable = true;
+    BisimulationTransitions transitions(ts, distances, greedy);
 
-        signatures.clear();
-        compute_signatures(ts, distances, signatures, state_to_group);
-
-        // Verify size of signatures and presence of sentinels.
-        assert(static_cast<int>(signatures.size()) == num_states + 2);
-        assert(signatures[0].h_and_goal == -2);
-        assert(signatures[num_states + 1].h_and_goal == SENTINEL);
-
-        int sig_start = 1; // Skip over initial sentinel.
-        while (true) {
-            int h_and_goal = signatures[sig_start].h_and_goal;
-            if (h_and_goal == SENTINEL) {
-                // We have hit the end sentinel.
-                assert(sig_start + 1 == static_cast<int>(signatures.size()));
-                break;
+    /*
+      Classic signature refinement recomputes the signatures of all states
+      in every round. The signature of a state can only change if one of
+      its successors moved to a new group in the previous round, so we only
+      refine the groups of predecessors of moved states.
+    */
+    vector<bool> group_needs_refinement(num_groups, true);
+    vector<int> moved_states;
+    vector<int> refined_states;
+    vector<int> order;
+    vector<pair<int, int>> group_ranges;
+    SignatureTable signatures;
+
+    int num_rounds = 0;
+    bool stop_requested = false;
+    while (!stop_requested && num_groups < target_size) {
+        utils::Timer round_timer;
+        if (num_rounds > 0) {
+            for (int state : moved_states) {
+                for (int i = transitions.pred_start[state];
+                     i < transitions.pred_start[state + 1]; ++i) {
+                    int pred = transitions.predecessors[i];
+                    group_needs_refinement[state_to_group[pred]] = true;
+                }
             }
+        }
+        moved_states.clear();
 
-            // Compute the number of groups needed after splitting.
-            int num_old_groups = 0;
-            int num_new_groups = 0;
-            int sig_end;
-            for (sig_end = sig_start; true; ++sig_end) {
-                if (signatures[sig_end].h_and_goal != h_and_goal) {
-                    break;
-                }
+        refined_states.clear();
+        for (int state = 0; state < num_states; ++state) {
+            if (group_needs_refinement[state_to_group[state]])
+                refined_states.push_back(state);
+        }
+        if (refined_states.empty())
+            break;
+        fill(group_needs_refinement.begin(), group_needs_refinement.end(),
+             false);
+        ++num_rounds;
+
+        /*
+          Goal states come before non-goal states, and low-h states come
+          before high-h states. States of the same group form contiguous
+          subsequences.
+        */
+        sort(refined_states.begin(), refined_states.end(),
+             [&](int state1, int state2) {
+                 int group1 = state_to_group[state1];
+                 int group2 = state_to_group[state2];
+                 int key1 = group_to_h_and_goal[group1];
+                 int key2 = group_to_h_and_goal[group2];
+                 if (key1 != key2)
+                     return key1 < key2;
+                 if (group1 != group2)
+                     return group1 < group2;
+                 return state1 < state2;
+             });
 
-                const Signature &prev_sig = signatures[sig_end - 1];
-                const Signature &curr_sig = signatures[sig_end];
+        signatures.clear();
+        for (int state : refined_states) {
+            signatures.add_signature(transitions, state_to_group, state);
+        }
 
-                if (sig_end == sig_start) {
-                    assert(prev_sig.group != curr_sig.group);
+        /*
+          Within each group, sort the states by signature. The first
+          equivalence class of a group keeps the old group number.
+        */
+        int num_refined = refined_states.size();
+        order.resize(num_refined);
+        for (int i = 0; i < num_refined; ++i) {
+            order[i] = i;
+        }
+        int block_start = 0;
+        while (block_start < num_refined && !stop_requested) {
+            // Handle all groups with the same h value at once.
+            int h_and_goal = group_to_h_and_goal[
+                state_to_group[refined_states[block_start]]];
+            int block_end = block_start;
+            int num_additional_groups = 0;
+            group_ranges.clear();
+            while (block_end < num_refined) {
+                int group = state_to_group[refined_states[block_end]];
+                if (group_to_h_and_goal[group] != h_and_goal)
+                    break;
+                int group_start = block_end;
+                while (block_end < num_refined &&
+                       state_to_group[refined_states[block_end]] == group) {
+                    ++block_end;
                 }
-
-                if (prev_sig.group != curr_sig.group) {
-                    ++num_old_groups;
-                    ++num_new_groups;
-                } else if (prev_sig.succ_signature != curr_sig.succ_signature) {
-                    ++num_new_groups;
+                group_ranges.emplace_back(group_start, block_end);
+                sort(order.begin() + group_start, order.begin() + block_end,
+                     [&](int i, int j) {
+                         return signatures.less(i, j);
+                     });
+                for (int i = group_start + 1; i < block_end; ++i) {
+                    if (!signatures.equal(order[i - 1], order[i]))
+                        ++num_additional_groups;
                 }
             }
-            assert(sig_end > sig_start);
+            assert(block_end > block_start);
 
             if (at_limit == RETURN &&
-                num_groups - num_old_groups + num_new_groups > target_size) {
-                /* Can't split the group (or the set of groups for
-                   this h value) -- would exceed bound on abstract
-                   state number.
-                */
+                num_groups + num_additional_groups > target_size) {
+                /* Can't split the groups for this h value -- would exceed
+                   bound on abstract state number. */
                 stop_requested = true;
                 break;
-            } else if (num_new_groups != num_old_groups) {
-                // Split into new groups.
-                stable = false;
-
-                int new_group_no = -1;
-                for (int i = sig_start; i < sig_end; ++i) {
-                    const Signature &prev_sig = signatures[i - 1];
-                    const Signature &curr_sig = signatures[i];
-
-                    if (prev_sig.group != curr_sig.group) {
-                        // Start first group of a block; keep old group no.
-                        new_group_no = curr_sig.group;
-                    } else if (prev_sig.succ_signature
-                               != curr_sig.succ_signature) {
-                        new_group_no = num_groups++;
-                        assert(num_groups <= target_size);
-                    }
+            }
 
-                    assert(new_group_no != -1);
-                    state_to_group[curr_sig.state] = new_group_no;
-                    if (num_groups == target_size)
-                        break;
+            for (const pair<int, int> &range : group_ranges) {
+                int new_group = state_to_group[refined_states[order[range.first]]];
+                for (int i = range.first + 1; i < range.second; ++i) {
+                    if (!signatures.equal(order[i - 1], order[i])) {
+                        if (num_groups == target_size) {
+                            stop_requested = true;
+                            break;
+                        }
+                        new_group = num_groups++;
+                        group_to_h_and_goal.push_back(h_and_goal);
+                        group_needs_refinement.push_back(false);
+                    }
+                    int state = refined_states[order[i]];
+                    if (state_to_group[state] != new_group) {
+                        state_to_group[state] = new_group;
+                        moved_states.push_back(state);
+                    }
                 }
-                if (num_groups == target_size)
+                if (stop_requested)
                     break;
             }
-            sig_start = sig_end;
+            block_start = block_end;
+        }
+        if (verbosity >= Verbosity::VERBOSE) {
+            cout << ts.tag() << "bisimulation round " << num_rounds << ": "
+                 << num_refined << " states refined, " << num_groups
+                 << " groups, time: " << round_timer << endl;
         }
+        if (moved_states.empty())
+            break;
+    }
+    if (verbosity >= Verbosity::VERBOSE) {
+        cout << ts.tag() << "bisimulation: " << num_rounds << " rounds, time: "
+             << timer << endl;
     }
-
-    /* Reduce memory pressure before generating the equivalence
-       relation since this is one of the code parts relevant to peak
-       memory. */
-    utils::release_vector_memory(signatures);
 
     // Generate final result.
     StateEquivalenceRelation equivalence_relation;
@@ -8,8 +8,6 @@ class Options;
 }
 
 namespace merge_and_shrink {
-struct Signature;
-
 class ShrinkBisimulation : public ShrinkStrategy {
     enum AtLimit {
         RETURN,
@@ -19,22 +17,11 @@ class ShrinkBisimulation : public ShrinkStrategy {
     const bool greedy;
     const AtLimit at_limit;
 
-    void compute_abstraction(
-        const TransitionSystem &ts,
-        const Distances &distances,
-        int target_size,
-        StateEquivalenceRelation &equivalence_relation) const;
-
     int initialize_groups(
         const TransitionSystem &ts,
         const Distances &distances,
-        std::vector<int> &state_to_group) const;
-
-    void compute_signatures(
-        const TransitionSystem &ts,
-        const Distances &distances,
-        std::vector<Signature> &signatures,
-        const std::vector<int> &state_to_group) const;
+        std::vector<int> &state_to_group,
+        std::vector<int> &group_to_h_and_goal) const;
 protected:
     virtual void dump_strategy_specific_options() const override;
     virtual std::string name() const override;
@@ -44,7 +31,8 @@ public:
     virtual StateEquivalenceRelation compute_equivalence_relation(
         const TransitionSystem &ts,
         const Distances &distances,
-        int target_size) const override;
+        int target_size,
+        Verbosity verbosity) const override;
 
     virtual bool requires_init_distances() const override {
         return false;
@@ -55,7 +55,12 @@ public:
     virtual StateEquivalenceRelation compute_equivalence_relation(
         const TransitionSystem &ts,
         const Distances &distances,
-        int target_size) const override;
+        int target_size,
+        Verbosity verbosity) const override;
+    // All calls draw from the same random number generator.
+    virtual bool supports_concurrent_use() const override {
+        return false;
+    }
     static void add_options_to_parser(options::OptionParser &parser);
 };
 }
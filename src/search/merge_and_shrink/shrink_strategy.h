@@ -35,10 +35,20 @@ public:
     virtual StateEquivalenceRelation compute_equivalence_relation(
         const TransitionSystem &ts,
         const Distances &distances,
-        int target_size) const = 0;
+        int target_size,
+        Verbosity verbosity) const = 0;
     virtual bool requires_init_distances() const = 0;
     virtual bool requires_goal_distances() const = 0;
 
+    /*
+      Return true iff compute_equivalence_relation() may be called for
+      different transition systems concurrently and its result does not
+      depend on the order of these calls.
+    */
+    virtual bool supports_concurrent_use() const {
+        return true;
+    }
+
     void dump_options() const;
     std::string get_name() const;
 };
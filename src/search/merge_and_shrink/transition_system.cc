@@ -33,9 +33,54 @@ static void normalize_given_transitions(vector<Transition> &transitions) {
     transitions.erase(unique(transitions.begin(), transitions.end()), transitions.end());
 }
 
+CompressedTransitions::CompressedTransitions()
+    : num_transitions(0) {
+}
+
+CompressedTransitions::CompressedTransitions(const vector<Transition> &transitions)
+    : num_transitions(transitions.size()) {
+    assert(utils::is_sorted_unique(transitions));
+    size_t num_all_transitions = transitions.size();
+    int prev_src = 0;
+    size_t i = 0;
+    while (i < num_all_transitions) {
+        int src = transitions[i].src;
+        size_t end = i + 1;
+        while (end < num_all_transitions && transitions[end].src == src)
+            ++end;
+        encode(src - prev_src);
+        encode(end - i);
+        encode(transitions[i].target);
+        for (size_t j = i + 1; j < end; ++j) {
+            encode(transitions[j].target - transitions[j - 1].target);
+        }
+        prev_src = src;
+        i = end;
+    }
+    data.shrink_to_fit();
+}
+
+void CompressedTransitions::encode(unsigned value) {
+    while (value >= 0x80) {
+        data.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<uint8_t>(value));
+}
+
+void CompressedTransitions::decompress(vector<Transition> &transitions) const {
+    transitions.insert(transitions.end(), begin(), end());
+}
+
+void CompressedTransitions::clear() {
+    utils::release_vector_memory(data);
+    num_transitions = 0;
+}
+
+
 TSConstIterator::TSConstIterator(
     const LabelEquivalenceRelation &label_equivalence_relation,
-    const vector<vector<Transition>> &transitions_by_group_id,
+    const vector<CompressedTransitions> &transitions_by_group_id,
     bool end)
     : label_equivalence_relation(label_equivalence_relation),
       transitions_by_group_id(transitions_by_group_id),
@@ -81,7 +126,7 @@ TransitionSystem::TransitionSystem(
     int num_variables,
     vector<int> &&incorporated_variables,
     unique_ptr<LabelEquivalenceRelation> &&label_equivalence_relation,
-    vector<vector<Transition>> &&transitions_by_label,
+    vector<CompressedTransitions> &&transitions_by_group_id,
     int num_states,
     vector<bool> &&goal_states,
     int init_state,
@@ -89,14 +134,13 @@ TransitionSystem::TransitionSystem(
     : num_variables(num_variables),
       incorporated_variables(move(incorporated_variables)),
       label_equivalence_relation(move(label_equivalence_relation)),
-      transitions_by_group_id(move(transitions_by_label)),
+      transitions_by_group_id(move(transitions_by_group_id)),
       num_states(num_states),
       goal_states(move(goal_states)),
       init_state(init_state) {
     if (compute_label_equivalence_relation) {
         compute_locally_equivalent_labels();
     }
-    assert(are_transitions_sorted_unique());
 }
 
 TransitionSystem::TransitionSystem(const TransitionSystem &other)
@@ -125,7 +169,6 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
     }
 
     assert(ts1.init_state != PRUNED_STATE && ts2.init_state != PRUNED_STATE);
-    assert(ts1.are_transitions_sorted_unique() && ts2.are_transitions_sorted_unique());
 
     int num_variables = ts1.num_variables;
     vector<int> incorporated_variables;
@@ -135,7 +178,7 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         back_inserter(incorporated_variables));
     unique_ptr<LabelEquivalenceRelation> label_equivalence_relation =
         utils::make_unique_ptr<LabelEquivalenceRelation>(labels);
-    vector<vector<Transition>> transitions_by_group_id(labels.get_max_size());
+    vector<CompressedTransitions> transitions_by_group_id(labels.get_max_size());
 
     int ts1_size = ts1.get_size();
     int ts2_size = ts2.get_size();
@@ -165,9 +208,14 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
     */
     int multiplier = ts2_size;
     vector<int> dead_labels;
+    // Reused buffers for the uncompressed transitions of one group.
+    vector<Transition> transitions1;
+    vector<Transition> transitions2;
+    vector<Transition> new_transitions;
     for (const GroupAndTransitions &gat : ts1) {
         const LabelGroup &group1 = gat.label_group;
-        const vector<Transition> &transitions1 = gat.transitions;
+        transitions1.clear();
+        gat.transitions.decompress(transitions1);
 
         // Distribute the labels of this group among the "buckets"
         // corresponding to the groups of ts2.
@@ -181,11 +229,12 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
 
         // Now create the new groups together with their transitions.
         for (const auto &bucket : buckets) {
-            const vector<Transition> &transitions2 =
-                ts2.get_transitions_for_group_id(bucket.first);
+            transitions2.clear();
+            ts2.get_transitions_for_group_id(bucket.first).decompress(
+                transitions2);
 
             // Create the new transitions for this bucket
-            vector<Transition> new_transitions;
+            new_transitions.clear();
             if (!transitions1.empty() && !transitions2.empty()
                 && transitions1.size() > new_transitions.max_size() / transitions2.size())
                 utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
@@ -209,7 +258,8 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
             } else {
                 sort(new_transitions.begin(), new_transitions.end());
                 int new_index = label_equivalence_relation->add_label_group(new_labels);
-                transitions_by_group_id[new_index] = move(new_transitions);
+                transitions_by_group_id[new_index] =
+                    CompressedTransitions(new_transitions);
             }
         }
     }
@@ -247,16 +297,17 @@ void TransitionSystem::compute_locally_equivalent_labels() {
     for (int group_id1 = 0; group_id1 < label_equivalence_relation->get_size();
          ++group_id1) {
         if (!label_equivalence_relation->is_empty_group(group_id1)) {
-            const vector<Transition> &transitions1 = transitions_by_group_id[group_id1];
+            const CompressedTransitions &transitions1 =
+                transitions_by_group_id[group_id1];
             for (int group_id2 = group_id1 + 1;
                  group_id2 < label_equivalence_relation->get_size(); ++group_id2) {
                 if (!label_equivalence_relation->is_empty_group(group_id2)) {
-                    vector<Transition> &transitions2 = transitions_by_group_id[group_id2];
-                    if ((transitions1.empty() && transitions2.empty())
-                        || transitions1 == transitions2) {
+                    CompressedTransitions &transitions2 =
+                        transitions_by_group_id[group_id2];
+                    if (transitions1 == transitions2) {
                         label_equivalence_relation->move_group_into_group(
                             group_id2, group_id1);
-                        utils::release_vector_memory(transitions2);
+                        transitions2.clear();
                     }
                 }
             }
@@ -268,8 +319,6 @@ void TransitionSystem::apply_abstraction(
     const StateEquivalenceRelation &state_equivalence_relation,
     const vector<int> &abstraction_mapping,
     Verbosity verbosity) {
-    assert(are_transitions_sorted_unique());
-
     int new_num_states = state_equivalence_relation.size();
     assert(new_num_states < num_states);
     if (verbosity >= Verbosity::VERBOSE) {
@@ -293,28 +342,24 @@ void TransitionSystem::apply_abstraction(
     goal_states = move(new_goal_states);
 
     // Update all transitions.
-    for (vector<Transition> &transitions : transitions_by_group_id) {
+    vector<Transition> new_transitions;
+    for (CompressedTransitions &transitions : transitions_by_group_id) {
         if (!transitions.empty()) {
-            vector<Transition> new_transitions;
             /*
               We reserve more memory than necessary here, but this is better
               than potentially resizing the vector several times when inserting
               transitions one after the other. See issue604-v6.
-
-              An alternative could be to not use a new vector, but to modify
-              the existing transitions inplace, and to remove all empty
-              positions in the end. This would be more ugly, though.
             */
+            new_transitions.clear();
             new_transitions.reserve(transitions.size());
-            for (size_t i = 0; i < transitions.size(); ++i) {
-                const Transition &transition = transitions[i];
+            for (const Transition &transition : transitions) {
                 int src = abstraction_mapping[transition.src];
                 int target = abstraction_mapping[transition.target];
                 if (src != PRUNED_STATE && target != PRUNED_STATE)
                     new_transitions.push_back(Transition(src, target));
             }
             normalize_given_transitions(new_transitions);
-            transitions = move(new_transitions);
+            transitions = CompressedTransitions(new_transitions);
         }
     }
 
@@ -325,14 +370,11 @@ void TransitionSystem::apply_abstraction(
     if (verbosity >= Verbosity::VERBOSE && init_state == PRUNED_STATE) {
         cout << tag() << "initial state pruned; task unsolvable" << endl;
     }
-
-    assert(are_transitions_sorted_unique());
 }
 
 void TransitionSystem::apply_label_reduction(
     const vector<pair<int, vector<int>>> &label_mapping,
     bool only_equivalent_labels) {
-    assert(are_transitions_sorted_unique());
 
     /*
       We iterate over the given label mapping, treating every new label and
@@ -368,7 +410,7 @@ void TransitionSystem::apply_label_reduction(
           updating label_equivalence_relation, because after updating it,
           we cannot find out the group ID of reduced labels anymore.
         */
-        unordered_map<int, vector<Transition>> new_label_to_transitions;
+        unordered_map<int, CompressedTransitions> new_label_to_transitions;
         unordered_set<int> affected_group_ids;
         for (const pair<int, vector<int>> &mapping: label_mapping) {
             int new_label_no = mapping.first;
@@ -380,12 +422,14 @@ void TransitionSystem::apply_label_reduction(
                 int group_id = label_equivalence_relation->get_group_id(old_label_no);
                 if (seen_group_ids.insert(group_id).second) {
                     affected_group_ids.insert(group_id);
-                    const vector<Transition> &transitions = transitions_by_group_id[group_id];
+                    const CompressedTransitions &transitions =
+                        transitions_by_group_id[group_id];
                     new_label_transitions.insert(transitions.begin(), transitions.end());
                 }
             }
-            new_label_to_transitions[new_label_no] =
-                vector<Transition>(new_label_transitions.begin(), new_label_transitions.end());
+            new_label_to_transitions[new_label_no] = CompressedTransitions(
+                vector<Transition>(new_label_transitions.begin(),
+                                   new_label_transitions.end()));
         }
 
         /*
@@ -400,7 +444,7 @@ void TransitionSystem::apply_label_reduction(
         // Go over the new transitions and add them at the correct position.
         for (auto &label_and_transitions : new_label_to_transitions) {
             int new_label_no = label_and_transitions.first;
-            vector<Transition> &transitions = label_and_transitions.second;
+            CompressedTransitions &transitions = label_and_transitions.second;
             int new_group_id = label_equivalence_relation->get_group_id(new_label_no);
             transitions_by_group_id[new_group_id] = move(transitions);
         }
@@ -409,14 +453,12 @@ void TransitionSystem::apply_label_reduction(
         // group is empty.
         for (int group_id : affected_group_ids) {
             if (label_equivalence_relation->is_empty_group(group_id)) {
-                utils::release_vector_memory(transitions_by_group_id[group_id]);
+                transitions_by_group_id[group_id].clear();
             }
         }
 
         compute_locally_equivalent_labels();
     }
-
-    assert(are_transitions_sorted_unique());
 }
 
 string TransitionSystem::tag() const {
@@ -425,14 +467,6 @@ string TransitionSystem::tag() const {
     return desc + ": ";
 }
 
-bool TransitionSystem::are_transitions_sorted_unique() const {
-    for (const GroupAndTransitions &gat : *this) {
-        if (!utils::is_sorted_unique(gat.transitions))
-            return false;
-    }
-    return true;
-}
-
 bool TransitionSystem::is_solvable(const Distances &distances) const {
     if (init_state == PRUNED_STATE) {
         return false;
@@ -463,7 +497,6 @@ string TransitionSystem::get_description() const {
 }
 
 void TransitionSystem::dump_dot_graph() const {
-    assert(are_transitions_sorted_unique());
     cout << "digraph transition_system";
     for (size_t i = 0; i < incorporated_variables.size(); ++i)
         cout << "_" << incorporated_variables[i];
@@ -479,8 +512,7 @@ void TransitionSystem::dump_dot_graph() const {
     }
     for (const GroupAndTransitions &gat : *this) {
         const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
-        for (const Transition &transition : transitions) {
+        for (const Transition &transition : gat.transitions) {
             int src = transition.src;
             int target = transition.target;
             cout << "    node" << src << " -> node" << target << " [label = ";
@@ -510,13 +542,12 @@ void TransitionSystem::dump_labels_and_transitions() const {
         }
         cout << endl;
         cout << "transitions: ";
-        const vector<Transition> &transitions = gat.transitions;
-        for (size_t i = 0; i < transitions.size(); ++i) {
-            int src = transitions[i].src;
-            int target = transitions[i].target;
-            if (i != 0)
+        bool first = true;
+        for (const Transition &transition : gat.transitions) {
+            if (!first)
                 cout << ",";
-            cout << src << " -> " << target;
+            first = false;
+            cout << transition.src << " -> " << transition.target;
         }
         cout << endl;
         cout << "cost: " << label_group.get_cost() << endl;
@@ -3,7 +3,10 @@
 
 #include "types.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
@@ -37,11 +40,129 @@ struct Transition {
     }
 };
 
+/*
+  Sorted and unique transitions of a label group, stored compactly.
+
+  Transitions are grouped by source state. For every source state, we store
+  its difference to the previous source state, its number of transitions,
+  its first target and the differences between consecutive targets. All
+  numbers are encoded as variable-length integers with 7 bits per byte, so
+  most transitions only need one or two bytes instead of eight. As the
+  encoding of a sorted set of transitions is unique, two objects contain
+  the same transitions iff their encodings are equal.
+
+  Transitions can only be read sequentially. Code that modifies transitions
+  decodes them into a vector and creates a new object.
+*/
+class CompressedTransitions {
+    std::vector<std::uint8_t> data;
+    int num_transitions;
+
+    void encode(unsigned value);
+public:
+    class const_iterator {
+        const std::uint8_t *pos;
+        const std::uint8_t *end;
+        Transition current;
+        // Number of transitions of the current source state after current.
+        int remaining_targets;
+
+        static unsigned decode(const std::uint8_t *&pos) {
+            unsigned value = 0;
+            int shift = 0;
+            while (true) {
+                std::uint8_t byte = *pos++;
+                value |= static_cast<unsigned>(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                    return value;
+                shift += 7;
+            }
+        }
+
+        void advance() {
+            if (remaining_targets > 0) {
+                current.target += decode(pos);
+                --remaining_targets;
+            } else if (pos != end) {
+                current.src += decode(pos);
+                remaining_targets = decode(pos) - 1;
+                current.target = decode(pos);
+            } else {
+                pos = nullptr;
+            }
+        }
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Transition;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Transition *;
+        using reference = const Transition &;
+
+        // Passing nullptr for begin creates the end iterator.
+        const_iterator(const std::uint8_t *begin, const std::uint8_t *end)
+            : pos(begin), end(end), current(0, 0), remaining_targets(0) {
+            if (pos)
+                advance();
+        }
+
+        const Transition &operator*() const {
+            return current;
+        }
+
+        const Transition *operator->() const {
+            return &current;
+        }
+
+        const_iterator &operator++() {
+            advance();
+            return *this;
+        }
+
+        bool operator==(const const_iterator &other) const {
+            return pos == other.pos;
+        }
+
+        bool operator!=(const const_iterator &other) const {
+            return pos != other.pos;
+        }
+    };
+
+    CompressedTransitions();
+    // The given transitions must be sorted and unique.
+    explicit CompressedTransitions(const std::vector<Transition> &transitions);
+
+    const_iterator begin() const {
+        return const_iterator(data.data(), data.data() + data.size());
+    }
+
+    const_iterator end() const {
+        return const_iterator(nullptr, nullptr);
+    }
+
+    int size() const {
+        return num_transitions;
+    }
+
+    bool empty() const {
+        return num_transitions == 0;
+    }
+
+    bool operator==(const CompressedTransitions &other) const {
+        return data == other.data;
+    }
+
+    // Append all transitions to the given vector.
+    void decompress(std::vector<Transition> &transitions) const;
+
+    // Remove all transitions and free their memory.
+    void clear();
+};
+
 struct GroupAndTransitions {
     const LabelGroup &label_group;
-    const std::vector<Transition> &transitions;
+    const CompressedTransitions &transitions;
     GroupAndTransitions(const LabelGroup &label_group,
-                        const std::vector<Transition> &transitions)
+                        const CompressedTransitions &transitions)
         : label_group(label_group),
           transitions(transitions) {
     }
@@ -55,14 +176,14 @@ class TSConstIterator {
       easily exchanged.
     */
     const LabelEquivalenceRelation &label_equivalence_relation;
-    const std::vector<std::vector<Transition>> &transitions_by_group_id;
+    const std::vector<CompressedTransitions> &transitions_by_group_id;
     // current_group_id is the actual iterator
     int current_group_id;
 
     void next_valid_index();
 public:
     TSConstIterator(const LabelEquivalenceRelation &label_equivalence_relation,
-                    const std::vector<std::vector<Transition>> &transitions_by_group_id,
+                    const std::vector<CompressedTransitions> &transitions_by_group_id,
                     bool end);
     void operator++();
     GroupAndTransitions operator*() const;
@@ -105,12 +226,13 @@ private:
 
       We tested different alternatives to store the transitions, but they all
       performed worse: storing a vector transitions in the label group increases
-      memory usage and runtime; storing the transitions more compactly and
-      incrementally increasing the size of transitions_of_groups whenever a
-      new label group is added also increases runtime. See also issue492 and
-      issue521.
+      memory usage and runtime; incrementally increasing the size of
+      transitions_of_groups whenever a new label group is added also increases
+      runtime. See also issue492 and issue521. The transitions of each group
+      are stored in compressed form (see CompressedTransitions) because the
+      transitions dominate the memory usage of merge-and-shrink.
     */
-    std::vector<std::vector<Transition>> transitions_by_group_id;
+    std::vector<CompressedTransitions> transitions_by_group_id;
 
     int num_states;
     std::vector<bool> goal_states;
@@ -122,7 +244,7 @@ private:
     */
     void compute_locally_equivalent_labels();
 
-    const std::vector<Transition> &get_transitions_for_group_id(int group_id) const {
+    const CompressedTransitions &get_transitions_for_group_id(int group_id) const {
         return transitions_by_group_id[group_id];
     }
 
@@ -134,7 +256,7 @@ public:
         int num_variables,
         std::vector<int> &&incorporated_variables,
         std::unique_ptr<LabelEquivalenceRelation> &&label_equivalence_relation,
-        std::vector<std::vector<Transition>> &&transitions_by_label,
+        std::vector<CompressedTransitions> &&transitions_by_group_id,
         int num_states,
         std::vector<bool> &&goal_states,
         int init_state,
@@ -143,6 +265,8 @@ public:
     ~TransitionSystem();
     /*
       Factory method to construct the merge of two transition systems.
+      The product transitions are compressed label group by label group,
+      so the uncompressed transitions of at most one group exist at a time.
 
       Invariant: the children ts1 and ts2 must be solvable.
       (It is a bug to merge an unsolvable transition system.)
@@ -195,12 +319,6 @@ public:
     */
     std::string tag() const;
 
-    /*
-      The transitions for every group of locally equivalent labels are
-      sorted (by source, by target) and there are no duplicates.
-    */
-    bool are_transitions_sorted_unique() const;
-
     bool is_solvable(const Distances &distances) const;
     void dump_dot_graph() const;
     void dump_labels_and_transitions() const;
@@ -6,10 +6,13 @@
 #include "transition_system.h"
 
 #include "../utils/math.h"
+#include "../utils/thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <functional>
+#include <iostream>
 
 using namespace std;
 
@@ -54,24 +57,16 @@ pair<int, int> compute_shrink_sizes(
 }
 
 /*
-  This method checks if the transition system of the factor at index violates
-  the size limit given via new_size (e.g. as computed by compute_shrink_sizes)
-  or the threshold shrink_threshold_before_merge that triggers shrinking even
-  if the size limit is not violated. If so, trigger the shrinking process.
-  Return true iff the factor was actually shrunk.
+  Return true iff the transition system violates the size limit given via
+  new_size (e.g. as computed by compute_shrink_sizes) or the threshold
+  shrink_threshold_before_merge that triggers shrinking even if the size
+  limit is not violated.
 */
-bool shrink_factor(
-    FactoredTransitionSystem &fts,
-    int index,
+static bool is_shrinking_triggered(
+    const TransitionSystem &ts,
     int new_size,
     int shrink_threshold_before_merge,
-    const ShrinkStrategy &shrink_strategy,
     Verbosity verbosity) {
-    /*
-      TODO: think about factoring out common logic of this function and the
-      function copy_and_shrink_ts in merge_scoring_function_miasm_utils.cc.
-    */
-    const TransitionSystem &ts = fts.get_ts(index);
     int num_states = ts.get_size();
     if (num_states > min(new_size, shrink_threshold_before_merge)) {
         if (verbosity >= Verbosity::VERBOSE) {
@@ -82,13 +77,7 @@ bool shrink_factor(
                 cout << " (shrink threshold: " << shrink_threshold_before_merge;
             cout << ")" << endl;
         }
-
-        const Distances &distances = fts.get_distances(index);
-        StateEquivalenceRelation equivalence_relation =
-            shrink_strategy.compute_equivalence_relation(ts, distances, new_size);
-        // TODO: We currently violate this; see issue250
-        //assert(equivalence_relation.size() <= target_size);
-        return fts.apply_abstraction(index, equivalence_relation, verbosity);
+        return true;
     }
     return false;
 }
@@ -101,6 +90,7 @@ bool shrink_before_merge_step(
     int max_states_before_merge,
     int shrink_threshold_before_merge,
     const ShrinkStrategy &shrink_strategy,
+    utils::ThreadPool &thread_pool,
     Verbosity verbosity) {
     /*
       Compute the size limit for both transition systems as imposed by
@@ -111,6 +101,8 @@ bool shrink_before_merge_step(
         fts.get_ts(index2).get_size(),
         max_states_before_merge,
         max_states);
+    const vector<int> indices = {index1, index2};
+    const vector<int> target_sizes = {new_sizes.first, new_sizes.second};
 
     /*
       For both transition systems, possibly compute and apply an
@@ -119,27 +111,54 @@ bool shrink_before_merge_step(
       for the second shrinking if the first shrinking was larger than
       required.
     */
-    bool shrunk1 = shrink_factor(
-        fts,
-        index1,
-        new_sizes.first,
-        shrink_threshold_before_merge,
-        shrink_strategy,
-        verbosity);
-    if (verbosity >= Verbosity::VERBOSE && shrunk1) {
-        fts.statistics(index1);
+    vector<int> triggered(2);
+    for (int i = 0; i < 2; ++i) {
+        triggered[i] = is_shrinking_triggered(
+            fts.get_ts(indices[i]), target_sizes[i],
+            shrink_threshold_before_merge, verbosity);
     }
-    bool shrunk2 = shrink_factor(
-        fts,
-        index2,
-        new_sizes.second,
-        shrink_threshold_before_merge,
-        shrink_strategy,
-        verbosity);
-    if (verbosity >= Verbosity::VERBOSE && shrunk2) {
-        fts.statistics(index2);
+
+    /*
+      The abstractions of the two factors do not depend on each other, so
+      we compute them concurrently if possible and apply them in order.
+      Output of concurrent computations would interleave, so they run
+      silently.
+    */
+    bool concurrent = thread_pool.get_num_threads() > 1 &&
+                      triggered[0] && triggered[1] &&
+                      shrink_strategy.supports_concurrent_use();
+    vector<StateEquivalenceRelation> equivalence_relations(2);
+    function<void(int)> compute_equivalence_relation = [&](int i) {
+        if (triggered[i]) {
+            int index = indices[i];
+            equivalence_relations[i] =
+                shrink_strategy.compute_equivalence_relation(
+                    fts.get_ts(index), fts.get_distances(index),
+                    target_sizes[i],
+                    concurrent ? Verbosity::SILENT : verbosity);
+        }
+    };
+    if (concurrent) {
+        thread_pool.run(2, compute_equivalence_relation);
+    } else {
+        compute_equivalence_relation(0);
+        compute_equivalence_relation(1);
+    }
+
+    bool shrunk = false;
+    for (int i = 0; i < 2; ++i) {
+        if (!triggered[i])
+            continue;
+        // TODO: We currently violate this; see issue250
+        //assert(equivalence_relations[i].size() <= target_sizes[i]);
+        bool shrunk_factor = fts.apply_abstraction(
+            indices[i], equivalence_relations[i], verbosity);
+        if (verbosity >= Verbosity::VERBOSE && shrunk_factor) {
+            fts.statistics(indices[i]);
+        }
+        shrunk = shrunk || shrunk_factor;
     }
-    return shrunk1 || shrunk2;
+    return shrunk;
 }
 
 bool prune_step(
@@ -6,6 +6,10 @@
 #include <memory>
 #include <vector>
 
+namespace utils {
+class ThreadPool;
+}
+
 namespace merge_and_shrink {
 class FactoredTransitionSystem;
 class ShrinkStrategy;
@@ -41,6 +45,9 @@ extern std::pair<int, int> compute_shrink_sizes(
   If shrinking is triggered, apply the abstraction to the two factors
   within the factored transition system. Return true iff at least one of the
   factors was shrunk.
+
+  If the shrink strategy supports it, the abstractions of both factors are
+  computed concurrently in thread_pool.
 */
 extern bool shrink_before_merge_step(
     FactoredTransitionSystem &fts,
@@ -50,6 +57,7 @@ extern bool shrink_before_merge_step(
     int max_states_before_merge,
     int shrink_threshold_before_merge,
     const ShrinkStrategy &shrink_strategy,
+    utils::ThreadPool &thread_pool,
     Verbosity verbosity);
 
 /*
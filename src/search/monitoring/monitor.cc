@@ -7,6 +7,7 @@
 #include <cstdlib>
 
 #include "monitor.h"
+#include "../search_profiler.h"
 #include <spot/parseaut/public.hh>
 #include <spot/twaalgos/hoa.hh>
 #include <utility>
@@ -132,6 +133,8 @@ bool Monitor::is_accepting(uint s) {
 }
 
 pair<bool, bool> Monitor::check_state(StateID parent_id, const GlobalState &global_state) {
+    SearchProfiler::ScopedTimer timer(
+        g_search_profiler, ProfiledComponent::MONITOR_CHECK);
 
 //    cout << "----- Check State ---------" << endl;
 //    cout << "State: "  << global_state.get_id() << " parent: "  << parent_id << endl;
@@ -1,12 +1,15 @@
 #ifndef OPEN_LIST_H
 #define OPEN_LIST_H
 
+#include <cstddef>
 #include <set>
 #include <vector>
 
 #include "evaluation_context.h"
 #include "operator_id.h"
 
+#include "utils/memory_accounting.h"
+
 class StateID;
 
 
@@ -14,6 +17,7 @@ template<class Entry>
 class OpenList {
     bool only_preferred;
     bool insert_deadends;
+    utils::MemoryReporter memory_reporter;
 
 protected:
     /*
@@ -109,6 +113,14 @@ public:
     */
     bool only_contains_preferred_entries() const;
 
+    /*
+      Estimate the number of bytes used by the entries of the open list,
+      which are accounted to the subsystem "open lists". The default
+      implementation returns 0, which is correct for open lists that only
+      combine other open lists.
+    */
+    virtual std::size_t get_num_bytes() const;
+
     /*
       is_dead_end and is_reliable_dead_end return true if the state
       associated with the passed-in evaluation context is deemed a
@@ -138,13 +150,19 @@ using EdgeOpenList = OpenList<EdgeOpenListEntry>;
 template<class Entry>
 OpenList<Entry>::OpenList(bool only_preferred, bool insert_deadends)
     : only_preferred(only_preferred),
-      insert_deadends(insert_deadends) {
+      insert_deadends(insert_deadends),
+      memory_reporter("open lists", [this]() {return get_num_bytes();}) {
 }
 
 template<class Entry>
 void OpenList<Entry>::boost_preferred() {
 }
 
+template<class Entry>
+std::size_t OpenList<Entry>::get_num_bytes() const {
+    return 0;
+}
+
 template<class Entry>
 void OpenList<Entry>::insert(
     EvaluationContext &eval_context, const Entry &entry) {
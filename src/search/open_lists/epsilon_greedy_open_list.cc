@@ -57,6 +57,7 @@ public:
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
     virtual bool empty() const override;
     virtual void clear() override;
+    virtual size_t get_num_bytes() const override;
 };
 
 template<class HeapNode>
@@ -136,6 +137,11 @@ void EpsilonGreedyOpenList<Entry>::clear() {
     next_id = 0;
 }
 
+template<class Entry>
+size_t EpsilonGreedyOpenList<Entry>::get_num_bytes() const {
+    return heap.capacity() * sizeof(HeapNode);
+}
+
 EpsilonGreedyOpenListFactory::EpsilonGreedyOpenListFactory(
     const Options &options)
     : options(options) {
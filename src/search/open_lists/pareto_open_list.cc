@@ -7,6 +7,7 @@
 
 #include "../utils/hash.h"
 #include "../utils/memory.h"
+#include "../utils/memory_accounting.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
@@ -50,6 +51,7 @@ public:
     virtual Entry remove_min() override;
     virtual bool empty() const override;
     virtual void clear() override;
+    virtual size_t get_num_bytes() const override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
     virtual bool is_dead_end(
         EvaluationContext &eval_context) const override;
@@ -190,6 +192,21 @@ void ParetoOpenList<Entry>::clear() {
     nondominated.clear();
 }
 
+template<class Entry>
+size_t ParetoOpenList<Entry>::get_num_bytes() const {
+    size_t num_bytes = buckets.bucket_count() * sizeof(void *);
+    for (const auto &key_and_bucket : buckets) {
+        // Hash nodes store the next pointer and the hash value.
+        num_bytes += sizeof(typename BucketMap::value_type) + 2 * sizeof(void *) +
+            key_and_bucket.first.capacity() * sizeof(int) +
+            utils::estimate_deque_bytes<Entry>(key_and_bucket.second.size());
+    }
+    num_bytes += nondominated.size() * (
+        utils::estimate_tree_node_bytes<KeyType>() +
+        evaluators.size() * sizeof(int));
+    return num_bytes;
+}
+
 template<class Entry>
 void ParetoOpenList<Entry>::get_path_dependent_evaluators(
     set<Evaluator *> &evals) {
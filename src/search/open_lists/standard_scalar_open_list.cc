@@ -6,6 +6,7 @@
 #include "../plugin.h"
 
 #include "../utils/memory.h"
+#include "../utils/memory_accounting.h"
 
 #include <cassert>
 #include <deque>
@@ -35,6 +36,7 @@ public:
     virtual Entry remove_min() override;
     virtual bool empty() const override;
     virtual void clear() override;
+    virtual size_t get_num_bytes() const override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
     virtual bool is_dead_end(
         EvaluationContext &eval_context) const override;
@@ -92,6 +94,13 @@ void StandardScalarOpenList<Entry>::clear() {
     size = 0;
 }
 
+template<class Entry>
+size_t StandardScalarOpenList<Entry>::get_num_bytes() const {
+    return buckets.size() * (
+        utils::estimate_tree_node_bytes<typename map<int, Bucket>::value_type>() +
+        utils::estimate_deque_bytes<Entry>(0)) + size * sizeof(Entry);
+}
+
 template<class Entry>
 void StandardScalarOpenList<Entry>::get_path_dependent_evaluators(
     set<Evaluator *> &evals) {
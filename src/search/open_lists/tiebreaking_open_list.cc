@@ -6,6 +6,7 @@
 #include "../plugin.h"
 
 #include "../utils/memory.h"
+#include "../utils/memory_accounting.h"
 
 #include <cassert>
 #include <deque>
@@ -44,6 +45,7 @@ public:
     virtual Entry remove_min() override;
     virtual bool empty() const override;
     virtual void clear() override;
+    virtual size_t get_num_bytes() const override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
     virtual bool is_dead_end(
         EvaluationContext &eval_context) const override;
@@ -97,6 +99,15 @@ void TieBreakingOpenList<Entry>::clear() {
     size = 0;
 }
 
+template<class Entry>
+size_t TieBreakingOpenList<Entry>::get_num_bytes() const {
+    using BucketMap = map<const vector<int>, Bucket>;
+    return buckets.size() * (
+        utils::estimate_tree_node_bytes<typename BucketMap::value_type>() +
+        dimension() * sizeof(int) +
+        utils::estimate_deque_bytes<Entry>(0)) + size * sizeof(Entry);
+}
+
 template<class Entry>
 int TieBreakingOpenList<Entry>::dimension() const {
     return evaluators.size();
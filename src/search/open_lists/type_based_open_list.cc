@@ -40,6 +40,7 @@ public:
     virtual Entry remove_min() override;
     virtual bool empty() const override;
     virtual void clear() override;
+    virtual size_t get_num_bytes() const override;
     virtual bool is_dead_end(EvaluationContext &eval_context) const override;
     virtual bool is_reliable_dead_end(
         EvaluationContext &eval_context) const override;
@@ -102,6 +103,22 @@ void TypeBasedOpenList<Entry>::clear() {
     key_to_bucket_index.clear();
 }
 
+template<class Entry>
+size_t TypeBasedOpenList<Entry>::get_num_bytes() const {
+    size_t num_bytes = keys_and_buckets.capacity() * sizeof(pair<Key, Bucket>);
+    for (const auto &key_and_bucket : keys_and_buckets) {
+        // Each key is stored twice, here and in key_to_bucket_index.
+        num_bytes += 2 * key_and_bucket.first.capacity() * sizeof(int) +
+            key_and_bucket.second.capacity() * sizeof(Entry);
+    }
+    // Hash nodes store the next pointer and the hash value.
+    num_bytes += key_to_bucket_index.bucket_count() * sizeof(void *) +
+        key_to_bucket_index.size() * (
+            sizeof(typename unordered_map<Key, int>::value_type) +
+            2 * sizeof(void *));
+    return num_bytes;
+}
+
 template<class Entry>
 bool TypeBasedOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
@@ -27,7 +27,7 @@ void LMCutConstraints::initialize_constraints(
 bool LMCutConstraints::update_constraints(const State &state,
                                           lp::LPSolver &lp_solver) {
     assert(landmark_generator);
-    vector<lp::LPConstraint> constraints;
+    constraints.clear();
     double infinity = lp_solver.get_infinity();
 
     bool dead_end = landmark_generator->compute_landmarks(
@@ -3,7 +3,10 @@
 
 #include  "constraint_generator.h"
 
+#include "../lp/lp_solver.h"
+
 #include <memory>
+#include <vector>
 
 namespace lm_cut_heuristic {
 class LandmarkCutLandmarks;
@@ -12,6 +15,8 @@ class LandmarkCutLandmarks;
 namespace operator_counting {
 class LMCutConstraints : public ConstraintGenerator {
     std::unique_ptr<lm_cut_heuristic::LandmarkCutLandmarks> landmark_generator;
+    // Reused for all states to avoid reallocating the vector.
+    std::vector<lp::LPConstraint> constraints;
 public:
     virtual void initialize_constraints(
         const std::shared_ptr<AbstractTask> &task,
@@ -2,10 +2,12 @@
 
 #include "constraint_generator.h"
 
+#include "../global_state.h"
 #include "../option_parser.h"
 #include "../plugin.h"
 
 #include "../utils/markup.h"
+#include "../utils/memory.h"
 
 #include <cmath>
 
@@ -16,7 +18,10 @@ OperatorCountingHeuristic::OperatorCountingHeuristic(const Options &opts)
     : Heuristic(opts),
       constraint_generators(
           opts.get_list<shared_ptr<ConstraintGenerator>>("constraint_generators")),
-      lp_solver(lp::LPSolverType(opts.get_enum("lpsolver"))) {
+      lp_solver(lp::LPSolverType(opts.get_enum("lpsolver"))),
+      use_warm_starts(opts.get<bool>("warm_starts")),
+      bases("LP bases"),
+      last_child_id(StateID::no_state) {
     vector<lp::LPVariable> variables;
     double infinity = lp_solver.get_infinity();
     for (OperatorProxy op : task_proxy.get_operators()) {
@@ -33,12 +38,33 @@ OperatorCountingHeuristic::OperatorCountingHeuristic(const Options &opts)
 OperatorCountingHeuristic::~OperatorCountingHeuristic() {
 }
 
-int OperatorCountingHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
-    return compute_heuristic(state);
+void OperatorCountingHeuristic::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    // We only need to know the parents of states for warm starts.
+    if (use_warm_starts)
+        evals.insert(this);
+}
+
+void OperatorCountingHeuristic::notify_initial_state(const GlobalState &) {
+    // The states of a previous search may belong to a destroyed registry.
+    last_parent = nullptr;
+    last_child_id = StateID::no_state;
+}
+
+void OperatorCountingHeuristic::notify_state_transition(
+    const GlobalState &parent_state, OperatorID, const GlobalState &state) {
+    if (!last_parent || last_parent->get_id() != parent_state.get_id()) {
+        if (last_parent) {
+            bases[*last_parent] = nullptr;
+        }
+        last_parent = utils::make_unique_ptr<GlobalState>(parent_state);
+    }
+    last_child_id = state.get_id();
 }
 
-int OperatorCountingHeuristic::compute_heuristic(const State &state) {
+int OperatorCountingHeuristic::compute_heuristic(const GlobalState &global_state) {
+    State state = convert_global_state(global_state);
+    StateID state_id = global_state.get_id();
     assert(!lp_solver.has_temporary_constraints());
     for (const auto &generator : constraint_generators) {
         bool dead_end = generator->update_constraints(state, lp_solver);
@@ -47,12 +73,21 @@ int OperatorCountingHeuristic::compute_heuristic(const State &state) {
             return DEAD_END;
         }
     }
+    if (use_warm_starts && last_parent && state_id == last_child_id) {
+        const shared_ptr<const lp::LPBasis> &parent_basis = bases[*last_parent];
+        if (parent_basis) {
+            lp_solver.set_basis(*parent_basis);
+        }
+    }
     int result;
     lp_solver.solve();
     if (lp_solver.has_optimal_solution()) {
         double epsilon = 0.01;
         double objective_value = lp_solver.get_objective_value();
         result = ceil(objective_value - epsilon);
+        if (use_warm_starts) {
+            bases[global_state] = lp_solver.get_basis();
+        }
     } else {
         result = DEAD_END;
     }
@@ -60,6 +95,10 @@ int OperatorCountingHeuristic::compute_heuristic(const State &state) {
     return result;
 }
 
+void OperatorCountingHeuristic::print_evaluator_statistics() const {
+    lp_solver.print_statistics();
+}
+
 static Heuristic *_parse(OptionParser &parser) {
     parser.document_synopsis(
         "Operator counting heuristic",
@@ -96,11 +135,26 @@ static Heuristic *_parse(OptionParser &parser) {
     parser.document_property("safe", "yes");
     // TODO: prefer operators that are non-zero in the solution.
     parser.document_property("preferred operators", "no");
+    parser.document_note(
+        "Warm starts",
+        "With ``warm_starts=true``, the LP basis of each evaluated state "
+        "is stored until the state is expanded and the LPs of its successors "
+        "are solved starting from this basis. The heuristic values are not "
+        "affected. The bases of all generated but unexpanded states are kept "
+        "in memory, which needs about two bits per operator and constraint "
+        "for every open state. Since the heuristic then depends on the "
+        "parents of the states, it cannot be used with parallel_astar or "
+        "as one of the parallel_evaluators.");
 
 
     parser.add_list_option<shared_ptr<ConstraintGenerator>>(
         "constraint_generators",
         "methods that generate constraints over operator counting variables");
+    parser.add_option<bool>(
+        "warm_starts",
+        "solve the LPs of successor states starting from the basis of the "
+        "LP of their parent",
+        "false");
     lp::add_lp_solver_option_to_parser(parser);
     Heuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
@@ -2,6 +2,8 @@
 #define OPERATOR_COUNTING_OPERATOR_COUNTING_HEURISTIC_H
 
 #include "../heuristic.h"
+#include "../per_state_information.h"
+#include "../state_id.h"
 
 #include "../lp/lp_solver.h"
 
@@ -18,12 +20,32 @@ class ConstraintGenerator;
 class OperatorCountingHeuristic : public Heuristic {
     std::vector<std::shared_ptr<ConstraintGenerator>> constraint_generators;
     lp::LPSolver lp_solver;
+    /*
+      If warm starts are enabled, we store the LP basis of each evaluated
+      state and start solving the LP of a successor from the basis of its
+      parent. The parent is known from the last state transition of the
+      current search (it is reset when a search notifies its initial state).
+      Search engines expand one state at a time, so once the transitions
+      come from a new parent, the previous parent is expanded and we drop
+      its basis. Hence, we usually only keep the bases of unexpanded states.
+    */
+    const bool use_warm_starts;
+    PerStateInformation<std::shared_ptr<const lp::LPBasis>> bases;
+    std::unique_ptr<GlobalState> last_parent;
+    StateID last_child_id;
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
-    int compute_heuristic(const State &state);
 public:
     explicit OperatorCountingHeuristic(const options::Options &opts);
     ~OperatorCountingHeuristic();
+
+    virtual void get_path_dependent_evaluators(
+        std::set<Evaluator *> &evals) override;
+    virtual void notify_initial_state(const GlobalState &initial_state) override;
+    virtual void notify_state_transition(
+        const GlobalState &parent_state, OperatorID op_id,
+        const GlobalState &state) override;
+    virtual void print_evaluator_statistics() const override;
 };
 }
 
@@ -444,6 +444,7 @@ Options OptionParser::parse() {
         last_key = tree_it->key;
     }
     opts.set_unparsed_config(get_unparsed_config());
+    opts.set_parse_tree(parse_tree);
     return opts;
 }
 
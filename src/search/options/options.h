@@ -2,6 +2,7 @@
 #define OPTIONS_OPTIONS_H
 
 #include "any.h"
+#include "parse_tree.h"
 #include "type_namer.h"
 
 #include "../utils/system.h"
@@ -15,6 +16,7 @@ namespace options {
 class Options {
     std::unordered_map<std::string, Any> storage;
     std::string unparsed_config;
+    ParseTree parse_tree;
     const bool help_mode;
 
 public:
@@ -89,6 +91,15 @@ public:
     void set_unparsed_config(const std::string &config) {
         unparsed_config = config;
     }
+
+    // Configuration from which the options were parsed (empty if unknown).
+    const ParseTree &get_parse_tree() const {
+        return parse_tree;
+    }
+
+    void set_parse_tree(const ParseTree &tree) {
+        parse_tree = tree;
+    }
 };
 }
 
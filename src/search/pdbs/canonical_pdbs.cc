@@ -2,36 +2,40 @@
 
 #include "pattern_database.h"
 
-#include <algorithm>
 #include <cassert>
-#include <iostream>
-#include <limits>
+#include <unordered_set>
 
 using namespace std;
 
 namespace pdbs {
 CanonicalPDBs::CanonicalPDBs(
     const shared_ptr<MaxAdditivePDBSubsets> &max_additive_subsets_)
-    : max_additive_subsets(max_additive_subsets_) {
+    : max_additive_subsets(max_additive_subsets_),
+      lookup(*max_additive_subsets) {
     assert(max_additive_subsets);
 }
 
 int CanonicalPDBs::get_value(const State &state) const {
     // If we have an empty collection, then max_additive_subsets = { \emptyset }.
     assert(!max_additive_subsets->empty());
-    int max_h = 0;
-    for (const auto &subset : *max_additive_subsets) {
-        int subset_h = 0;
+    return lookup.get_value(state);
+}
+
+void CanonicalPDBs::get_values(
+    const vector<State> &states, vector<int> &values) const {
+    lookup.get_values(states, values);
+}
+
+size_t CanonicalPDBs::get_num_bytes() const {
+    unordered_set<const PatternDatabase *> counted_pdbs;
+    size_t num_bytes = 0;
+    for (const PDBCollection &subset : *max_additive_subsets) {
         for (const shared_ptr<PatternDatabase> &pdb : subset) {
-            /* Experiments showed that it is faster to recompute the
-               h values than to cache them in an unordered_map. */
-            int h = pdb->get_value(state);
-            if (h == numeric_limits<int>::max())
-                return numeric_limits<int>::max();
-            subset_h += h;
+            if (counted_pdbs.insert(pdb.get()).second) {
+                num_bytes += pdb->get_num_bytes();
+            }
         }
-        max_h = max(max_h, subset_h);
     }
-    return max_h;
+    return num_bytes;
 }
 }
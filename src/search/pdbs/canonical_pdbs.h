@@ -1,15 +1,19 @@
 #ifndef PDBS_CANONICAL_PDBS_H
 #define PDBS_CANONICAL_PDBS_H
 
+#include "pdb_lookup.h"
 #include "types.h"
 
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 class State;
 
 namespace pdbs {
 class CanonicalPDBs {
     std::shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets;
+    PDBLookup lookup;
 
 public:
     explicit CanonicalPDBs(
@@ -17,6 +21,11 @@ public:
     ~CanonicalPDBs() = default;
 
     int get_value(const State &state) const;
+    void get_values(
+        const std::vector<State> &states, std::vector<int> &values) const;
+
+    // Number of bytes of the PDBs. PDBs in several subsets are counted once.
+    std::size_t get_num_bytes() const;
 };
 }
 
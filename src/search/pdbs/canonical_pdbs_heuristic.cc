@@ -38,7 +38,10 @@ CanonicalPDBs get_canonical_pdbs_from_options(
 
 CanonicalPDBsHeuristic::CanonicalPDBsHeuristic(const Options &opts)
     : Heuristic(opts),
-      canonical_pdbs(get_canonical_pdbs_from_options(task, opts)) {
+      canonical_pdbs(get_canonical_pdbs_from_options(task, opts)),
+      memory_reporter(
+          "pattern databases",
+          [this]() {return canonical_pdbs.get_num_bytes();}) {
 }
 
 int CanonicalPDBsHeuristic::compute_heuristic(const GlobalState &global_state) {
@@ -5,6 +5,8 @@
 
 #include "../heuristic.h"
 
+#include "../utils/memory_accounting.h"
+
 namespace options {
 class OptionParser;
 }
@@ -13,6 +15,7 @@ namespace pdbs {
 // Implements the canonical heuristic function.
 class CanonicalPDBsHeuristic : public Heuristic {
     CanonicalPDBs canonical_pdbs;
+    utils::MemoryReporter memory_reporter;
 
 protected:
     virtual int compute_heuristic(const GlobalState &state) override;
@@ -0,0 +1,101 @@
+#include "distance_table.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace pdbs {
+const int DistanceTable::BITS_PER_WORD;
+const int DistanceTable::DEAD_END;
+
+static int compute_bits(int max_code) {
+    for (int bits = 1; bits < 32; bits *= 2) {
+        if (static_cast<uint64_t>(max_code) < (uint64_t(1) << bits)) {
+            return bits;
+        }
+    }
+    return 32;
+}
+
+static uint32_t compute_mask(int bits) {
+    return bits == 32 ? numeric_limits<uint32_t>::max() : (uint32_t(1) << bits) - 1;
+}
+
+DistanceTable::DistanceTable()
+    : num_entries(0),
+      bits(1),
+      base(0),
+      mask(compute_mask(1)),
+      words(nullptr) {
+}
+
+DistanceTable::DistanceTable(const vector<int> &distances)
+    : num_entries(distances.size()),
+      base(0) {
+    int min_finite = DEAD_END;
+    int max_finite = -1;
+    for (int distance : distances) {
+        if (distance != DEAD_END) {
+            assert(distance >= 0);
+            min_finite = min(min_finite, distance);
+            max_finite = max(max_finite, distance);
+        }
+    }
+    if (max_finite >= 0) {
+        base = min_finite;
+    }
+    // The largest code is reserved for dead ends.
+    bits = compute_bits(max_finite >= 0 ? max_finite - base + 1 : 1);
+    mask = compute_mask(bits);
+    owned_words.assign(compute_num_words(num_entries, bits), 0);
+    for (size_t i = 0; i < num_entries; ++i) {
+        Word code = distances[i] == DEAD_END ? mask : distances[i] - base;
+        size_t bit = i * bits;
+        owned_words[bit / BITS_PER_WORD] |= code << (bit % BITS_PER_WORD);
+    }
+    words = owned_words.data();
+}
+
+DistanceTable::DistanceTable(
+    size_t num_entries, int bits, int base, const uint32_t *data,
+    const shared_ptr<const void> &storage)
+    : num_entries(num_entries),
+      bits(bits),
+      base(base),
+      mask(compute_mask(bits)),
+      words(data),
+      external_storage(storage) {
+    assert(bits == 1 || bits == 2 || bits == 4 || bits == 8 ||
+           bits == 16 || bits == 32);
+}
+
+DistanceTable::DistanceTable(DistanceTable &&other)
+    : num_entries(other.num_entries),
+      bits(other.bits),
+      base(other.base),
+      mask(other.mask),
+      owned_words(move(other.owned_words)),
+      words(other.external_storage ? other.words : owned_words.data()),
+      external_storage(move(other.external_storage)) {
+    other.words = nullptr;
+    other.num_entries = 0;
+}
+
+DistanceTable &DistanceTable::operator=(DistanceTable &&other) {
+    num_entries = other.num_entries;
+    bits = other.bits;
+    base = other.base;
+    mask = other.mask;
+    owned_words = move(other.owned_words);
+    words = other.external_storage ? other.words : owned_words.data();
+    external_storage = move(other.external_storage);
+    other.words = nullptr;
+    other.num_entries = 0;
+    return *this;
+}
+
+size_t DistanceTable::compute_num_words(size_t num_entries, int bits) {
+    return (num_entries * bits + BITS_PER_WORD - 1) / BITS_PER_WORD;
+}
+}
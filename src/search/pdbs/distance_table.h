@@ -0,0 +1,89 @@
+#ifndef PDBS_DISTANCE_TABLE_H
+#define PDBS_DISTANCE_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace pdbs {
+/*
+  Compact storage for the goal distances of all abstract states of a PDB.
+
+  All finite distances are stored relative to the smallest finite distance
+  (base) using the smallest bit width out of {1, 2, 4, 8, 16, 32} that can
+  represent the largest such offset plus one additional code. The
+  additional code (all bits set) marks dead ends. Since the widths divide
+  32, no entry spans two words and a lookup is one load, one shift and one
+  mask. For the typical PDB with distances below 15 this uses 4 bits per
+  abstract state instead of 32.
+
+  The words are either owned by the table or live in external memory (e.g.
+  a memory-mapped PDB file) that is kept alive by the table.
+*/
+class DistanceTable {
+    using Word = std::uint32_t;
+    static const int BITS_PER_WORD = 32;
+
+    std::size_t num_entries;
+    int bits;
+    int base;
+    Word mask;
+    std::vector<Word> owned_words;
+    const Word *words;
+    std::shared_ptr<const void> external_storage;
+public:
+    static const int DEAD_END = std::numeric_limits<int>::max();
+
+    DistanceTable();
+    // Compresses the given distances (dead ends are DEAD_END).
+    explicit DistanceTable(const std::vector<int> &distances);
+    /*
+      Uses num_words(num_entries, bits) words starting at data. storage
+      is kept alive as long as the table exists.
+    */
+    DistanceTable(std::size_t num_entries, int bits, int base,
+                  const std::uint32_t *data,
+                  const std::shared_ptr<const void> &storage);
+
+    DistanceTable(DistanceTable &&other);
+    DistanceTable &operator=(DistanceTable &&other);
+    DistanceTable(const DistanceTable &) = delete;
+    DistanceTable &operator=(const DistanceTable &) = delete;
+
+    int get(std::size_t index) const {
+        std::size_t bit = index * bits;
+        Word code = (words[bit / BITS_PER_WORD] >> (bit % BITS_PER_WORD)) & mask;
+        return code == mask ? DEAD_END : base + static_cast<int>(code);
+    }
+
+    std::size_t size() const {
+        return num_entries;
+    }
+
+    int get_bits() const {
+        return bits;
+    }
+
+    int get_base() const {
+        return base;
+    }
+
+    const std::uint32_t *get_words() const {
+        return words;
+    }
+
+    std::size_t get_num_words() const {
+        return compute_num_words(num_entries, bits);
+    }
+
+    std::size_t get_memory_in_bytes() const {
+        return owned_words.capacity() * sizeof(Word);
+    }
+
+    static std::size_t compute_num_words(std::size_t num_entries, int bits);
+};
+}
+
+#endif
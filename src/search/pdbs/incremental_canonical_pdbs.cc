@@ -3,6 +3,7 @@
 #include "canonical_pdbs.h"
 #include "pattern_database.h"
 
+#include "../utils/memory.h"
 #include "../utils/timer.h"
 
 #include <iostream>
@@ -43,6 +44,7 @@ void IncrementalCanonicalPDBs::add_pdb(const shared_ptr<PatternDatabase> &pdb) {
 void IncrementalCanonicalPDBs::recompute_max_additive_subsets() {
     max_additive_subsets = compute_max_additive_subsets(*pattern_databases,
                                                         are_additive);
+    canonical_pdbs = utils::make_unique_ptr<CanonicalPDBs>(max_additive_subsets);
 }
 
 MaxAdditivePDBSubsets IncrementalCanonicalPDBs::get_max_additive_subsets(
@@ -52,8 +54,12 @@ MaxAdditivePDBSubsets IncrementalCanonicalPDBs::get_max_additive_subsets(
 }
 
 int IncrementalCanonicalPDBs::get_value(const State &state) const {
-    CanonicalPDBs canonical_pdbs(max_additive_subsets);
-    return canonical_pdbs.get_value(state);
+    return canonical_pdbs->get_value(state);
+}
+
+void IncrementalCanonicalPDBs::get_values(
+    const vector<State> &states, vector<int> &values) const {
+    canonical_pdbs->get_values(states, values);
 }
 
 bool IncrementalCanonicalPDBs::is_dead_end(const State &state) const {
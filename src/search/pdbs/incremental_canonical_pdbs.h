@@ -1,6 +1,7 @@
 #ifndef PDBS_INCREMENTAL_CANONICAL_PDBS_H
 #define PDBS_INCREMENTAL_CANONICAL_PDBS_H
 
+#include "canonical_pdbs.h"
 #include "max_additive_pdb_sets.h"
 #include "pattern_collection_information.h"
 #include "types.h"
@@ -8,6 +9,7 @@
 #include "../task_proxy.h"
 
 #include <memory>
+#include <vector>
 
 namespace pdbs {
 class IncrementalCanonicalPDBs {
@@ -16,6 +18,8 @@ class IncrementalCanonicalPDBs {
     std::shared_ptr<PatternCollection> patterns;
     std::shared_ptr<PDBCollection> pattern_databases;
     std::shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets;
+    // Evaluates max_additive_subsets.
+    std::unique_ptr<CanonicalPDBs> canonical_pdbs;
 
     // A pair of variables is additive if no operator has an effect on both.
     VariableAdditivity are_additive;
@@ -40,6 +44,8 @@ public:
     MaxAdditivePDBSubsets get_max_additive_subsets(const Pattern &new_pattern);
 
     int get_value(const State &state) const;
+    void get_values(
+        const std::vector<State> &states, std::vector<int> &values) const;
 
     /*
       The following method offers a quick dead-end check for the sampling
@@ -0,0 +1,114 @@
+#include "pattern_collection_generator_cached.h"
+
+#include "pattern_database.h"
+#include "pdb_file.h"
+
+#include "../option_parser.h"
+#include "../plugin.h"
+#include "../task_proxy.h"
+
+#include "../utils/hash.h"
+#include "../utils/timer.h"
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+using namespace std;
+
+namespace pdbs {
+static const string DEFAULT_GENERATOR = "systematic(1)";
+
+/*
+  Hash the configuration of the generator as given on the command line, so
+  that files written by other generators are not reused. Equivalent
+  configurations that are written differently get different fingerprints,
+  which only causes the PDBs to be recomputed.
+*/
+static uint64_t compute_generator_fingerprint(const Options &opts) {
+    const options::ParseTree &parse_tree = opts.get_parse_tree();
+    string config = DEFAULT_GENERATOR;
+    int position = 0;
+    for (auto it = options::first_child_of_root(parse_tree);
+         it != options::end_of_roots_children(parse_tree); ++it, ++position) {
+        if (it->key == "generator" || (it->key.empty() && position == 0)) {
+            ostringstream stream;
+            kptree::print_tree_bracketed<options::ParseNode>(
+                options::subtree(parse_tree, it), stream);
+            config = stream.str();
+        }
+    }
+    utils::HashState hash_state;
+    for (char c : config) {
+        utils::feed(hash_state, static_cast<int>(c));
+    }
+    return hash_state.get_hash64();
+}
+
+PatternCollectionGeneratorCached::PatternCollectionGeneratorCached(
+    const Options &opts)
+    : generator(opts.get<shared_ptr<PatternCollectionGenerator>>("generator")),
+      generator_fingerprint(compute_generator_fingerprint(opts)),
+      filename(opts.get<string>("file")) {
+}
+
+PatternCollectionInformation PatternCollectionGeneratorCached::generate(
+    const shared_ptr<AbstractTask> &task) {
+    utils::Timer timer;
+    TaskProxy task_proxy(*task);
+    shared_ptr<PDBCollection> pdbs = load_pdbs(
+        filename, task_proxy, generator_fingerprint);
+    if (pdbs) {
+        shared_ptr<PatternCollection> patterns =
+            make_shared<PatternCollection>();
+        patterns->reserve(pdbs->size());
+        for (const shared_ptr<PatternDatabase> &pdb : *pdbs) {
+            patterns->push_back(pdb->get_pattern());
+        }
+        PatternCollectionInformation pattern_collection_info(
+            task_proxy, patterns);
+        pattern_collection_info.set_pdbs(pdbs);
+        cout << "Time for loading PDBs: " << timer << endl;
+        return pattern_collection_info;
+    }
+
+    PatternCollectionInformation pattern_collection_info =
+        generator->generate(task);
+    save_pdbs(filename, task_proxy, generator_fingerprint,
+              *pattern_collection_info.get_pdbs());
+    cout << "Time for computing and saving PDBs: " << timer << endl;
+    return pattern_collection_info;
+}
+
+static shared_ptr<PatternCollectionGenerator> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Cached pattern collection",
+        "Reuses the PDBs stored in a file if the file was written for the "
+        "same task and generator configuration. Otherwise, the PDBs are computed by the given generator "
+        "and written to the file. Loading memory-maps the file, so the "
+        "distance tables are only paged in when they are accessed.");
+    parser.document_note(
+        "Note",
+        "The file records the generator configuration as written on the "
+        "command line, so writing the same generator differently (e.g., "
+        "with explicit default arguments) recomputes the PDBs. Changes of "
+        "predefined objects that the generator refers to by name are not "
+        "detected.");
+    parser.add_option<shared_ptr<PatternCollectionGenerator>>(
+        "generator",
+        "pattern generation method used if the file cannot be loaded",
+        DEFAULT_GENERATOR);
+    parser.add_option<string>(
+        "file",
+        "file that stores the PDBs (note that the command line is converted "
+        "to lower case)");
+
+    Options opts = parser.parse();
+    if (parser.dry_run())
+        return nullptr;
+
+    return make_shared<PatternCollectionGeneratorCached>(opts);
+}
+
+static PluginShared<PatternCollectionGenerator> _plugin("cached_patterns", _parse);
+}
@@ -0,0 +1,27 @@
+#ifndef PDBS_PATTERN_COLLECTION_GENERATOR_CACHED_H
+#define PDBS_PATTERN_COLLECTION_GENERATOR_CACHED_H
+
+#include "pattern_generator.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace pdbs {
+/* Load the PDBs from a file written for the same task and generator
+   configuration or, if there is no such file, run the generator and store
+   its PDBs in the file. */
+class PatternCollectionGeneratorCached : public PatternCollectionGenerator {
+    std::shared_ptr<PatternCollectionGenerator> generator;
+    std::uint64_t generator_fingerprint;
+    std::string filename;
+public:
+    explicit PatternCollectionGeneratorCached(const options::Options &opts);
+    virtual ~PatternCollectionGeneratorCached() = default;
+
+    virtual PatternCollectionInformation generate(
+        const std::shared_ptr<AbstractTask> &task) override;
+};
+}
+
+#endif
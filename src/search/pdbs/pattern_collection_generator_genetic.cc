@@ -12,6 +12,8 @@
 #include "../utils/math.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
+#include "../utils/thread_pool.h"
+#include "../utils/thread_pool_options.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
@@ -30,7 +32,8 @@ PatternCollectionGeneratorGenetic::PatternCollectionGeneratorGenetic(
       num_episodes(opts.get<int>("num_episodes")),
       mutation_probability(opts.get<double>("mutation_probability")),
       disjoint_patterns(opts.get<bool>("disjoint")),
-      rng(utils::parse_rng_from_options(opts)) {
+      rng(utils::parse_rng_from_options(opts)),
+      thread_pool(utils::parse_thread_pool_from_options(opts)) {
 }
 
 void PatternCollectionGeneratorGenetic::select(
@@ -159,10 +162,17 @@ bool PatternCollectionGeneratorGenetic::mark_used_variables(
 
 void PatternCollectionGeneratorGenetic::evaluate(vector<double> &fitness_values) {
     TaskProxy task_proxy(*task);
+    int num_pattern_collections = pattern_collections.size();
+    /*
+      Invalid collections are represented by nullptr. Checking the patterns
+      uses the (lazily computed) causal graph and is hence done up front in
+      the main thread.
+    */
+    vector<shared_ptr<PatternCollection>> candidates;
+    candidates.reserve(num_pattern_collections);
     for (const auto &collection : pattern_collections) {
         //cout << "evaluate pattern collection " << (i + 1) << " of "
         //     << pattern_collections.size() << endl;
-        double fitness = 0;
         bool pattern_valid = true;
         vector<bool> variables_used(task_proxy.get_variables().size(), false);
         shared_ptr<PatternCollection> pattern_collection = make_shared<PatternCollection>();
@@ -187,23 +197,32 @@ void PatternCollectionGeneratorGenetic::evaluate(vector<double> &fitness_values)
             remove_irrelevant_variables(pattern);
             pattern_collection->push_back(pattern);
         }
-        if (!pattern_valid) {
-            /* Set fitness to a very small value to cover cases in which all
-               patterns are invalid. */
-            fitness = 0.001;
-        } else {
-            /* Generate the pattern collection heuristic and get its fitness
-               value. */
-            ZeroOnePDBs zero_one_pdbs(task_proxy, *pattern_collection);
-            fitness = zero_one_pdbs.compute_approx_mean_finite_h();
-            // Update the best heuristic found so far.
-            if (fitness > best_fitness) {
-                best_fitness = fitness;
-                cout << "best_fitness = " << best_fitness << endl;
-                best_patterns = pattern_collection;
+        candidates.push_back(pattern_valid ? pattern_collection : nullptr);
+    }
+
+    /* Set fitness to a very small value to cover cases in which all
+       patterns are invalid. */
+    vector<double> fitness(num_pattern_collections, 0.001);
+    /* Generate the pattern collection heuristics and get their fitness
+       values. The collections are independent, so this is done
+       concurrently. */
+    thread_pool->run(
+        num_pattern_collections,
+        [&](int i) {
+            if (candidates[i]) {
+                ZeroOnePDBs zero_one_pdbs(task_proxy, *candidates[i]);
+                fitness[i] = zero_one_pdbs.compute_approx_mean_finite_h();
             }
+        });
+
+    // Update the best heuristic found so far.
+    for (int i = 0; i < num_pattern_collections; ++i) {
+        if (candidates[i] && fitness[i] > best_fitness) {
+            best_fitness = fitness[i];
+            cout << "best_fitness = " << best_fitness << endl;
+            best_patterns = candidates[i];
         }
-        fitness_values.push_back(fitness);
+        fitness_values.push_back(fitness[i]);
     }
 }
 
@@ -367,6 +386,7 @@ static shared_ptr<PatternCollectionGenerator> _parse(OptionParser &parser) {
         "false");
 
     utils::add_rng_options(parser);
+    utils::add_thread_pool_options(parser);
 
     Options opts = parser.parse();
     if (parser.dry_run())
@@ -15,6 +15,7 @@ class Options;
 
 namespace utils {
 class RandomNumberGenerator;
+class ThreadPool;
 }
 
 namespace pdbs {
@@ -34,6 +35,8 @@ class PatternCollectionGeneratorGenetic : public PatternCollectionGenerator {
        or not. */
     const bool disjoint_patterns;
     std::shared_ptr<utils::RandomNumberGenerator> rng;
+    // Evaluates the pattern collections of the population.
+    std::shared_ptr<utils::ThreadPool> thread_pool;
 
     std::shared_ptr<AbstractTask> task;
 
@@ -19,6 +19,8 @@
 #include "../utils/memory.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
+#include "../utils/thread_pool.h"
+#include "../utils/thread_pool_options.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
@@ -115,6 +117,7 @@ PatternCollectionGeneratorHillclimbing::PatternCollectionGeneratorHillclimbing(c
       min_improvement(opts.get<int>("min_improvement")),
       max_time(opts.get<double>("max_time")),
       rng(utils::parse_rng_from_options(opts)),
+      thread_pool(utils::parse_thread_pool_from_options(opts)),
       num_rejected(0),
       hill_climbing_timer(0) {
 }
@@ -127,7 +130,7 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
     PDBCollection &candidate_pdbs) {
     const Pattern &pattern = pdb.get_pattern();
     int pdb_size = pdb.get_size();
-    int max_pdb_size = 0;
+    PatternCollection new_patterns;
     for (int pattern_var : pattern) {
         assert(utils::in_bounds(pattern_var, relevant_neighbours));
         const vector<int> &connected_vars = relevant_neighbours[pattern_var];
@@ -154,16 +157,21 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
                       surpass the size limit.
                     */
                     generated_patterns.insert(new_pattern);
-                    candidate_pdbs.push_back(
-                        make_shared<PatternDatabase>(task_proxy, new_pattern));
-                    max_pdb_size = max(max_pdb_size,
-                                       candidate_pdbs.back()->get_size());
+                    new_patterns.push_back(move(new_pattern));
                 }
             } else {
                 ++num_rejected;
             }
         }
     }
+
+    // The new candidate PDBs are independent, so we build them concurrently.
+    int max_pdb_size = 0;
+    for (shared_ptr<PatternDatabase> &new_pdb :
+         build_pdbs(task_proxy, new_patterns, *thread_pool)) {
+        max_pdb_size = max(max_pdb_size, new_pdb->get_size());
+        candidate_pdbs.push_back(move(new_pdb));
+    }
     return max_pdb_size;
 }
 
@@ -198,52 +206,67 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
       We require that a pattern must have an improvement of at least one in
       order to be taken into account.
     */
-    int improvement = 0;
-    int best_pdb_index = -1;
-
-    // Iterate over all candidates and search for the best improving pattern/pdb
-    for (size_t i = 0; i < candidate_pdbs.size(); ++i) {
-        if (hill_climbing_timer->is_expired())
-            throw HillClimbingTimeout();
-
-        const shared_ptr<PatternDatabase> &pdb = candidate_pdbs[i];
-        if (!pdb) {
-            /* candidate pattern is too large or has already been added to
-               the canonical heuristic. */
-            continue;
-        }
-        /*
-          If a candidate's size added to the current collection's size exceeds
-          the maximum collection size, then forget the pdb.
-        */
-        int combined_size = current_pdbs->get_size() + pdb->get_size();
-        if (combined_size > collection_max_size) {
-            candidate_pdbs[i] = nullptr;
-            continue;
+    /*
+      If a candidate's size added to the current collection's size exceeds
+      the maximum collection size, then forget the pdb.
+    */
+    for (shared_ptr<PatternDatabase> &pdb : candidate_pdbs) {
+        if (pdb &&
+            current_pdbs->get_size() + pdb->get_size() > collection_max_size) {
+            pdb = nullptr;
         }
+    }
 
-        /*
-          Calculate the "counting approximation" for all sample states: count
-          the number of samples for which the current pattern collection
-          heuristic would be improved if the new pattern was included into it.
-        */
-        /*
-          TODO: The original implementation by Haslum et al. uses m/t as a
-          statistical confidence interval to stop the A*-search (which they use,
-          see above) earlier.
-        */
-        int count = 0;
-        MaxAdditivePDBSubsets max_additive_subsets =
-            current_pdbs->get_max_additive_subsets(pdb->get_pattern());
-        for (int sample_id = 0; sample_id < num_samples; ++sample_id) {
-            const State &sample = samples[sample_id];
-            assert(utils::in_bounds(sample_id, samples_h_values));
-            int h_collection = samples_h_values[sample_id];
-            if (is_heuristic_improved(
-                    *pdb, sample, h_collection, max_additive_subsets)) {
-                ++count;
+    /*
+      The candidates are evaluated concurrently. Every evaluation only reads
+      the current collection and the samples and writes its own count, so
+      the result does not depend on the number of threads.
+    */
+    vector<int> counts(candidate_pdbs.size(), 0);
+    thread_pool->run(
+        candidate_pdbs.size(),
+        [&](int i) {
+            if (hill_climbing_timer->is_expired())
+                throw HillClimbingTimeout();
+
+            const shared_ptr<PatternDatabase> &pdb = candidate_pdbs[i];
+            if (!pdb) {
+                /* candidate pattern is too large or has already been added to
+                   the canonical heuristic. */
+                return;
             }
-        }
+
+            /*
+              Calculate the "counting approximation" for all sample states:
+              count the number of samples for which the current pattern
+              collection heuristic would be improved if the new pattern was
+              included into it.
+            */
+            /*
+              TODO: The original implementation by Haslum et al. uses m/t as a
+              statistical confidence interval to stop the A*-search (which they
+              use, see above) earlier.
+            */
+            int count = 0;
+            MaxAdditivePDBSubsets max_additive_subsets =
+                current_pdbs->get_max_additive_subsets(pdb->get_pattern());
+            for (int sample_id = 0; sample_id < num_samples; ++sample_id) {
+                const State &sample = samples[sample_id];
+                assert(utils::in_bounds(sample_id, samples_h_values));
+                int h_collection = samples_h_values[sample_id];
+                if (is_heuristic_improved(
+                        *pdb, sample, h_collection, max_additive_subsets)) {
+                    ++count;
+                }
+            }
+            counts[i] = count;
+        });
+
+    // Find the best improving pattern/pdb in candidate order.
+    int improvement = 0;
+    int best_pdb_index = -1;
+    for (size_t i = 0; i < candidate_pdbs.size(); ++i) {
+        int count = counts[i];
         if (count > improvement) {
             improvement = count;
             best_pdb_index = i;
@@ -348,9 +371,7 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
             samples_h_values.clear();
             sample_states(
                 task_proxy, successor_generator, samples, average_operator_cost);
-            for (const State &sample : samples) {
-                samples_h_values.push_back(current_pdbs->get_value(sample));
-            }
+            current_pdbs->get_values(samples, samples_h_values);
 
             pair<int, int> improvement_and_index =
                 find_best_improving_pdb(samples, samples_h_values, candidate_pdbs);
@@ -463,6 +484,7 @@ void add_hillclimbing_options(OptionParser &parser) {
         "infinity",
         Bounds("0.0", "infinity"));
     utils::add_rng_options(parser);
+    utils::add_thread_pool_options(parser);
 }
 
 void check_hillclimbing_options(
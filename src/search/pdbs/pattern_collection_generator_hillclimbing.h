@@ -20,6 +20,7 @@ class Options;
 namespace utils {
 class CountdownTimer;
 class RandomNumberGenerator;
+class ThreadPool;
 }
 
 namespace pdbs {
@@ -38,6 +39,8 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
     const int min_improvement;
     const double max_time;
     std::shared_ptr<utils::RandomNumberGenerator> rng;
+    // Builds and evaluates candidate PDBs.
+    std::shared_ptr<utils::ThreadPool> thread_pool;
 
     std::unique_ptr<IncrementalCanonicalPDBs> current_pdbs;
 
@@ -8,6 +8,7 @@
 
 #include "../task_utils/causal_graph.h"
 #include "../utils/markup.h"
+#include "../utils/thread_pool_options.h"
 
 #include <algorithm>
 #include <cassert>
@@ -47,7 +48,8 @@ static void compute_union_pattern(
 PatternCollectionGeneratorSystematic::PatternCollectionGeneratorSystematic(
     const Options &opts)
     : max_pattern_size(opts.get<int>("pattern_max_size")),
-      only_interesting_patterns(opts.get<bool>("only_interesting_patterns")) {
+      only_interesting_patterns(opts.get<bool>("only_interesting_patterns")),
+      thread_pool(utils::parse_thread_pool_from_options(opts)) {
 }
 
 void PatternCollectionGeneratorSystematic::compute_eff_pre_neighbors(
@@ -268,7 +270,9 @@ PatternCollectionInformation PatternCollectionGeneratorSystematic::generate(
     } else {
         build_patterns_naive(task_proxy);
     }
-    return PatternCollectionInformation(task_proxy, patterns);
+    PatternCollectionInformation pattern_collection_info(task_proxy, patterns);
+    pattern_collection_info.set_thread_pool(thread_pool);
+    return pattern_collection_info;
 }
 
 static shared_ptr<PatternCollectionGenerator> _parse(OptionParser &parser) {
@@ -295,6 +299,7 @@ static shared_ptr<PatternCollectionGenerator> _parse(OptionParser &parser) {
         "Only consider the union of two disjoint patterns if the union has "
         "more information than the individual patterns.",
         "true");
+    utils::add_thread_pool_options(parser);
 
     Options opts = parser.parse();
     if (parser.dry_run())
@@ -17,6 +17,10 @@ namespace causal_graph {
 class CausalGraph;
 }
 
+namespace utils {
+class ThreadPool;
+}
+
 namespace options {
 class Options;
 }
@@ -30,6 +34,8 @@ class PatternCollectionGeneratorSystematic : public PatternCollectionGenerator {
 
     const size_t max_pattern_size;
     const bool only_interesting_patterns;
+    // Builds the PDBs of the generated patterns.
+    std::shared_ptr<utils::ThreadPool> thread_pool;
     std::shared_ptr<PatternCollection> patterns;
     PatternSet pattern_set;  // Cleared after pattern computation.
 
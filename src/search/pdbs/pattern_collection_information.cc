@@ -69,7 +69,10 @@ bool PatternCollectionInformation::information_is_valid() const {
 
 void PatternCollectionInformation::create_pdbs_if_missing() {
     assert(patterns);
-    if (!pdbs) {
+    if (!pdbs && thread_pool) {
+        pdbs = make_shared<PDBCollection>(
+            build_pdbs(task_proxy, *patterns, *thread_pool));
+    } else if (!pdbs) {
         pdbs = make_shared<PDBCollection>();
         for (const Pattern &pattern : *patterns) {
             shared_ptr<PatternDatabase> pdb =
@@ -99,6 +102,11 @@ void PatternCollectionInformation::set_max_additive_subsets(
     assert(information_is_valid());
 }
 
+void PatternCollectionInformation::set_thread_pool(
+    const shared_ptr<utils::ThreadPool> &thread_pool_) {
+    thread_pool = thread_pool_;
+}
+
 shared_ptr<PatternCollection> PatternCollectionInformation::get_patterns() {
     assert(patterns);
     return patterns;
@@ -7,6 +7,10 @@
 
 #include <memory>
 
+namespace utils {
+class ThreadPool;
+}
+
 namespace pdbs {
 /*
   This class contains everything we know about a pattern collection. It will
@@ -22,6 +26,8 @@ class PatternCollectionInformation {
     std::shared_ptr<PatternCollection> patterns;
     std::shared_ptr<PDBCollection> pdbs;
     std::shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets;
+    // If set, missing PDBs are built concurrently by this pool.
+    std::shared_ptr<utils::ThreadPool> thread_pool;
 
     void create_pdbs_if_missing();
     void create_max_additive_subsets_if_missing();
@@ -36,6 +42,7 @@ public:
     void set_pdbs(const std::shared_ptr<PDBCollection> &pdbs);
     void set_max_additive_subsets(
         const std::shared_ptr<MaxAdditivePDBSubsets> &max_additive_subsets);
+    void set_thread_pool(const std::shared_ptr<utils::ThreadPool> &thread_pool);
 
     std::shared_ptr<PatternCollection> get_patterns();
     std::shared_ptr<PDBCollection> get_pdbs();
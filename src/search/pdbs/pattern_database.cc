@@ -7,6 +7,7 @@
 #include "../utils/collections.h"
 #include "../utils/logging.h"
 #include "../utils/math.h"
+#include "../utils/thread_pool.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
@@ -14,6 +15,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -79,6 +81,27 @@ PatternDatabase::PatternDatabase(
     assert(utils::is_sorted_unique(pattern));
 
     utils::Timer timer;
+    compute_hash_multipliers(task_proxy);
+    create_pdb(task_proxy, operator_costs);
+    if (dump)
+        cout << "PDB construction time: " << timer << endl;
+}
+
+PatternDatabase::PatternDatabase(
+    const TaskProxy &task_proxy,
+    const Pattern &pattern,
+    DistanceTable &&distances_)
+    : pattern(pattern),
+      distances(move(distances_)) {
+    assert(utils::is_sorted_unique(pattern));
+    compute_hash_multipliers(task_proxy);
+    if (distances.size() != num_states) {
+        cerr << "Stored distances do not match pattern: " << pattern << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+}
+
+void PatternDatabase::compute_hash_multipliers(const TaskProxy &task_proxy) {
     hash_multipliers.reserve(pattern.size());
     num_states = 1;
     for (int pattern_var_id : pattern) {
@@ -93,9 +116,6 @@ PatternDatabase::PatternDatabase(
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
     }
-    create_pdb(task_proxy, operator_costs);
-    if (dump)
-        cout << "PDB construction time: " << timer << endl;
 }
 
 void PatternDatabase::multiply_out(
@@ -224,7 +244,8 @@ void PatternDatabase::create_pdb(
         }
     }
 
-    distances.reserve(num_states);
+    vector<int> state_distances;
+    state_distances.reserve(num_states);
     // first implicit entry: priority, second entry: index for an abstract state
     priority_queues::AdaptiveQueue<size_t> pq;
 
@@ -232,9 +253,9 @@ void PatternDatabase::create_pdb(
     for (size_t state_index = 0; state_index < num_states; ++state_index) {
         if (is_goal_state(state_index, abstract_goals, variables)) {
             pq.push(0, state_index);
-            distances.push_back(0);
+            state_distances.push_back(0);
         } else {
-            distances.push_back(numeric_limits<int>::max());
+            state_distances.push_back(numeric_limits<int>::max());
         }
     }
 
@@ -243,7 +264,7 @@ void PatternDatabase::create_pdb(
         pair<int, size_t> node = pq.pop();
         int distance = node.first;
         size_t state_index = node.second;
-        if (distance > distances[state_index]) {
+        if (distance > state_distances[state_index]) {
             continue;
         }
 
@@ -252,13 +273,14 @@ void PatternDatabase::create_pdb(
         match_tree.get_applicable_operators(state_index, applicable_operators);
         for (const AbstractOperator *op : applicable_operators) {
             size_t predecessor = state_index + op->get_hash_effect();
-            int alternative_cost = distances[state_index] + op->get_cost();
-            if (alternative_cost < distances[predecessor]) {
-                distances[predecessor] = alternative_cost;
+            int alternative_cost = state_distances[state_index] + op->get_cost();
+            if (alternative_cost < state_distances[predecessor]) {
+                state_distances[predecessor] = alternative_cost;
                 pq.push(alternative_cost, predecessor);
             }
         }
     }
+    distances = DistanceTable(state_distances);
 }
 
 bool PatternDatabase::is_goal_state(
@@ -287,15 +309,16 @@ size_t PatternDatabase::hash_index(const State &state) const {
 }
 
 int PatternDatabase::get_value(const State &state) const {
-    return distances[hash_index(state)];
+    return distances.get(hash_index(state));
 }
 
 double PatternDatabase::compute_mean_finite_h() const {
     double sum = 0;
     int size = 0;
     for (size_t i = 0; i < distances.size(); ++i) {
-        if (distances[i] != numeric_limits<int>::max()) {
-            sum += distances[i];
+        int distance = distances.get(i);
+        if (distance != DistanceTable::DEAD_END) {
+            sum += distance;
             ++size;
         }
     }
@@ -315,4 +338,17 @@ bool PatternDatabase::is_operator_relevant(const OperatorProxy &op) const {
     }
     return false;
 }
+
+PDBCollection build_pdbs(
+    const TaskProxy &task_proxy,
+    const PatternCollection &patterns,
+    utils::ThreadPool &thread_pool) {
+    PDBCollection pdbs(patterns.size());
+    thread_pool.run(
+        patterns.size(),
+        [&](int i) {
+            pdbs[i] = make_shared<PatternDatabase>(task_proxy, patterns[i]);
+        });
+    return pdbs;
+}
 }
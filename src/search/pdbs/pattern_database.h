@@ -1,6 +1,7 @@
 #ifndef PDBS_PATTERN_DATABASE_H
 #define PDBS_PATTERN_DATABASE_H
 
+#include "distance_table.h"
 #include "types.h"
 
 #include "../task_proxy.h"
@@ -8,6 +9,10 @@
 #include <utility>
 #include <vector>
 
+namespace utils {
+class ThreadPool;
+}
+
 namespace pdbs {
 class AbstractOperator {
     /*
@@ -80,7 +85,7 @@ class PatternDatabase {
       final h-values for abstract-states.
       dead-ends are represented by numeric_limits<int>::max()
     */
-    std::vector<int> distances;
+    DistanceTable distances;
 
     // multipliers for each variable for perfect hash function
     std::vector<std::size_t> hash_multipliers;
@@ -141,6 +146,8 @@ class PatternDatabase {
       (distances) during search.
     */
     std::size_t hash_index(const State &state) const;
+
+    void compute_hash_multipliers(const TaskProxy &task_proxy);
 public:
     /*
       Important: It is assumed that the pattern (passed via Options) is
@@ -157,6 +164,16 @@ public:
         const Pattern &pattern,
         bool dump = false,
         const std::vector<int> &operator_costs = std::vector<int>());
+    /*
+      Creates a PDB from previously computed distances, e.g. loaded from a
+      PDB file. The distances must have been computed for the same task and
+      pattern.
+    */
+    PatternDatabase(
+        const TaskProxy &task_proxy,
+        const Pattern &pattern,
+        DistanceTable &&distances);
+    PatternDatabase(PatternDatabase &&other) = default;
     ~PatternDatabase() = default;
 
     int get_value(const State &state) const;
@@ -171,6 +188,21 @@ public:
         return num_states;
     }
 
+    const DistanceTable &get_distance_table() const {
+        return distances;
+    }
+
+    // Number of bytes of the distance table and the hash multipliers.
+    std::size_t get_num_bytes() const {
+        return distances.get_num_words() * sizeof(std::uint32_t) +
+               hash_multipliers.capacity() * sizeof(std::size_t);
+    }
+
+    // The rank of a state is the sum of hash_multipliers[i] * state[pattern[i]].
+    const std::vector<std::size_t> &get_hash_multipliers() const {
+        return hash_multipliers;
+    }
+
     /*
       Returns the average h-value over all states, where dead-ends are
       ignored (they neither increase the sum of all h-values nor the
@@ -184,6 +216,16 @@ public:
     // Returns true iff op has an effect on a variable in the pattern.
     bool is_operator_relevant(const OperatorProxy &op) const;
 };
+
+/*
+  Builds the PDBs for the given patterns with the default operator costs.
+  The PDBs are independent of each other and built concurrently by the
+  threads of the given pool. The result is ordered like the patterns.
+*/
+extern PDBCollection build_pdbs(
+    const TaskProxy &task_proxy,
+    const PatternCollection &patterns,
+    utils::ThreadPool &thread_pool);
 }
 
 #endif
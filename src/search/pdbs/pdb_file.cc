@@ -0,0 +1,261 @@
+#include "pdb_file.h"
+
+#include "distance_table.h"
+#include "pattern_database.h"
+
+#include "../task_proxy.h"
+
+#include "../utils/hash.h"
+#include "../utils/math.h"
+#include "../utils/memory_mapped_file.h"
+#include "../utils/system.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+namespace pdbs {
+static const char MAGIC[8] = {'F', 'D', 'P', 'D', 'B', '0', '2', '\0'};
+static const size_t ALIGNMENT = 8;
+
+uint64_t compute_task_fingerprint(const TaskProxy &task_proxy) {
+    utils::HashState hash_state;
+    VariablesProxy variables = task_proxy.get_variables();
+    utils::feed(hash_state, static_cast<int>(variables.size()));
+    for (VariableProxy var : variables) {
+        utils::feed(hash_state, var.get_domain_size());
+    }
+    OperatorsProxy operators = task_proxy.get_operators();
+    utils::feed(hash_state, static_cast<int>(operators.size()));
+    for (OperatorProxy op : operators) {
+        utils::feed(hash_state, op.get_cost());
+        PreconditionsProxy preconditions = op.get_preconditions();
+        utils::feed(hash_state, static_cast<int>(preconditions.size()));
+        for (FactProxy pre : preconditions) {
+            utils::feed(hash_state, pre.get_pair().var);
+            utils::feed(hash_state, pre.get_pair().value);
+        }
+        EffectsProxy effects = op.get_effects();
+        utils::feed(hash_state, static_cast<int>(effects.size()));
+        for (EffectProxy eff : effects) {
+            utils::feed(hash_state, eff.get_fact().get_pair().var);
+            utils::feed(hash_state, eff.get_fact().get_pair().value);
+            utils::feed(hash_state, static_cast<int>(eff.get_conditions().size()));
+        }
+    }
+    GoalsProxy goals = task_proxy.get_goals();
+    utils::feed(hash_state, static_cast<int>(goals.size()));
+    for (FactProxy goal : goals) {
+        utils::feed(hash_state, goal.get_pair().var);
+        utils::feed(hash_state, goal.get_pair().value);
+    }
+    return hash_state.get_hash64();
+}
+
+static void write_padding(ofstream &file) {
+    static const char zeros[ALIGNMENT] = {0};
+    size_t pos = file.tellp();
+    if (pos % ALIGNMENT) {
+        file.write(zeros, ALIGNMENT - pos % ALIGNMENT);
+    }
+}
+
+template<typename T>
+static void write_value(ofstream &file, T value) {
+    file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void save_pdbs(
+    const string &filename,
+    const TaskProxy &task_proxy,
+    uint64_t generator_fingerprint,
+    const PDBCollection &pdbs) {
+    /*
+      The existing file may still be mapped by loaded PDBs, which would
+      crash if we truncated it. Hence, we write a new file and replace the
+      old one, which stays readable through its mappings.
+    */
+    string temporary_filename =
+        filename + ".tmp" + to_string(utils::get_process_id());
+    ofstream file(temporary_filename, ios::binary | ios::trunc);
+    if (!file) {
+        cerr << "Could not write PDB file " << temporary_filename << endl;
+        return;
+    }
+    file.write(MAGIC, sizeof(MAGIC));
+    write_value<uint64_t>(file, compute_task_fingerprint(task_proxy));
+    write_value<uint64_t>(file, generator_fingerprint);
+    write_value<uint64_t>(file, pdbs.size());
+    for (const shared_ptr<PatternDatabase> &pdb : pdbs) {
+        const Pattern &pattern = pdb->get_pattern();
+        write_value<uint64_t>(file, pattern.size());
+        for (int var : pattern) {
+            write_value<int32_t>(file, var);
+        }
+        write_padding(file);
+        const DistanceTable &distances = pdb->get_distance_table();
+        write_value<int32_t>(file, distances.get_bits());
+        write_value<int32_t>(file, distances.get_base());
+        write_value<uint64_t>(file, distances.size());
+        write_value<uint64_t>(file, distances.get_num_words());
+        file.write(reinterpret_cast<const char *>(distances.get_words()),
+                   distances.get_num_words() * sizeof(uint32_t));
+        write_padding(file);
+    }
+    file.close();
+    if (!file) {
+        cerr << "Could not write PDB file " << temporary_filename << endl;
+        remove(temporary_filename.c_str());
+    } else if (rename(temporary_filename.c_str(), filename.c_str()) != 0) {
+        cerr << "Could not replace PDB file " << filename << endl;
+        remove(temporary_filename.c_str());
+    } else {
+        cout << "Saved " << pdbs.size() << " PDBs to " << filename << endl;
+    }
+}
+
+/*
+  Return the number of abstract states of the pattern or -1 if the pattern
+  is not sorted and duplicate-free or has too many abstract states.
+*/
+static int compute_num_abstract_states(
+    const TaskProxy &task_proxy, const Pattern &pattern) {
+    VariablesProxy variables = task_proxy.get_variables();
+    int num_states = 1;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (i > 0 && pattern[i - 1] >= pattern[i]) {
+            return -1;
+        }
+        int domain_size = variables[pattern[i]].get_domain_size();
+        if (!utils::is_product_within_limit(
+                num_states, domain_size, numeric_limits<int>::max())) {
+            return -1;
+        }
+        num_states *= domain_size;
+    }
+    return num_states;
+}
+
+namespace {
+class Reader {
+    const char *data;
+    size_t size;
+    size_t pos;
+public:
+    Reader(const char *data, size_t size)
+        : data(data), size(size), pos(0) {
+    }
+
+    const char *advance(size_t num_bytes) {
+        if (num_bytes > size - pos) {
+            return nullptr;
+        }
+        const char *result = data + pos;
+        pos += num_bytes;
+        return result;
+    }
+
+    template<typename T>
+    bool read(T &value) {
+        const char *bytes = advance(sizeof(T));
+        if (!bytes) {
+            return false;
+        }
+        memcpy(&value, bytes, sizeof(T));
+        return true;
+    }
+
+    bool skip_padding() {
+        if (pos % ALIGNMENT) {
+            return advance(ALIGNMENT - pos % ALIGNMENT) != nullptr;
+        }
+        return true;
+    }
+};
+}
+
+shared_ptr<PDBCollection> load_pdbs(
+    const string &filename,
+    const TaskProxy &task_proxy,
+    uint64_t generator_fingerprint) {
+    shared_ptr<utils::MemoryMappedFile> mapping =
+        make_shared<utils::MemoryMappedFile>();
+    if (!mapping->open(filename)) {
+        return nullptr;
+    }
+    Reader reader(mapping->get_data(), mapping->get_size());
+    const char *magic = reader.advance(sizeof(MAGIC));
+    uint64_t task_fingerprint;
+    uint64_t stored_generator_fingerprint;
+    uint64_t num_pdbs;
+    if (!magic || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !reader.read(task_fingerprint) ||
+        !reader.read(stored_generator_fingerprint) ||
+        !reader.read(num_pdbs)) {
+        cerr << "Malformed PDB file " << filename << endl;
+        return nullptr;
+    }
+    if (task_fingerprint != compute_task_fingerprint(task_proxy)) {
+        cout << "PDB file " << filename << " was created for a different task"
+             << endl;
+        return nullptr;
+    }
+    if (stored_generator_fingerprint != generator_fingerprint) {
+        cout << "PDB file " << filename << " was created by a different "
+             << "pattern generator" << endl;
+        return nullptr;
+    }
+    int num_variables = task_proxy.get_variables().size();
+    shared_ptr<PDBCollection> pdbs = make_shared<PDBCollection>();
+    for (uint64_t i = 0; i < num_pdbs; ++i) {
+        uint64_t pattern_size;
+        if (!reader.read(pattern_size) ||
+            pattern_size > static_cast<uint64_t>(num_variables)) {
+            cerr << "Malformed PDB file " << filename << endl;
+            return nullptr;
+        }
+        Pattern pattern(pattern_size);
+        for (int &var : pattern) {
+            int32_t value;
+            if (!reader.read(value) || value < 0 || value >= num_variables) {
+                cerr << "Malformed PDB file " << filename << endl;
+                return nullptr;
+            }
+            var = value;
+        }
+        int num_abstract_states =
+            compute_num_abstract_states(task_proxy, pattern);
+        int32_t bits;
+        int32_t base;
+        uint64_t num_entries;
+        uint64_t num_words;
+        if (!reader.skip_padding() || !reader.read(bits) ||
+            !reader.read(base) || !reader.read(num_entries) ||
+            !reader.read(num_words) ||
+            (bits != 1 && bits != 2 && bits != 4 && bits != 8 &&
+             bits != 16 && bits != 32) ||
+            num_abstract_states == -1 ||
+            num_entries != static_cast<uint64_t>(num_abstract_states) ||
+            num_words != DistanceTable::compute_num_words(num_entries, bits)) {
+            cerr << "Malformed PDB file " << filename << endl;
+            return nullptr;
+        }
+        const char *words = reader.advance(num_words * sizeof(uint32_t));
+        if (!words || !reader.skip_padding()) {
+            cerr << "Malformed PDB file " << filename << endl;
+            return nullptr;
+        }
+        DistanceTable distances(
+            num_entries, bits, base,
+            reinterpret_cast<const uint32_t *>(words), mapping);
+        pdbs->push_back(make_shared<PatternDatabase>(
+                            task_proxy, pattern, move(distances)));
+    }
+    cout << "Loaded " << pdbs->size() << " PDBs from " << filename << endl;
+    return pdbs;
+}
+}
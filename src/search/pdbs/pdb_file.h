@@ -0,0 +1,42 @@
+#ifndef PDBS_PDB_FILE_H
+#define PDBS_PDB_FILE_H
+
+#include "types.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class TaskProxy;
+
+namespace pdbs {
+/*
+  Binary files that store a collection of PDBs for one task. Each PDB is
+  stored as its pattern followed by its compressed distance table, so that
+  loading only needs to memory-map the file: the distance tables of the
+  loaded PDBs point directly into the mapping.
+
+  Files are keyed by a fingerprint of the task (variables, operators and
+  goals) and a fingerprint of the configuration that generated the
+  patterns. Loading a file written for a different task or configuration
+  fails.
+*/
+extern std::uint64_t compute_task_fingerprint(const TaskProxy &task_proxy);
+
+extern void save_pdbs(
+    const std::string &filename,
+    const TaskProxy &task_proxy,
+    std::uint64_t generator_fingerprint,
+    const PDBCollection &pdbs);
+
+/*
+  Returns nullptr if the file does not exist, is malformed or was written
+  for a different task or generator.
+*/
+extern std::shared_ptr<PDBCollection> load_pdbs(
+    const std::string &filename,
+    const TaskProxy &task_proxy,
+    std::uint64_t generator_fingerprint);
+}
+
+#endif
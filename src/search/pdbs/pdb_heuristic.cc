@@ -23,7 +23,9 @@ PatternDatabase get_pdb_from_options(const shared_ptr<AbstractTask> &task,
 
 PDBHeuristic::PDBHeuristic(const Options &opts)
     : Heuristic(opts),
-      pdb(get_pdb_from_options(task, opts)) {
+      pdb(get_pdb_from_options(task, opts)),
+      memory_reporter(
+          "pattern databases", [this]() {return pdb.get_num_bytes();}) {
 }
 
 int PDBHeuristic::compute_heuristic(const GlobalState &global_state) {
@@ -5,6 +5,8 @@
 
 #include "../heuristic.h"
 
+#include "../utils/memory_accounting.h"
+
 class GlobalState;
 class State;
 
@@ -16,6 +18,7 @@ namespace pdbs {
 // Implements a heuristic for a single PDB.
 class PDBHeuristic : public Heuristic {
     PatternDatabase pdb;
+    utils::MemoryReporter memory_reporter;
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
     /* TODO: we want to get rid of compute_heuristic(const GlobalState &state)
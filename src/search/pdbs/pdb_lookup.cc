@@ -0,0 +1,147 @@
+#include "pdb_lookup.h"
+
+#include "distance_table.h"
+#include "pattern_database.h"
+
+#include "../task_proxy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+
+using namespace std;
+
+namespace pdbs {
+PDBLookup::PDBLookup(const MaxAdditivePDBSubsets &subsets) {
+    unordered_map<const PatternDatabase *, int> pdb_to_index;
+    pattern_offsets.push_back(0);
+    subset_offsets.push_back(0);
+    for (const PDBCollection &subset : subsets) {
+        for (const shared_ptr<PatternDatabase> &pdb : subset) {
+            auto inserted = pdb_to_index.emplace(pdb.get(), pdbs.size());
+            subset_pdbs.push_back(inserted.first->second);
+            if (inserted.second) {
+                add_pdb(pdb);
+            }
+        }
+        subset_offsets.push_back(subset_pdbs.size());
+    }
+}
+
+void PDBLookup::add_pdb(const shared_ptr<PatternDatabase> &pdb) {
+    pdbs.push_back(pdb);
+    distance_tables.push_back(&pdb->get_distance_table());
+    const Pattern &pattern = pdb->get_pattern();
+    const vector<size_t> &multipliers = pdb->get_hash_multipliers();
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        int var = pattern[i];
+        pattern_variables.push_back(var);
+        pattern_multipliers.push_back(multipliers[i]);
+        if (var >= static_cast<int>(variable_to_row.size())) {
+            variable_to_row.resize(var + 1, -1);
+        }
+        if (variable_to_row[var] == -1) {
+            variable_to_row[var] = relevant_variables.size();
+            relevant_variables.push_back(var);
+        }
+    }
+    pattern_offsets.push_back(pattern_variables.size());
+}
+
+int PDBLookup::get_value(const State &state) const {
+    const vector<int> &state_values = state.get_values();
+    int num_subsets = subset_offsets.size() - 1;
+    int max_h = 0;
+    for (int subset = 0; subset < num_subsets; ++subset) {
+        int subset_h = 0;
+        for (int k = subset_offsets[subset]; k < subset_offsets[subset + 1]; ++k) {
+            int pdb = subset_pdbs[k];
+            uint32_t rank = 0;
+            for (int i = pattern_offsets[pdb]; i < pattern_offsets[pdb + 1]; ++i) {
+                rank += pattern_multipliers[i] * state_values[pattern_variables[i]];
+            }
+            int h = distance_tables[pdb]->get(rank);
+            if (h == DistanceTable::DEAD_END)
+                return DistanceTable::DEAD_END;
+            subset_h += h;
+        }
+        max_h = max(max_h, subset_h);
+    }
+    return max_h;
+}
+
+void PDBLookup::evaluate_batch(
+    const vector<State> &states, int begin, int end,
+    vector<int> &values) const {
+    int num_states = end - begin;
+    assert(num_states <= BATCH_SIZE);
+    int num_pdbs = pdbs.size();
+
+    // Row r holds the values of relevant_variables[r] for all states.
+    vector<uint32_t> state_values(relevant_variables.size() * BATCH_SIZE);
+    for (int s = 0; s < num_states; ++s) {
+        const vector<int> &values_of_state = states[begin + s].get_values();
+        for (size_t row = 0; row < relevant_variables.size(); ++row) {
+            state_values[row * BATCH_SIZE + s] =
+                values_of_state[relevant_variables[row]];
+        }
+    }
+
+    /*
+      Row i holds the values of PDB i. Dead ends are stored as 0 and
+      recorded in is_dead_end instead, so that the sums do not overflow.
+    */
+    vector<int> pdb_values(num_pdbs * BATCH_SIZE);
+    vector<uint8_t> is_dead_end(BATCH_SIZE, 0);
+    uint32_t ranks[BATCH_SIZE];
+    for (int pdb = 0; pdb < num_pdbs; ++pdb) {
+        fill(ranks, ranks + BATCH_SIZE, 0);
+        for (int i = pattern_offsets[pdb]; i < pattern_offsets[pdb + 1]; ++i) {
+            const uint32_t multiplier = pattern_multipliers[i];
+            const uint32_t *var_values =
+                &state_values[variable_to_row[pattern_variables[i]] * BATCH_SIZE];
+            for (int s = 0; s < BATCH_SIZE; ++s) {
+                ranks[s] += multiplier * var_values[s];
+            }
+        }
+        const DistanceTable &distances = *distance_tables[pdb];
+        int *h_values = &pdb_values[pdb * BATCH_SIZE];
+        for (int s = 0; s < num_states; ++s) {
+            int h = distances.get(ranks[s]);
+            bool dead_end = (h == DistanceTable::DEAD_END);
+            is_dead_end[s] |= dead_end;
+            h_values[s] = dead_end ? 0 : h;
+        }
+    }
+
+    int num_subsets = subset_offsets.size() - 1;
+    int max_h[BATCH_SIZE] = {};
+    int subset_h[BATCH_SIZE];
+    for (int subset = 0; subset < num_subsets; ++subset) {
+        fill(subset_h, subset_h + BATCH_SIZE, 0);
+        for (int k = subset_offsets[subset]; k < subset_offsets[subset + 1]; ++k) {
+            const int *h_values = &pdb_values[subset_pdbs[k] * BATCH_SIZE];
+            for (int s = 0; s < BATCH_SIZE; ++s) {
+                subset_h[s] += h_values[s];
+            }
+        }
+        for (int s = 0; s < BATCH_SIZE; ++s) {
+            max_h[s] = max(max_h[s], subset_h[s]);
+        }
+    }
+
+    for (int s = 0; s < num_states; ++s) {
+        values[begin + s] = is_dead_end[s] ? DistanceTable::DEAD_END : max_h[s];
+    }
+}
+
+void PDBLookup::get_values(
+    const vector<State> &states, vector<int> &values) const {
+    int num_states = states.size();
+    values.resize(num_states);
+    for (int begin = 0; begin < num_states; begin += BATCH_SIZE) {
+        evaluate_batch(
+            states, begin, min(begin + BATCH_SIZE, num_states), values);
+    }
+}
+}
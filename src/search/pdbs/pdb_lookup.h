@@ -0,0 +1,69 @@
+#ifndef PDBS_PDB_LOOKUP_H
+#define PDBS_PDB_LOOKUP_H
+
+#include "types.h"
+
+#include <cstdint>
+#include <vector>
+
+class State;
+
+namespace pdbs {
+class DistanceTable;
+
+/*
+  Flattened evaluation of a PDB collection whose heuristic value is the
+  maximum over the sums of given subsets of the PDBs. This covers the
+  canonical heuristic (the subsets are the maximal additive subsets) and
+  zero-one cost partitioning (one subset with all PDBs).
+
+  All patterns are stored back to back together with their hash
+  multipliers, and the subsets are stored as lists of PDB indices, so
+  evaluating a state does not follow any shared pointers.
+
+  get_values() evaluates batches of states. The variable values of a batch
+  are transposed so that all values of one variable are contiguous. The
+  rank computation of each PDB then is a multiply-add over contiguous
+  arrays, which the compiler vectorizes, and the sums and maxima over the
+  subsets are taken for the whole batch at once.
+
+  Dead ends are reported as DistanceTable::DEAD_END.
+*/
+class PDBLookup {
+    static const int BATCH_SIZE = 64;
+
+    // Keeps the distance tables alive.
+    PDBCollection pdbs;
+    std::vector<const DistanceTable *> distance_tables;
+
+    // Variables of PDB i: pattern_variables[pattern_offsets[i]...].
+    std::vector<int> pattern_offsets;
+    std::vector<int> pattern_variables;
+    std::vector<std::uint32_t> pattern_multipliers;
+
+    // PDBs of subset i: subset_pdbs[subset_offsets[i]...].
+    std::vector<int> subset_offsets;
+    std::vector<int> subset_pdbs;
+
+    // Batch rows for the variables that occur in some pattern.
+    std::vector<int> relevant_variables;
+    std::vector<int> variable_to_row;
+
+    void add_pdb(const std::shared_ptr<PatternDatabase> &pdb);
+    void evaluate_batch(
+        const std::vector<State> &states, int begin, int end,
+        std::vector<int> &values) const;
+public:
+    explicit PDBLookup(const MaxAdditivePDBSubsets &subsets);
+
+    int get_value(const State &state) const;
+    /*
+      Sets values[i] to the value of states[i]. This gives the same results
+      as get_value(), but is considerably faster for many states.
+    */
+    void get_values(
+        const std::vector<State> &states, std::vector<int> &values) const;
+};
+}
+
+#endif
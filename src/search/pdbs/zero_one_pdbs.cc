@@ -14,8 +14,9 @@
 using namespace std;
 
 namespace pdbs {
-ZeroOnePDBs::ZeroOnePDBs(
+static PDBCollection compute_zero_one_pdbs(
     const TaskProxy &task_proxy, const PatternCollection &patterns) {
+    PDBCollection pattern_databases;
     vector<int> remaining_operator_costs;
     OperatorsProxy operators = task_proxy.get_operators();
     remaining_operator_costs.reserve(operators.size());
@@ -36,6 +37,13 @@ ZeroOnePDBs::ZeroOnePDBs(
 
         pattern_databases.push_back(pdb);
     }
+    return pattern_databases;
+}
+
+ZeroOnePDBs::ZeroOnePDBs(
+    const TaskProxy &task_proxy, const PatternCollection &patterns)
+    : pattern_databases(compute_zero_one_pdbs(task_proxy, patterns)),
+      lookup(MaxAdditivePDBSubsets {pattern_databases}) {
 }
 
 
@@ -44,14 +52,20 @@ int ZeroOnePDBs::get_value(const State &state) const {
       Because we use cost partitioning, we can simply add up all
       heuristic values of all patterns in the pattern collection.
     */
-    int h_val = 0;
+    return lookup.get_value(state);
+}
+
+void ZeroOnePDBs::get_values(
+    const vector<State> &states, vector<int> &values) const {
+    lookup.get_values(states, values);
+}
+
+size_t ZeroOnePDBs::get_num_bytes() const {
+    size_t num_bytes = 0;
     for (const shared_ptr<PatternDatabase> &pdb : pattern_databases) {
-        int pdb_value = pdb->get_value(state);
-        if (pdb_value == numeric_limits<int>::max())
-            return numeric_limits<int>::max();
-        h_val += pdb_value;
+        num_bytes += pdb->get_num_bytes();
     }
-    return h_val;
+    return num_bytes;
 }
 
 double ZeroOnePDBs::compute_approx_mean_finite_h() const {
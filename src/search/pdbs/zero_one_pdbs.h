@@ -1,19 +1,27 @@
 #ifndef PDBS_ZERO_ONE_PDBS_H
 #define PDBS_ZERO_ONE_PDBS_H
 
+#include "pdb_lookup.h"
 #include "types.h"
 
+#include <cstddef>
+#include <vector>
+
 class State;
 class TaskProxy;
 
 namespace pdbs {
 class ZeroOnePDBs {
     PDBCollection pattern_databases;
+    // Sums up all PDBs (a single subset).
+    PDBLookup lookup;
 public:
     ZeroOnePDBs(const TaskProxy &task_proxy, const PatternCollection &patterns);
     ~ZeroOnePDBs() = default;
 
     int get_value(const State &state) const;
+    void get_values(
+        const std::vector<State> &states, std::vector<int> &values) const;
     /*
       Returns the sum of all mean finite h-values of every PDB.
       This is an approximation of the real mean finite h-value of the Heuristic,
@@ -23,6 +31,7 @@ public:
       these states.
     */
     double compute_approx_mean_finite_h() const;
+    std::size_t get_num_bytes() const;
     void dump() const;
 };
 }
@@ -23,7 +23,10 @@ ZeroOnePDBs get_zero_one_pdbs_from_options(
 ZeroOnePDBsHeuristic::ZeroOnePDBsHeuristic(
     const options::Options &opts)
     : Heuristic(opts),
-      zero_one_pdbs(get_zero_one_pdbs_from_options(task, opts)) {
+      zero_one_pdbs(get_zero_one_pdbs_from_options(task, opts)),
+      memory_reporter(
+          "pattern databases",
+          [this]() {return zero_one_pdbs.get_num_bytes();}) {
 }
 
 int ZeroOnePDBsHeuristic::compute_heuristic(const GlobalState &global_state) {
@@ -5,11 +5,14 @@
 
 #include "../heuristic.h"
 
+#include "../utils/memory_accounting.h"
+
 namespace pdbs {
 class PatternDatabase;
 
 class ZeroOnePDBsHeuristic : public Heuristic {
     ZeroOnePDBs zero_one_pdbs;
+    utils::MemoryReporter memory_reporter;
 protected:
     virtual int compute_heuristic(const GlobalState &global_state);
     /* TODO: we want to get rid of compute_heuristic(const GlobalState &state)
@@ -55,6 +55,16 @@ class PerStateArray : public subscriber::Subscriber<StateRegistry> {
     mutable const StateRegistry *cached_registry;
     mutable segmented_vector::SegmentedArrayVector<Element> *cached_entries;
 
+    utils::MemoryReporter memory_reporter;
+
+    std::size_t get_num_bytes() const {
+        std::size_t num_bytes = 0;
+        for (const auto &it : entry_arrays_by_registry) {
+            num_bytes += it.second->get_num_bytes();
+        }
+        return num_bytes;
+    }
+
     segmented_vector::SegmentedArrayVector<Element> *get_entries(const StateRegistry *registry) {
         if (cached_registry != registry) {
             cached_registry = registry;
@@ -89,10 +99,12 @@ class PerStateArray : public subscriber::Subscriber<StateRegistry> {
     }
 
 public:
-    explicit PerStateArray(const std::vector<Element> &default_array)
+    explicit PerStateArray(const std::vector<Element> &default_array,
+                           const char *subsystem = "per-state arrays")
         : default_array(default_array),
           cached_registry(nullptr),
-          cached_entries(nullptr) {
+          cached_entries(nullptr),
+          memory_reporter(subsystem, [this]() {return get_num_bytes();}) {
     }
 
     PerStateArray(const PerStateArray<Element> &) = delete;
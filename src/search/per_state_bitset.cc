@@ -1,5 +1,7 @@
 #include "per_state_bitset.h"
 
+#include <bitset>
+
 using namespace std;
 
 
@@ -19,6 +21,11 @@ BitsetMath::Block BitsetMath::bit_mask(size_t pos) {
     return Block(1) << bit_index(pos);
 }
 
+int BitsetMath::count_bits(Block block) {
+    // std::bitset::count() compiles to a popcount instruction where available.
+    return bitset<bits_per_block>(block).count();
+}
+
 
 BitsetView::BitsetView(ArrayView<BitsetMath::Block> data, int num_bits) :
     data(data), num_bits(num_bits) {}
@@ -55,10 +62,30 @@ void BitsetView::intersect(const BitsetView &other) {
     }
 }
 
+int BitsetView::count() const {
+    int result = 0;
+    for (int i = 0; i < data.size(); ++i) {
+        result += BitsetMath::count_bits(data[i]);
+    }
+    return result;
+}
+
 int BitsetView::size() const {
     return num_bits;
 }
 
+int BitsetView::num_blocks() const {
+    return data.size();
+}
+
+BitsetMath::Block BitsetView::get_block(int block_index) const {
+    return data[block_index];
+}
+
+void BitsetView::set_block(int block_index, BitsetMath::Block block) {
+    data[block_index] = block;
+}
+
 
 static vector<BitsetMath::Block> pack_bit_vector(const vector<bool> &bits) {
     int num_bits = bits.size();
@@ -76,7 +103,7 @@ static vector<BitsetMath::Block> pack_bit_vector(const vector<bool> &bits) {
 
 PerStateBitset::PerStateBitset(const vector<bool> &default_bits)
     : num_bits_per_entry(default_bits.size()),
-      data(pack_bit_vector(default_bits)) {
+      data(pack_bit_vector(default_bits), "per-state bitsets") {
 }
 
 BitsetView PerStateBitset::operator[](const GlobalState &state) {
@@ -22,6 +22,7 @@ public:
     static std::size_t block_index(std::size_t pos);
     static std::size_t bit_index(std::size_t pos);
     static Block bit_mask(std::size_t pos);
+    static int count_bits(Block block);
 };
 
 
@@ -39,7 +40,14 @@ public:
     void reset();
     bool test(int index) const;
     void intersect(const BitsetView &other);
+    // Number of set bits.
+    int count() const;
     int size() const;
+
+    // Word-level access for callers that combine bitsets with own masks.
+    int num_blocks() const;
+    BitsetMath::Block get_block(int block_index) const;
+    void set_block(int block_index, BitsetMath::Block block);
 };
 
 
@@ -8,6 +8,7 @@
 #include "algorithms/segmented_vector.h"
 #include "algorithms/subscriber.h"
 #include "utils/collections.h"
+#include "utils/memory_accounting.h"
 
 #include <cassert>
 #include <unordered_map>
@@ -36,16 +37,32 @@
   stores information. Once a StateRegistry is destroyed, it notifies all
   subscribed objects, which in turn destroy all information stored for states
   in that registry.
+
+  The memory used by the entries is accounted to the given subsystem (see
+  utils::MemoryReporter).
 */
 template<class Entry>
 class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
     const Entry default_value;
+    // Entries are allocated where the registry stores its states.
+    using EntryVector = segmented_vector::SegmentedVector<
+        Entry, utils::ArenaAllocator<Entry>>;
     using EntryVectorMap = std::unordered_map<const StateRegistry *,
-                                              segmented_vector::SegmentedVector<Entry> * >;
+                                              EntryVector *>;
     EntryVectorMap entries_by_registry;
 
     mutable const StateRegistry *cached_registry;
-    mutable segmented_vector::SegmentedVector<Entry> *cached_entries;
+    mutable EntryVector *cached_entries;
+
+    utils::MemoryReporter memory_reporter;
+
+    std::size_t get_num_bytes() const {
+        std::size_t num_bytes = 0;
+        for (const auto &it : entries_by_registry) {
+            num_bytes += it.second->get_num_bytes();
+        }
+        return num_bytes;
+    }
 
     /*
       Returns the SegmentedVector associated with the given StateRegistry.
@@ -53,12 +70,13 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
       Both the registry and the returned vector are cached to speed up
       consecutive calls with the same registry.
     */
-    segmented_vector::SegmentedVector<Entry> *get_entries(const StateRegistry *registry) {
+    EntryVector *get_entries(const StateRegistry *registry) {
         if (cached_registry != registry) {
             cached_registry = registry;
             auto it = entries_by_registry.find(registry);
             if (it == entries_by_registry.end()) {
-                cached_entries = new segmented_vector::SegmentedVector<Entry>();
+                cached_entries = new EntryVector(
+                    utils::ArenaAllocator<Entry>(registry->get_arena()));
                 entries_by_registry[registry] = cached_entries;
                 registry->subscribe(this);
             } else {
@@ -75,14 +93,14 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
       Otherwise, both the registry and the returned vector are cached to speed
       up consecutive calls with the same registry.
     */
-    const segmented_vector::SegmentedVector<Entry> *get_entries(const StateRegistry *registry) const {
+    const EntryVector *get_entries(const StateRegistry *registry) const {
         if (cached_registry != registry) {
             const auto it = entries_by_registry.find(registry);
             if (it == entries_by_registry.end()) {
                 return nullptr;
             } else {
                 cached_registry = registry;
-                cached_entries = const_cast<segmented_vector::SegmentedVector<Entry> *>(it->second);
+                cached_entries = const_cast<EntryVector *>(it->second);
             }
         }
         assert(cached_registry == registry);
@@ -90,16 +108,21 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
     }
 
 public:
-    PerStateInformation()
+    explicit PerStateInformation(
+        const char *subsystem = "per-state information")
         : default_value(),
           cached_registry(nullptr),
-          cached_entries(nullptr) {
+          cached_entries(nullptr),
+          memory_reporter(subsystem, [this]() {return get_num_bytes();}) {
     }
 
-    explicit PerStateInformation(const Entry &default_value_)
+    explicit PerStateInformation(
+        const Entry &default_value_,
+        const char *subsystem = "per-state information")
         : default_value(default_value_),
           cached_registry(nullptr),
-          cached_entries(nullptr) {
+          cached_entries(nullptr),
+          memory_reporter(subsystem, [this]() {return get_num_bytes();}) {
     }
 
     PerStateInformation(const PerStateInformation<Entry> &) = delete;
@@ -113,7 +136,7 @@ public:
 
     Entry &operator[](const GlobalState &state) {
         const StateRegistry *registry = &state.get_registry();
-        segmented_vector::SegmentedVector<Entry> *entries = get_entries(registry);
+        EntryVector *entries = get_entries(registry);
         int state_id = state.get_id().value;
         size_t virtual_size = registry->size();
         assert(utils::in_bounds(state_id, *registry));
@@ -125,7 +148,7 @@ public:
 
     const Entry &operator[](const GlobalState &state) const {
         const StateRegistry *registry = &state.get_registry();
-        const segmented_vector::SegmentedVector<Entry> *entries = get_entries(registry);
+        const EntryVector *entries = get_entries(registry);
         if (!entries) {
             return default_value;
         }
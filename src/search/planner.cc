@@ -1,7 +1,10 @@
+#include "evaluator.h"
 #include "globals.h"
 #include "option_parser.h"
 #include "search_engine.h"
+#include "search_profiler.h"
 
+#include "utils/memory_accounting.h"
 #include "utils/system.h"
 #include "utils/timer.h"
 
@@ -47,6 +50,9 @@ int main(int argc, const char **argv) {
 
     engine->save_plan_if_necessary();
     engine->print_statistics();
+    Evaluator::print_all_cache_statistics();
+    g_search_profiler.print_statistics();
+    utils::print_memory_usage();
     cout << "Search time: " << search_timer << endl;
     cout << "Total time: " << utils::g_timer << endl;
 
@@ -9,6 +9,8 @@
 
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
+#include "../utils/thread_pool.h"
+#include "../utils/thread_pool_options.h"
 #include "../utils/timer.h"
 
 #include <unordered_set>
@@ -17,31 +19,49 @@ using namespace std;
 
 namespace potentials {
 DiversePotentialHeuristics::DiversePotentialHeuristics(const Options &opts)
-    : optimizer(opts),
+    : opts(opts),
+      optimizer(opts),
       max_num_heuristics(opts.get<int>("max_num_heuristics")),
       num_samples(opts.get<int>("num_samples")),
-      rng(utils::parse_rng_from_options(opts)) {
+      rng(utils::parse_rng_from_options(opts)),
+      thread_pool(utils::parse_thread_pool_from_options(opts)) {
 }
 
 SamplesToFunctionsMap
 DiversePotentialHeuristics::filter_samples_and_compute_functions(
     const vector<State> &samples) {
     utils::Timer filtering_timer;
-    unordered_set<State> dead_ends;
+    // Skipping duplicates is not necessary, but saves LP evaluations.
+    unordered_set<State> seen_samples;
+    vector<State> unique_samples;
     int num_duplicates = 0;
-    int num_dead_ends = 0;
-    SamplesToFunctionsMap samples_to_functions;
     for (const State &sample : samples) {
-        // Skipping duplicates is not necessary, but saves LP evaluations.
-        if (samples_to_functions.count(sample) || dead_ends.count(sample)) {
+        if (seen_samples.insert(sample).second) {
+            unique_samples.push_back(sample);
+        } else {
             ++num_duplicates;
-            continue;
         }
-        optimizer.optimize_for_state(sample);
-        if (optimizer.has_optimal_solution()) {
-            samples_to_functions[sample] = optimizer.get_potential_function();
+    }
+
+    vector<unique_ptr<PotentialFunction>> functions(unique_samples.size());
+    process_with_optimizers(
+        opts,
+        optimizer,
+        unique_samples.size(),
+        *thread_pool,
+        [&](PotentialOptimizer &task_optimizer, int i) {
+            task_optimizer.optimize_for_state(unique_samples[i]);
+            if (task_optimizer.has_optimal_solution()) {
+                functions[i] = task_optimizer.get_potential_function();
+            }
+        });
+
+    int num_dead_ends = 0;
+    SamplesToFunctionsMap samples_to_functions;
+    for (size_t i = 0; i < unique_samples.size(); ++i) {
+        if (functions[i]) {
+            samples_to_functions[unique_samples[i]] = move(functions[i]);
         } else {
-            dead_ends.insert(sample);
             ++num_dead_ends;
         }
     }
@@ -116,8 +136,9 @@ DiversePotentialHeuristics::find_functions() {
     utils::Timer init_timer;
 
     // Sample states.
-    vector<State> samples = sample_without_dead_end_detection(
-        optimizer, num_samples, *rng);
+    vector<vector<State>> sample_sets = sample_without_dead_end_detection(
+        opts, optimizer, 1, num_samples, *rng, *thread_pool);
+    const vector<State> &samples = sample_sets[0];
 
     // Filter dead end samples.
     SamplesToFunctionsMap samples_to_functions =
@@ -147,7 +168,7 @@ static Heuristic *_parse(OptionParser &parser) {
         "infinity",
         Bounds("0", "infinity"));
     prepare_parser_for_admissible_potentials(parser);
-    utils::add_rng_options(parser);
+    add_sampling_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
@@ -3,12 +3,15 @@
 
 #include "potential_optimizer.h"
 
+#include "../options/options.h"
+
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
 namespace utils {
 class RandomNumberGenerator;
+class ThreadPool;
 }
 
 namespace potentials {
@@ -19,16 +22,20 @@ using SamplesToFunctionsMap =
   Factory class that finds diverse potential functions.
 */
 class DiversePotentialHeuristics {
+    // Used to create an optimizer for each thread.
+    const options::Options opts;
     PotentialOptimizer optimizer;
     // TODO: Remove max_num_heuristics and control number of heuristics
     // with num_samples parameter?
     const int max_num_heuristics;
     const int num_samples;
     std::shared_ptr<utils::RandomNumberGenerator> rng;
+    std::shared_ptr<utils::ThreadPool> thread_pool;
     std::vector<std::unique_ptr<PotentialFunction>> diverse_functions;
 
     /* Filter dead end samples and duplicates. Store potential heuristics
-       for remaining samples. */
+       for remaining samples. The LPs for the samples are solved
+       concurrently. */
     SamplesToFunctionsMap filter_samples_and_compute_functions(
         const std::vector<State> &samples);
 
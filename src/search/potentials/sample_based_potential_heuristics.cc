@@ -8,6 +8,8 @@
 
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
+#include "../utils/thread_pool.h"
+#include "../utils/thread_pool_options.h"
 
 #include <memory>
 #include <vector>
@@ -28,10 +30,7 @@ static void filter_dead_ends(PotentialOptimizer &optimizer, vector<State> &sampl
 
 static void optimize_for_samples(
     PotentialOptimizer &optimizer,
-    int num_samples,
-    utils::RandomNumberGenerator &rng) {
-    vector<State> samples = sample_without_dead_end_detection(
-        optimizer, num_samples, rng);
+    vector<State> &samples) {
     if (!optimizer.potentials_are_bounded()) {
         filter_dead_ends(optimizer, samples);
     }
@@ -44,13 +43,24 @@ static void optimize_for_samples(
 */
 static vector<unique_ptr<PotentialFunction>> create_sample_based_potential_functions(
     const Options &opts) {
-    vector<unique_ptr<PotentialFunction>> functions;
+    int num_heuristics = opts.get<int>("num_heuristics");
     PotentialOptimizer optimizer(opts);
     shared_ptr<utils::RandomNumberGenerator> rng(utils::parse_rng_from_options(opts));
-    for (int i = 0; i < opts.get<int>("num_heuristics"); ++i) {
-        optimize_for_samples(optimizer, opts.get<int>("num_samples"), *rng);
-        functions.push_back(optimizer.get_potential_function());
-    }
+    shared_ptr<utils::ThreadPool> thread_pool =
+        utils::parse_thread_pool_from_options(opts);
+    vector<vector<State>> sample_sets = sample_without_dead_end_detection(
+        opts, optimizer, num_heuristics, opts.get<int>("num_samples"), *rng,
+        *thread_pool);
+    vector<unique_ptr<PotentialFunction>> functions(num_heuristics);
+    process_with_optimizers(
+        opts,
+        optimizer,
+        num_heuristics,
+        *thread_pool,
+        [&](PotentialOptimizer &task_optimizer, int i) {
+            optimize_for_samples(task_optimizer, sample_sets[i]);
+            functions[i] = task_optimizer.get_potential_function();
+        });
     return functions;
 }
 
@@ -70,7 +80,7 @@ static Heuristic *_parse(OptionParser &parser) {
         "1000",
         Bounds("0", "infinity"));
     prepare_parser_for_admissible_potentials(parser);
-    utils::add_rng_options(parser);
+    add_sampling_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
@@ -0,0 +1,109 @@
+#include "sample_file.h"
+
+#include "../task_proxy.h"
+
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+namespace potentials {
+static const string HEADER = "potential-samples-1";
+
+void save_samples(
+    const string &filename,
+    const AbstractTask &task,
+    const vector<vector<State>> &sample_sets) {
+    ofstream file(filename, ios::trunc);
+    if (!file) {
+        cerr << "Could not write sample file " << filename << endl;
+        return;
+    }
+    VariablesProxy variables = TaskProxy(task).get_variables();
+    file << HEADER << "\n" << variables.size();
+    for (VariableProxy var : variables) {
+        file << " " << var.get_domain_size();
+    }
+    file << "\n" << sample_sets.size() << "\n";
+    for (const vector<State> &samples : sample_sets) {
+        file << samples.size() << "\n";
+        for (const State &sample : samples) {
+            const vector<int> &values = sample.get_values();
+            for (size_t var = 0; var < values.size(); ++var) {
+                file << (var ? " " : "") << values[var];
+            }
+            file << "\n";
+        }
+    }
+    if (!file) {
+        cerr << "Could not write sample file " << filename << endl;
+    } else {
+        cout << "Saved " << sample_sets.size() << " sample sets to "
+             << filename << endl;
+    }
+}
+
+bool load_samples(
+    const string &filename,
+    const AbstractTask &task,
+    vector<vector<State>> &sample_sets) {
+    ifstream file(filename);
+    if (!file) {
+        return false;
+    }
+    string header;
+    size_t num_variables;
+    VariablesProxy variables = TaskProxy(task).get_variables();
+    if (!(file >> header >> num_variables) || header != HEADER) {
+        cerr << "Malformed sample file " << filename << endl;
+        return false;
+    }
+    bool same_variables = (num_variables == variables.size());
+    vector<int> domain_sizes(num_variables);
+    for (size_t var = 0; var < num_variables; ++var) {
+        if (!(file >> domain_sizes[var])) {
+            cerr << "Malformed sample file " << filename << endl;
+            return false;
+        }
+        if (same_variables &&
+            domain_sizes[var] != variables[var].get_domain_size()) {
+            same_variables = false;
+        }
+    }
+    if (!same_variables) {
+        cout << "Sample file " << filename
+             << " was created for a different task" << endl;
+        return false;
+    }
+
+    size_t num_sets;
+    if (!(file >> num_sets)) {
+        cerr << "Malformed sample file " << filename << endl;
+        return false;
+    }
+    vector<vector<State>> loaded_sets(num_sets);
+    for (vector<State> &samples : loaded_sets) {
+        size_t num_samples;
+        if (!(file >> num_samples)) {
+            cerr << "Malformed sample file " << filename << endl;
+            return false;
+        }
+        samples.reserve(num_samples);
+        for (size_t i = 0; i < num_samples; ++i) {
+            vector<int> values(num_variables);
+            for (size_t var = 0; var < num_variables; ++var) {
+                if (!(file >> values[var]) || values[var] < 0 ||
+                    values[var] >= domain_sizes[var]) {
+                    cerr << "Malformed sample file " << filename << endl;
+                    return false;
+                }
+            }
+            samples.emplace_back(task, move(values));
+        }
+    }
+    sample_sets = move(loaded_sets);
+    cout << "Loaded " << sample_sets.size() << " sample sets from "
+         << filename << endl;
+    return true;
+}
+}
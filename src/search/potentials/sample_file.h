@@ -0,0 +1,32 @@
+#ifndef POTENTIALS_SAMPLE_FILE_H
+#define POTENTIALS_SAMPLE_FILE_H
+
+#include <string>
+#include <vector>
+
+class State;
+class AbstractTask;
+
+namespace potentials {
+/*
+  Text files that store sets of sampled states, so that reruns can
+  optimize potential functions for exactly the same samples. The file
+  starts with the domain sizes of the task's variables, followed by the
+  sample sets. Each state is stored as one line of variable values.
+*/
+extern void save_samples(
+    const std::string &filename,
+    const AbstractTask &task,
+    const std::vector<std::vector<State>> &sample_sets);
+
+/*
+  Returns false if the file does not exist, is malformed or was written for
+  a task with different variables.
+*/
+extern bool load_samples(
+    const std::string &filename,
+    const AbstractTask &task,
+    std::vector<std::vector<State>> &sample_sets);
+}
+
+#endif
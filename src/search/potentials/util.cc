@@ -2,6 +2,7 @@
 
 #include "potential_function.h"
 #include "potential_optimizer.h"
+#include "sample_file.h"
 
 #include "../heuristic.h"
 #include "../option_parser.h"
@@ -10,25 +11,118 @@
 #include "../task_utils/successor_generator.h"
 #include "../task_utils/task_properties.h"
 #include "../utils/markup.h"
+#include "../utils/memory.h"
+#include "../utils/rng.h"
+#include "../utils/rng_options.h"
+#include "../utils/thread_pool.h"
+#include "../utils/thread_pool_options.h"
 
+#include <algorithm>
 #include <limits>
 
 using namespace std;
 
 namespace potentials {
-vector<State> sample_without_dead_end_detection(
+static bool samples_match(
+    const vector<vector<State>> &sample_sets, int num_sets, int num_samples) {
+    return static_cast<int>(sample_sets.size()) == num_sets &&
+           all_of(sample_sets.begin(), sample_sets.end(),
+                  [num_samples](const vector<State> &samples) {
+                      return static_cast<int>(samples.size()) == num_samples;
+                  });
+}
+
+vector<vector<State>> sample_without_dead_end_detection(
+    const Options &opts,
     PotentialOptimizer &optimizer,
+    int num_sets,
     int num_samples,
-    utils::RandomNumberGenerator &rng) {
+    utils::RandomNumberGenerator &rng,
+    utils::ThreadPool &thread_pool) {
     const shared_ptr<AbstractTask> task = optimizer.get_task();
     const TaskProxy task_proxy(*task);
+    const string filename =
+        opts.contains("samples_file") ? opts.get<string>("samples_file") : "";
+    vector<vector<State>> sample_sets;
+    if (!filename.empty() && load_samples(filename, *task, sample_sets)) {
+        if (samples_match(sample_sets, num_sets, num_samples)) {
+            return sample_sets;
+        }
+        cout << "Sample file " << filename << " does not contain " << num_sets
+             << " sets of " << num_samples << " samples" << endl;
+        sample_sets.clear();
+    }
+
     State initial_state = task_proxy.get_initial_state();
     optimizer.optimize_for_state(initial_state);
     successor_generator::SuccessorGenerator successor_generator(task_proxy);
     int init_h = optimizer.get_potential_function()->get_value(initial_state);
-    return sampling::sample_states_with_random_walks(
-        task_proxy, successor_generator, num_samples, init_h,
-        task_properties::get_average_operator_cost(task_proxy), rng);
+    double average_operator_cost =
+        task_properties::get_average_operator_cost(task_proxy);
+
+    int num_parts = thread_pool.get_num_threads();
+    if (num_parts == 1) {
+        for (int i = 0; i < num_sets; ++i) {
+            sample_sets.push_back(sampling::sample_states_with_random_walks(
+                                      task_proxy, successor_generator,
+                                      num_samples, init_h,
+                                      average_operator_cost, rng));
+        }
+    } else {
+        int num_tasks = num_sets * num_parts;
+        vector<int> seeds;
+        seeds.reserve(num_tasks);
+        for (int i = 0; i < num_tasks; ++i) {
+            seeds.push_back(rng(numeric_limits<int>::max()));
+        }
+        vector<vector<State>> parts(num_tasks);
+        thread_pool.run(
+            num_tasks,
+            [&](int i) {
+                int part = i % num_parts;
+                int part_size = (part + 1) * num_samples / num_parts -
+                    part * num_samples / num_parts;
+                utils::RandomNumberGenerator local_rng(seeds[i]);
+                parts[i] = sampling::sample_states_with_random_walks(
+                    task_proxy, successor_generator, part_size, init_h,
+                    average_operator_cost, local_rng);
+            });
+        sample_sets.resize(num_sets);
+        for (int i = 0; i < num_tasks; ++i) {
+            for (State &sample : parts[i]) {
+                sample_sets[i / num_parts].push_back(move(sample));
+            }
+        }
+    }
+
+    if (!filename.empty()) {
+        save_samples(filename, *task, sample_sets);
+    }
+    return sample_sets;
+}
+
+void process_with_optimizers(
+    const Options &opts,
+    PotentialOptimizer &optimizer,
+    int num_items,
+    utils::ThreadPool &thread_pool,
+    const function<void(PotentialOptimizer &, int)> &process) {
+    int num_ranges = min(thread_pool.get_num_threads(), num_items);
+    thread_pool.run(
+        num_ranges,
+        [&](int range) {
+            unique_ptr<PotentialOptimizer> local_optimizer;
+            if (range > 0) {
+                local_optimizer = utils::make_unique_ptr<PotentialOptimizer>(opts);
+            }
+            PotentialOptimizer &task_optimizer =
+                local_optimizer ? *local_optimizer : optimizer;
+            int begin = range * num_items / num_ranges;
+            int end = (range + 1) * num_items / num_ranges;
+            for (int i = begin; i < end; ++i) {
+                process(task_optimizer, i);
+            }
+        });
 }
 
 string get_admissible_potentials_reference() {
@@ -58,4 +152,27 @@ void prepare_parser_for_admissible_potentials(OptionParser &parser) {
     lp::add_lp_solver_option_to_parser(parser);
     Heuristic::add_options_to_parser(parser);
 }
+
+void add_sampling_options_to_parser(OptionParser &parser) {
+    parser.document_note(
+        "Parallel construction",
+        "With num_threads > 1, the random walks are split into one part per "
+        "thread and the LPs for independent potential functions are solved "
+        "concurrently, each thread using its own LP solver. The result is "
+        "deterministic for a fixed random_seed and num_threads, but usually "
+        "differs from the one computed with a single thread.");
+    parser.document_note(
+        "Sample files",
+        "The sample file only records the variables of the task and the "
+        "sampled states. Delete it after changing the random seed or the "
+        "number of threads if you want new samples.");
+    utils::add_rng_options(parser);
+    utils::add_thread_pool_options(parser);
+    parser.add_option<string>(
+        "samples_file",
+        "file from which the samples are read if it contains the requested "
+        "number of samples, and to which new samples are written otherwise "
+        "(note that the command line is converted to lower case)",
+        OptionParser::NONE);
+}
 }
@@ -1,6 +1,7 @@
 #ifndef POTENTIALS_UTIL_H
 #define POTENTIALS_UTIL_H
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -9,22 +10,51 @@ class State;
 
 namespace options {
 class OptionParser;
+class Options;
 }
 
 namespace utils {
 class RandomNumberGenerator;
+class ThreadPool;
 }
 
 namespace potentials {
 class PotentialOptimizer;
 
-std::vector<State> sample_without_dead_end_detection(
+/*
+  Sample num_sets sets of num_samples states with random walks. If the
+  option "samples_file" names a file with matching sample sets, the samples
+  are read from it. Otherwise, they are sampled and written to the file.
+
+  With more than one thread, each set is split into one part per thread and
+  all parts are sampled concurrently with seeds drawn from rng in order.
+*/
+std::vector<std::vector<State>> sample_without_dead_end_detection(
+    const options::Options &opts,
     PotentialOptimizer &optimizer,
+    int num_sets,
     int num_samples,
-    utils::RandomNumberGenerator &rng);
+    utils::RandomNumberGenerator &rng,
+    utils::ThreadPool &thread_pool);
+
+/*
+  Call process(task_optimizer, i) for all i in [0, num_items). The items
+  are split into contiguous ranges that are processed concurrently, one per
+  thread. LP solvers cannot be shared between threads, so only the first
+  range uses the given optimizer and the others use their own optimizers
+  created from opts.
+*/
+void process_with_optimizers(
+    const options::Options &opts,
+    PotentialOptimizer &optimizer,
+    int num_items,
+    utils::ThreadPool &thread_pool,
+    const std::function<void(PotentialOptimizer &, int)> &process);
 
 std::string get_admissible_potentials_reference();
 void prepare_parser_for_admissible_potentials(options::OptionParser &parser);
+// Add options for random seeds, threads and sample files.
+void add_sampling_options_to_parser(options::OptionParser &parser);
 }
 
 #endif
@@ -5,11 +5,13 @@
 #include "globals.h"
 #include "option_parser.h"
 #include "plugin.h"
+#include "search_profiler.h"
 
 #include "algorithms/ordered_set.h"
 #include "task_utils/task_properties.h"
 #include "tasks/root_task.h"
 #include "utils/countdown_timer.h"
+#include "utils/memory_accounting.h"
 #include "utils/rng_options.h"
 #include "utils/system.h"
 #include "utils/timer.h"
@@ -23,16 +25,54 @@ using utils::ExitCode;
 
 class PruningMethod;
 
+shared_ptr<StateRegistry> SearchEngine::registry_for_new_engines;
+
+static shared_ptr<StateRegistry> create_state_registry(
+    const shared_ptr<AbstractTask> &task,
+    const shared_ptr<StateRegistry> &shared_registry,
+    const Options &opts) {
+    if (shared_registry && &shared_registry->get_task() == task.get()) {
+        return shared_registry;
+    }
+    string spill_directory;
+    if (opts.contains("spill_directory")) {
+        spill_directory = opts.get<string>("spill_directory");
+    }
+    bool compress_states =
+        opts.contains("compress_states") && opts.get<bool>("compress_states");
+    return make_shared<StateRegistry>(*task, spill_directory, compress_states);
+}
+
+/*
+  Enable the profiler if a profile file is given and the profiler is not
+  used yet, e.g., by an engine that runs this engine as a subsearch.
+*/
+static bool enable_profiler(const Options &opts) {
+    if (!opts.contains("profile_file") || g_search_profiler.is_enabled()) {
+        return false;
+    }
+    g_search_profiler.enable(
+        opts.get<string>("profile_file"),
+        opts.get<double>("profile_interval"),
+        opts.get<int>("profile_trace_size"));
+    return true;
+}
+
 SearchEngine::SearchEngine(const Options &opts)
     : status(IN_PROGRESS),
       solution_found(false),
+      stop_requested(false),
+      owns_profiler(enable_profiler(opts)),
       task(tasks::g_root_task),
       task_proxy(*task),
-      state_registry(*task),
+      shared_state_registry(
+          create_state_registry(task, registry_for_new_engines, opts)),
+      state_registry(*shared_state_registry),
       search_space(state_registry,
                    static_cast<OperatorCost>(opts.get_enum("cost_type"))),
       cost_type(static_cast<OperatorCost>(opts.get_enum("cost_type"))),
-      max_time(opts.get<double>("max_time")) {
+      max_time(opts.get<double>("max_time")),
+      memory_report_interval(opts.get<double>("memory_report_interval")) {
     if (opts.get<int>("bound") < 0) {
         cerr << "error: negative cost bound " << opts.get<int>("bound") << endl;
         utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
@@ -43,13 +83,18 @@ SearchEngine::SearchEngine(const Options &opts)
 SearchEngine::SearchEngine(const Options &opts, shared_ptr<AbstractTask> t)
     : status(IN_PROGRESS),
       solution_found(false),
+      stop_requested(false),
+      owns_profiler(enable_profiler(opts)),
       task(t),
       task_proxy(*task),
-      state_registry(*task),
+      shared_state_registry(
+          create_state_registry(task, registry_for_new_engines, opts)),
+      state_registry(*shared_state_registry),
       search_space(state_registry,
                    static_cast<OperatorCost>(opts.get_enum("cost_type"))),
       cost_type(static_cast<OperatorCost>(opts.get_enum("cost_type"))),
-      max_time(opts.get<double>("max_time")) {
+      max_time(opts.get<double>("max_time")),
+      memory_report_interval(opts.get<double>("memory_report_interval")) {
     if (opts.get<int>("bound") < 0) {
         cerr << "error: negative cost bound " << opts.get<int>("bound") << endl;
         utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
@@ -57,6 +102,11 @@ SearchEngine::SearchEngine(const Options &opts, shared_ptr<AbstractTask> t)
     bound = opts.get<int>("bound");
 }
 
+void SearchEngine::set_registry_for_new_engines(
+    const shared_ptr<StateRegistry> &registry) {
+    registry_for_new_engines = registry;
+}
+
 SearchEngine::~SearchEngine() {
 }
 
@@ -85,18 +135,45 @@ void SearchEngine::set_plan(const Plan &p) {
 
 void SearchEngine::search() {
     initialize();
+    if (owns_profiler) {
+        g_search_profiler.record_event(TraceEventType::SEARCH_STARTED);
+    }
     utils::CountdownTimer timer(max_time);
+    bool report_memory =
+        memory_report_interval != numeric_limits<double>::infinity();
+    utils::Timer memory_report_timer;
     while (status == IN_PROGRESS) {
         status = step();
+        if (owns_profiler) {
+            g_search_profiler.check_snapshot(statistics);
+        }
+        if (report_memory && memory_report_timer() >= memory_report_interval) {
+            cout << "Memory usage [t=" << utils::g_timer << "]:" << endl;
+            utils::print_memory_usage();
+            memory_report_timer.reset();
+        }
         if (timer.is_expired()) {
             cout << "Time limit reached. Abort search." << endl;
             status = TIMEOUT;
             break;
         }
+        if (stop_requested.load(memory_order_relaxed)) {
+            cout << "Stop requested. Abort search." << endl;
+            break;
+        }
     }
     // TODO: Revise when and which search times are logged.
     cout << "Actual search time: " << timer.get_elapsed_time()
          << " [t=" << utils::g_timer << "]" << endl;
+    if (owns_profiler) {
+        g_search_profiler.record_event(TraceEventType::SEARCH_FINISHED, status);
+        g_search_profiler.write_snapshot(statistics);
+        g_search_profiler.write_trace();
+    }
+}
+
+void SearchEngine::request_stop() {
+    stop_requested.store(true, memory_order_relaxed);
 }
 
 bool SearchEngine::check_goal_and_set_plan(const GlobalState &state) {
@@ -149,6 +226,54 @@ void SearchEngine::add_options_to_parser(OptionParser &parser) {
         "experiments. Timed-out searches are treated as failed searches, "
         "just like incomplete search algorithms that exhaust their search space.",
         "infinity");
+    parser.add_option<string>(
+        "spill_directory",
+        "directory for a temporary file that stores the registered states "
+        "and all per-state information (search nodes, cached heuristic "
+        "values). The operating system keeps recently used parts in memory "
+        "and moves the rest to the file, so exhaustive searches can explore "
+        "more states than fit into RAM. Only a hash index with 8 bytes per "
+        "state stays in memory. The file is mapped into the address space, "
+        "so limit the resident memory of the planner instead of its virtual "
+        "memory when using this option. By default, everything is kept in "
+        "memory.",
+        OptionParser::NONE);
+    parser.add_option<bool>(
+        "compress_states",
+        "store the registered states with tree compression: states are split "
+        "into a binary tree of pairs of bins and equal subtrees are stored "
+        "only once. This needs much less memory for the states of tasks with "
+        "many variables, but every state lookup has to decompress the state.",
+        "false");
+    parser.add_option<string>(
+        "profile_file",
+        "file for profiling data in JSON lines format: snapshots of the "
+        "search statistics and of the time spent in successor generation, "
+        "state registration, pruning, monitor checks and each evaluator, "
+        "followed by the last search events at the end of the search. The "
+        "time of an evaluator includes the evaluators it uses. Heuristics "
+        "are reported by their configurations and all other evaluators "
+        "(e.g., g() or sum()) as separate unnamed evaluators. If a search "
+        "runs other searches, only the outermost search with this option "
+        "writes the file. By default, no profiling data is collected.",
+        OptionParser::NONE);
+    parser.add_option<double>(
+        "profile_interval",
+        "seconds between two snapshots in the profile file",
+        "10");
+    parser.add_option<int>(
+        "profile_trace_size",
+        "number of most recent search events kept for the profile file",
+        "65536",
+        Bounds("1", "infinity"));
+    parser.add_option<double>(
+        "memory_report_interval",
+        "seconds between two reports of the estimated memory usage of the "
+        "subsystems of the planner (state registry, search nodes, open lists, "
+        "heuristics, ...) during the search. The memory usage at the end of "
+        "the search is always reported.",
+        "infinity",
+        Bounds("0.0", "infinity"));
 }
 
 /* Method doesn't belong here because it's only useful for certain derived classes.
@@ -11,6 +11,7 @@
 #include "task_proxy.h"
 #include "tasks/modified_disjunctive_goal_task.h"
 
+#include <atomic>
 #include <vector>
 
 namespace options {
@@ -26,8 +27,13 @@ class OrderedSet;
 enum SearchStatus {IN_PROGRESS, TIMEOUT, FAILED, SOLVED};
 
 class SearchEngine {
+    static std::shared_ptr<StateRegistry> registry_for_new_engines;
+
     SearchStatus status;
     bool solution_found;
+    std::atomic<bool> stop_requested;
+    // True if this engine writes the snapshots and events of the profiler.
+    const bool owns_profiler;
 
     Plan plan;
 protected:
@@ -38,13 +44,17 @@ protected:
     
 
     PlanManager plan_manager;
-    StateRegistry state_registry;
+    // Either owned by this engine or shared with other engines.
+    std::shared_ptr<StateRegistry> shared_state_registry;
+    StateRegistry &state_registry;
     SearchSpace search_space;
     SearchProgress search_progress;
     SearchStatistics statistics;
     int bound;
     OperatorCost cost_type;
     double max_time;
+    // Seconds between two reports of the memory usage during the search.
+    double memory_report_interval;
 
     virtual void initialize() {}
     virtual SearchStatus step() = 0;
@@ -63,6 +73,12 @@ public:
     SearchStatus get_status() const;
     const Plan &get_plan() const;
     void search();
+    /*
+      Ask search() to return after the current step. Unlike all other
+      methods, this may be called from a thread other than the one running
+      the search.
+    */
+    void request_stop();
     const SearchStatistics &get_statistics() const {return statistics;}
     void set_bound(int b) {bound = b;}
     int get_bound() {return bound;}
@@ -85,6 +101,15 @@ public:
         */
     }
     const std::shared_ptr<AbstractTask> & getTask() {return task;}
+
+    /*
+      Engines for the same task that are created while a registry is set
+      here use it instead of creating their own. Per-state information, such
+      as cached heuristic values, then carries over between these engines.
+      Pass nullptr to stop sharing.
+    */
+    static void set_registry_for_new_engines(
+        const std::shared_ptr<StateRegistry> &registry);
     virtual double get_heuristic_refinement_time() const { return 0; }
 
     /* The following three methods should become functions as they
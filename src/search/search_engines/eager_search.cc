@@ -6,6 +6,7 @@
 #include "../open_list_factory.h"
 #include "../option_parser.h"
 #include "../pruning_method.h"
+#include "../search_profiler.h"
 
 #include "../algorithms/ordered_set.h"
 #include "../task_utils/successor_generator.h"
@@ -29,7 +30,8 @@ EagerSearch::EagerSearch(const Options &opts)
       f_evaluator(opts.get<Evaluator *>("f_eval", nullptr)),
       preferred_operator_evaluators(opts.get_list<Evaluator *>("preferred")),
       lazy_evaluator(opts.get<Evaluator *>("lazy_evaluator", nullptr)),
-      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")) {
+      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")),
+      successor_evaluator(opts) {
     if (lazy_evaluator && !lazy_evaluator->does_cache_estimates()) {
         cerr << "lazy_evaluator must cache its estimates" << endl;
         utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
@@ -168,7 +170,14 @@ SearchStatus EagerSearch::step() {
           TODO: When preferred operators are in use, a preferred operator will be
           considered by the preferred operator queues even when it is pruned.
         */
-        pruning_method->prune_operators(s, applicable_ops);
+        {
+            SearchProfiler::ScopedTimer timer(
+                g_search_profiler, ProfiledComponent::PRUNING);
+            pruning_method->prune_operators(s, applicable_ops);
+        }
+
+        if (successor_evaluator.is_enabled())
+            evaluate_successors_in_parallel(s, applicable_ops, node.get_real_g());
     
         // This evaluates the expanded state (again) to get preferred ops
         EvaluationContext eval_context(s, node.get_g(), false, &statistics, true);
@@ -241,20 +250,16 @@ SearchStatus EagerSearch::step() {
     
                     /*
                       Note: our old code used to retrieve the h value from
-                      the search node here. Our new code recomputes it as
+                      the search node here. Our new code evaluates it again as
                       necessary, thus avoiding the incredible ugliness of
                       the old "set_evaluator_value" approach, which also
                       did not generalize properly to settings with more
                       than one evaluator.
     
-                      Reopening should not happen all that frequently, so
-                      the performance impact of this is hopefully not that
-                      large. In the medium term, we want the evaluators to
-                      remember evaluator values for states themselves if
-                      desired by the user, so that such recomputations
-                      will just involve a look-up by the Evaluator object
-                      rather than a recomputation of the evaluator value
-                      from scratch.
+                      Heuristics that cache their estimates (cache_estimates=true,
+                      the default) look up the value stored when the state was
+                      first evaluated, so this only recomputes the values of
+                      evaluators without such a cache.
                     */
                     open_list->insert(eval_context, succ_state.get_id());
                 } else {
@@ -270,6 +275,26 @@ SearchStatus EagerSearch::step() {
     return IN_PROGRESS;
 }
 
+void EagerSearch::evaluate_successors_in_parallel(
+    const GlobalState &state, const vector<OperatorID> &applicable_ops, int g) {
+    /*
+      Register the successors first, so that the values of the parallel
+      evaluators can be computed for all new successors at once. The
+      successor loop in step() then finds the registered states and the
+      cached values.
+    */
+    vector<GlobalState> new_succ_states;
+    for (OperatorID op_id : applicable_ops) {
+        OperatorProxy op = task_proxy.get_operators()[op_id];
+        if ((g + op.get_cost()) >= bound)
+            continue;
+        GlobalState succ_state = state_registry.get_successor_state(state, op);
+        if (search_space.get_node(succ_state).is_new())
+            new_succ_states.push_back(succ_state);
+    }
+    successor_evaluator.evaluate(new_succ_states, statistics);
+}
+
 pair<SearchNode, bool> EagerSearch::fetch_next_node() {
     /* TODO: The bulk of this code deals with multi-path dependence,
        which is a bit unfortunate since that is a special case that
@@ -1,6 +1,8 @@
 #ifndef SEARCH_ENGINES_EAGER_SEARCH_H
 #define SEARCH_ENGINES_EAGER_SEARCH_H
 
+#include "parallel_successor_evaluator.h"
+
 #include "../open_list.h"
 #include "../search_engine.h"
 
@@ -28,6 +30,11 @@ class EagerSearch : public SearchEngine {
 
     std::shared_ptr<PruningMethod> pruning_method;
 
+    parallel_successor_evaluator::ParallelSuccessorEvaluator successor_evaluator;
+    void evaluate_successors_in_parallel(
+        const GlobalState &state, const std::vector<OperatorID> &applicable_ops,
+        int g);
+
     std::pair<SearchNode, bool> fetch_next_node();
     void start_f_value_statistics(EvaluationContext &eval_context);
     void update_f_value_statistics(const SearchNode &node);
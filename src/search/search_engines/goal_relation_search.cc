@@ -7,7 +7,10 @@
 #include "../tasks/root_task.h"
 #include "../task_utils/successor_generator.h"
 #include "../heuristic.h"
+#include "../search_profiler.h"
 
+#include "../utils/logging.h"
+#include "../utils/memory.h"
 #include "../utils/timer.h"
 
 #include "../goal_relation/topdownMUGStree.h"
@@ -27,6 +30,7 @@ GoalRelationSearch::GoalRelationSearch(const Options &opts)
         continue_on_fail(opts.get<bool>("continue_on_fail")),
         continue_on_solve(opts.get<bool>("continue_on_solve")),
         all_soft_goals(opts.get<bool>("all_soft_goals")),
+        silence_subsearches(opts.get<bool>("silence_subsearches")),
         meta_search_type(static_cast<MetaSearchType>(opts.get<int>("metasearch"))),
         phase(0),
         //algo_phase(1),
@@ -116,9 +120,15 @@ SearchStatus GoalRelationSearch::step() {
     //static const unsigned print_status_every = 1;
     static utils::Timer search_timer; search_timer.resume();
 
-    std::cout.setstate(std::ios::failbit);
-    current_search->search();
-    std::cout.clear() ;
+    {
+        unique_ptr<utils::SilentBlock> silent_block;
+        if (silence_subsearches) {
+            silent_block = utils::make_unique_ptr<utils::SilentBlock>(cout);
+        }
+        current_search->search();
+    }
+    g_search_profiler.record_event(
+        TraceEventType::SUBSEARCH_FINISHED, current_search->found_solution());
 
     search_timer.stop();
     num_executed_searched++;
@@ -216,9 +226,9 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
     parser.document_synopsis("Iterated search", "");
     parser.document_note(
         "Note 1",
-        "We don't cache heuristic values between search iterations at"
-        " the moment. If you perform a LAMA-style iterative search,"
-        " heuristic values will be computed multiple times.");
+        "Heuristic values are not cached between search iterations, "
+        "because each iteration searches for different goals and the cached "
+        "values would be wrong. Each iteration uses its own state registry.");
     parser.document_note(
         "Note 2",
         "The configuration\n```\n"
@@ -253,6 +263,11 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
     parser.add_option<bool>("all_soft_goals",
                             "TODO",
                             "false");
+    parser.add_option<bool>("silence_subsearches",
+                            "discard the output of the searches for the "
+                            "goal subsets; use the profile_file option to "
+                            "record their progress instead",
+                            "true");
     parser.add_list_option<Evaluator*>("heu", "reference to heuristic to update abstract task");
     vector<string> meta_search_types;
     meta_search_types.push_back("TOPDOWNMUGSSEARCH");
@@ -18,6 +18,7 @@ class GoalRelationSearch : public SearchEngine {
     bool continue_on_fail;
     bool continue_on_solve;
     bool all_soft_goals;
+    const bool silence_subsearches;
     std::vector<Heuristic *> heuristic;
 
     MetaSearchType meta_search_type;
@@ -15,6 +15,7 @@ IteratedSearch::IteratedSearch(const Options &opts)
       repeat_last_phase(opts.get<bool>("repeat_last")),
       continue_on_fail(opts.get<bool>("continue_on_fail")),
       continue_on_solve(opts.get<bool>("continue_on_solve")),
+      share_state_registry(opts.get<bool>("share_state_registry")),
       phase(0),
       last_phase_found_solution(false),
       best_bound(bound),
@@ -24,8 +25,12 @@ IteratedSearch::IteratedSearch(const Options &opts)
 
 shared_ptr<SearchEngine> IteratedSearch::get_search_engine(
     int engine_configs_index) {
+    if (share_state_registry) {
+        SearchEngine::set_registry_for_new_engines(shared_state_registry);
+    }
     OptionParser parser(engine_configs[engine_configs_index], false);
     shared_ptr<SearchEngine> engine(parser.start_parsing<shared_ptr<SearchEngine>>());
+    SearchEngine::set_registry_for_new_engines(nullptr);
 
     cout << "Starting search: ";
     kptree::print_tree_bracketed(engine_configs[engine_configs_index], cout);
@@ -131,9 +136,13 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
     parser.document_synopsis("Iterated search", "");
     parser.document_note(
         "Note 1",
-        "We don't cache heuristic values between search iterations at"
-        " the moment. If you perform a LAMA-style iterative search,"
-        " heuristic values will be computed multiple times.");
+        "By default, each iteration uses its own state registry, so "
+        "heuristic values are computed again in each iteration. With "
+        "share_state_registry=true, all iterations register their states in "
+        "the registry of the iterated search. Heuristics that are reused "
+        "between iterations (see Note 2) and cache their estimates then look "
+        "up the values computed in earlier iterations. The statistics of the "
+        "iterations count the states registered by earlier iterations.");
     parser.document_note(
         "Note 2",
         "The configuration\n```\n"
@@ -151,9 +160,9 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
     parser.document_note(
         "Note 3",
         "If you reuse the same landmark count heuristic "
-        "(using heuristic predefinition) between iterations, "
-        "the path data (that is, landmark status for each visited state) "
-        "will be saved between iterations.");
+        "(using heuristic predefinition) between iterations and use "
+        "share_state_registry=true, the path data (that is, landmark status "
+        "for each visited state) will be saved between iterations.");
     parser.add_list_option<ParseTree>("engine_configs",
                                       "list of search engines for each phase");
     parser.add_option<bool>(
@@ -170,6 +179,9 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
     parser.add_option<bool>("continue_on_solve",
                             "continue search after solution found",
                             "true");
+    parser.add_option<bool>("share_state_registry",
+                            "let all iterations use the same state registry",
+                            "false");
     SearchEngine::add_options_to_parser(parser);
     Options opts = parser.parse();
 
@@ -15,6 +15,7 @@ class IteratedSearch : public SearchEngine {
     bool repeat_last_phase;
     bool continue_on_fail;
     bool continue_on_solve;
+    bool share_state_registry;
 
     int phase;
     bool last_phase_found_solution;
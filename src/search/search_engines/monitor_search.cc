@@ -6,6 +6,7 @@
 #include "../open_list_factory.h"
 #include "../option_parser.h"
 #include "../pruning_method.h"
+#include "../search_profiler.h"
 #include "../plugin.h"
 #include "search_common.h"
 
@@ -190,7 +191,14 @@ SearchStatus MonitorSearch::step() {
 
             bool new_automaton_state_reached;
             //cout << succ_state.get_id() << ": new automaton state reached: " << new_automaton_state_reached << endl;
-            if(pruning_method->prune_state(s.get_id(), succ_state, &new_automaton_state_reached)){
+            bool pruned;
+            {
+                SearchProfiler::ScopedTimer timer(
+                    g_search_profiler, ProfiledComponent::PRUNING);
+                pruned = pruning_method->prune_state(
+                    s.get_id(), succ_state, &new_automaton_state_reached);
+            }
+            if (pruned) {
                 //cout << "*************************** PRUNE *****************" << endl;
                 continue;
             }
@@ -258,20 +266,16 @@ SearchStatus MonitorSearch::step() {
     
                     /*
                       Note: our old code used to retrieve the h value from
-                      the search node here. Our new code recomputes it as
+                      the search node here. Our new code evaluates it again as
                       necessary, thus avoiding the incredible ugliness of
                       the old "set_evaluator_value" approach, which also
                       did not generalize properly to settings with more
                       than one evaluator.
     
-                      Reopening should not happen all that frequently, so
-                      the performance impact of this is hopefully not that
-                      large. In the medium term, we want the evaluators to
-                      remember evaluator values for states themselves if
-                      desired by the user, so that such recomputations
-                      will just involve a look-up by the Evaluator object
-                      rather than a recomputation of the evaluator value
-                      from scratch.
+                      Heuristics that cache their estimates (cache_estimates=true,
+                      the default) look up the value stored when the state was
+                      first evaluated, so this only recomputes the values of
+                      evaluators without such a cache.
                     */
                     open_list->insert(eval_context, succ_state.get_id());
                 } else {
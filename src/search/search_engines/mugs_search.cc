@@ -6,15 +6,22 @@
 #include "../open_list_factory.h"
 #include "../option_parser.h"
 #include "../pruning_method.h"
+#include "../search_profiler.h"
 #include "../plugin.h"
 #include "search_common.h"
 
 #include "../algorithms/ordered_set.h"
 #include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
 #include "../heuristic.h"
 #include "../evaluators/combining_evaluator.h"
+#include "../conflict_driven_learning/mugs_heuristic.h"
+#include "../heuristics/mugs_hmax_heuristic.h"
+#include "../pruning/mugs_pruning.h"
+#include "../utils/hash.h"
 
 #include <cassert>
+#include <cmath>
 #include <cstdlib>
 #include <memory>
 #include <set>
@@ -31,12 +38,64 @@ MugsSearch::MugsSearch(const Options &opts)
       f_evaluator(opts.get<Evaluator *>("f_eval", nullptr)),
       preferred_operator_evaluators(opts.get_list<Evaluator *>("preferred")),
       lazy_evaluator(opts.get<Evaluator *>("lazy_evaluator", nullptr)),
-      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")) {
+      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")),
+      successor_evaluator(opts),
+      hash_compaction(opts.get<bool>("hash_compaction")),
+      fingerprint_seed(opts.get<int>("fingerprint_seed")),
+      state_packer(nullptr),
+      fingerprint_memory_reporter(
+          "state fingerprints", [this]() {return fingerprints.get_num_bytes();}),
+      compacted_stack_memory_reporter(
+          "hash compaction stack", [this]() {
+              return compacted_stack.capacity() *
+              sizeof(int_packer::IntPacker::Bin);
+          }) {
     if (lazy_evaluator && !lazy_evaluator->does_cache_estimates()) {
         cerr << "lazy_evaluator must cache its estimates" << endl;
         utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
     }
+    if (hash_compaction) {
+        verify_hash_compaction_support(opts);
+    }
+}
+
+static bool computes_mugs(Evaluator *evaluator) {
+    return dynamic_cast<conflict_driven_learning::mugs::MugsHeuristic *>(evaluator) ||
+           dynamic_cast<mugs_hmax_heuristic::MugsHmaxHeuristic *>(evaluator);
+}
 
+void MugsSearch::verify_hash_compaction_support(const Options &opts) const {
+    /*
+      The compacted search neither evaluates states nor keeps their g
+      values. Heuristics that compute the MUGS while evaluating states
+      (and apply the cost bound to the g values) would silently report
+      nothing, so the MUGS must come from the pruning method.
+    */
+    if (!dynamic_cast<mugs_pruning::MugsPruning *>(pruning_method.get())) {
+        cerr << "hash_compaction requires a mugs pruning method, since the "
+             << "evaluators are not used" << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+    vector<Evaluator *> evaluators = preferred_operator_evaluators;
+    if (opts.contains("eval")) {
+        evaluators.push_back(opts.get<Evaluator *>("eval"));
+    }
+    if (opts.contains("evals")) {
+        for (Evaluator *evaluator : opts.get_list<Evaluator *>("evals")) {
+            evaluators.push_back(evaluator);
+        }
+    }
+    if (lazy_evaluator) {
+        evaluators.push_back(lazy_evaluator);
+    }
+    for (Evaluator *evaluator : evaluators) {
+        if (computes_mugs(evaluator)) {
+            cerr << "hash_compaction does not evaluate states, so the MUGS "
+                 << "cannot be computed by " << evaluator->get_description()
+                 << "; use mugs_pruning instead" << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+        }
+    }
 }
 
 void MugsSearch::initialize() {
@@ -57,6 +116,11 @@ void MugsSearch::initialize() {
     cout << "Num operators: " << task_proxy.get_operators().size() << endl;
     cout << "**************** EAGER SEARCH Goals ****************" << endl;
 
+    if (hash_compaction) {
+        initialize_hash_compaction();
+        return;
+    }
+
     set<Evaluator *> evals;
     open_list->get_path_dependent_evaluators(evals);
 
@@ -120,6 +184,51 @@ void MugsSearch::initialize() {
     //cout << "Init finished" << endl;
 }
 
+void MugsSearch::initialize_hash_compaction() {
+    // Successors are computed from State objects, which do not support axioms.
+    task_properties::verify_no_axioms(task_proxy);
+    cout << "Using hash compaction with fingerprint seed "
+         << fingerprint_seed << endl;
+
+    state_packer = &task_properties::g_state_packers[task.get()];
+    State initial_state = task_proxy.get_initial_state();
+    pruning_method->initialize(task);
+    pruning_method->prune_state(initial_state);
+    fingerprints.insert(compute_fingerprint(initial_state));
+    push_compacted_state(initial_state);
+}
+
+void MugsSearch::push_compacted_state(const State &state) {
+    int num_bins = state_packer->get_num_bins();
+    compacted_stack.resize(compacted_stack.size() + num_bins, 0);
+    int_packer::IntPacker::Bin *buffer =
+        &compacted_stack[compacted_stack.size() - num_bins];
+    int num_vars = state.size();
+    for (int var = 0; var < num_vars; ++var) {
+        state_packer->set(buffer, var, state[var].get_value());
+    }
+}
+
+State MugsSearch::pop_compacted_state() {
+    int num_bins = state_packer->get_num_bins();
+    const int_packer::IntPacker::Bin *buffer =
+        &compacted_stack[compacted_stack.size() - num_bins];
+    int num_vars = task_proxy.get_variables().size();
+    vector<int> values(num_vars);
+    for (int var = 0; var < num_vars; ++var) {
+        values[var] = state_packer->get(buffer, var);
+    }
+    compacted_stack.resize(compacted_stack.size() - num_bins);
+    return State(*task, move(values));
+}
+
+uint64_t MugsSearch::compute_fingerprint(const State &state) const {
+    utils::HashState hash_state;
+    utils::feed(hash_state, fingerprint_seed);
+    utils::feed(hash_state, state.get_values());
+    return hash_state.get_hash64();
+}
+
 void MugsSearch::print_checkpoint_line(int ) const { //g) const {
     /*
     cout << "[g=" << g << ", ";
@@ -131,12 +240,30 @@ void MugsSearch::print_checkpoint_line(int ) const { //g) const {
 void MugsSearch::print_statistics() const {
     
     statistics.print_detailed_statistics();
-    search_space.print_statistics();
+    if (hash_compaction) {
+        double num_fingerprints = fingerprints.size();
+        cout << "Stored fingerprints: " << fingerprints.size() << endl;
+        cout << "Fingerprint table size: " << fingerprints.get_num_bytes()
+             << " bytes" << endl;
+        /*
+          A state is only missed if its fingerprint collides with the
+          fingerprint of another reached state. By the birthday bound, this
+          happens with probability at most n^2 / 2^65 for n reached states.
+        */
+        cout << "Probability of a fingerprint collision: at most "
+             << min(1.0, ldexp(num_fingerprints * num_fingerprints, -65))
+             << endl;
+    } else {
+        search_space.print_statistics();
+    }
     pruning_method->print_statistics();
     
 }
 
 SearchStatus MugsSearch::step() {
+    if (hash_compaction)
+        return compacted_step();
+
     pair<SearchNode, bool> n = fetch_next_node();
     if (!n.second) {
         return FAILED;
@@ -172,13 +299,17 @@ SearchStatus MugsSearch::step() {
           considered by the preferred operator queues even when it is pruned.
         */
         //pruning_method->prune_operators(s, applicable_ops);
+
+        if (successor_evaluator.is_enabled())
+            prune_and_evaluate_successors_in_parallel(s, applicable_ops);
     
         // This evaluates the expanded state (again) to get preferred ops
         EvaluationContext eval_context(s, node.get_g(), false, &statistics, true);
         ordered_set::OrderedSet<OperatorID> preferred_operators =
             collect_preferred_operators(eval_context, preferred_operator_evaluators);
     
-        for (OperatorID op_id : applicable_ops) {
+        for (size_t i = 0; i < applicable_ops.size(); ++i) {
+            OperatorID op_id = applicable_ops[i];
             OperatorProxy op = task_proxy.get_operators()[op_id];
             //if ((node.get_real_g() + op.get_cost()) >= bound)
             //    continue;
@@ -188,7 +319,15 @@ SearchStatus MugsSearch::step() {
             GlobalState succ_state = state_registry.get_successor_state(s, op);
 
             //check_goal_and_set_plan(succ_state);
-            if(pruning_method->prune_state(succ_state)){
+            bool pruned;
+            if (successor_evaluator.is_enabled()) {
+                pruned = successor_pruned[i];
+            } else {
+                SearchProfiler::ScopedTimer timer(
+                    g_search_profiler, ProfiledComponent::PRUNING);
+                pruned = pruning_method->prune_state(succ_state);
+            }
+            if (pruned) {
                 //cout << "*************************** PRUNE *****************" << endl;
                 continue;
             }
@@ -253,20 +392,16 @@ SearchStatus MugsSearch::step() {
     
                     /*
                       Note: our old code used to retrieve the h value from
-                      the search node here. Our new code recomputes it as
+                      the search node here. Our new code evaluates it again as
                       necessary, thus avoiding the incredible ugliness of
                       the old "set_evaluator_value" approach, which also
                       did not generalize properly to settings with more
                       than one evaluator.
     
-                      Reopening should not happen all that frequently, so
-                      the performance impact of this is hopefully not that
-                      large. In the medium term, we want the evaluators to
-                      remember evaluator values for states themselves if
-                      desired by the user, so that such recomputations
-                      will just involve a look-up by the Evaluator object
-                      rather than a recomputation of the evaluator value
-                      from scratch.
+                      Heuristics that cache their estimates (cache_estimates=true,
+                      the default) look up the value stored when the state was
+                      first evaluated, so this only recomputes the values of
+                      evaluators without such a cache.
                     */
                     open_list->insert(eval_context, succ_state.get_id());
                 } else {
@@ -282,6 +417,105 @@ SearchStatus MugsSearch::step() {
     return IN_PROGRESS;
 }
 
+SearchStatus MugsSearch::compacted_step() {
+    if (compacted_stack.empty()) {
+        cout << "Completely explored state space -- no solution!" << endl;
+        return FAILED;
+    }
+    State state = pop_compacted_state();
+    // Every state on the stack was unpacked correctly and recorded.
+    assert(fingerprints.contains(compute_fingerprint(state)));
+    statistics.inc_expanded();
+
+    if (task_properties::is_goal_state(task_proxy, state)) {
+        /*
+          All goals are reachable, so there are no unsolvable goal subsets.
+          Without parent pointers, we cannot extract a plan.
+        */
+        cout << "Goal state reached -- no plan is stored with hash "
+             << "compaction." << endl;
+        return FAILED;
+    }
+
+    vector<OperatorID> applicable_ops;
+    g_successor_generator->generate_applicable_ops(state, applicable_ops);
+    for (OperatorID op_id : applicable_ops) {
+        State succ_state =
+            state.get_successor(task_proxy.get_operators()[op_id]);
+        statistics.inc_generated();
+        if (!fingerprints.insert(compute_fingerprint(succ_state)))
+            continue;
+        bool pruned;
+        {
+            SearchProfiler::ScopedTimer timer(
+                g_search_profiler, ProfiledComponent::PRUNING);
+            pruned = pruning_method->prune_state(succ_state);
+        }
+        if (pruned)
+            continue;
+        statistics.inc_evaluated_states();
+        push_compacted_state(succ_state);
+    }
+    return IN_PROGRESS;
+}
+
+void MugsSearch::prune_and_evaluate_successors_in_parallel(
+    const GlobalState &state, const vector<OperatorID> &applicable_ops) {
+    /*
+      Register and prune the successors first, so that the values of the
+      parallel evaluators can be computed for all new successors that
+      survive pruning at once. The successor loop in step() then finds the
+      registered states, the pruning results and the cached values. The
+      successors are pruned in the same order as in the loop.
+    */
+    successor_pruned.assign(applicable_ops.size(), false);
+    vector<GlobalState> new_succ_states;
+    for (size_t i = 0; i < applicable_ops.size(); ++i) {
+        OperatorProxy op = task_proxy.get_operators()[applicable_ops[i]];
+        GlobalState succ_state = state_registry.get_successor_state(state, op);
+        {
+            SearchProfiler::ScopedTimer timer(
+                g_search_profiler, ProfiledComponent::PRUNING);
+            successor_pruned[i] = pruning_method->prune_state(succ_state);
+        }
+        if (!successor_pruned[i] && search_space.get_node(succ_state).is_new())
+            new_succ_states.push_back(succ_state);
+    }
+    successor_evaluator.evaluate(new_succ_states, statistics);
+}
+
+void MugsSearch::add_hash_compaction_options(OptionParser &parser) {
+    parser.document_note(
+        "Hash compaction",
+        "With hash_compaction=true, the search stores a 64-bit fingerprint "
+        "of each reached state instead of the state and its search node, "
+        "which reduces the memory for the closed list to 11-22 bytes "
+        "per state. States are expanded in depth-first order and no plans "
+        "are extracted. The unexpanded states are kept on the depth-first "
+        "stack in the packed format of the state registry, so each of them "
+        "needs as much memory as a registered state (without search node). "
+        "The stack holds up to (branching factor) x (depth) states. "
+        "States are not evaluated, so the minimal unsolvable goal subsets "
+        "must be computed by mugs_pruning() (or hc_mugs_pruning()); "
+        "configurations whose evaluators compute them, like mugs_hc() or "
+        "mugs_hmax(), are rejected. The set of minimal unsolvable goal subsets does not "
+        "depend on the expansion order, but a fingerprint collision can "
+        "make the search miss states and report too many unsolvable "
+        "subsets. The probability of a collision is printed with the "
+        "statistics; running the search again with a different "
+        "fingerprint_seed reduces the risk further. Tasks with axioms are "
+        "not supported.",
+        true);
+    parser.add_option<bool>(
+        "hash_compaction",
+        "store only fingerprints of the reached states",
+        "false");
+    parser.add_option<int>(
+        "fingerprint_seed",
+        "seed of the hash function for the fingerprints",
+        "0");
+}
+
 pair<SearchNode, bool> MugsSearch::fetch_next_node() {
     /* TODO: The bulk of this code deals with multi-path dependence,
        which is a bit unfortunate since that is a special case that
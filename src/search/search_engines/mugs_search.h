@@ -1,9 +1,17 @@
 #ifndef SEARCH_ENGINES_MUGS_SEARCH_H
 #define SEARCH_ENGINES_MUGS_SEARCH_H
 
+#include "parallel_successor_evaluator.h"
+
 #include "../open_list.h"
 #include "../search_engine.h"
 
+#include "../algorithms/fingerprint_set.h"
+#include "../algorithms/int_packer.h"
+
+#include "../utils/memory_accounting.h"
+
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -11,6 +19,7 @@ class Evaluator;
 class PruningMethod;
 
 namespace options {
+class OptionParser;
 class Options;
 }
 
@@ -28,6 +37,39 @@ class MugsSearch : public SearchEngine {
 
     std::shared_ptr<PruningMethod> pruning_method;
 
+    parallel_successor_evaluator::ParallelSuccessorEvaluator successor_evaluator;
+
+    /*
+      In hash compaction mode, the search only stores a 64-bit fingerprint
+      of every reached state instead of the state itself and its search
+      node. States are expanded in depth-first order and the unexpanded
+      states are kept on a stack, packed like in a state registry, i.e.,
+      the stack uses get_num_bins() bins per state. Two states with the
+      same fingerprint are treated as duplicates, so a collision can cause
+      the search to miss states.
+
+      The evaluators are not evaluated in this mode, so the minimal
+      unsolvable goal subsets must be computed by a MugsPruning method.
+    */
+    const bool hash_compaction;
+    const int fingerprint_seed;
+    fingerprint_set::FingerprintSet fingerprints;
+    const int_packer::IntPacker *state_packer;
+    std::vector<int_packer::IntPacker::Bin> compacted_stack;
+    utils::MemoryReporter fingerprint_memory_reporter;
+    utils::MemoryReporter compacted_stack_memory_reporter;
+
+    void verify_hash_compaction_support(const options::Options &opts) const;
+    std::uint64_t compute_fingerprint(const State &state) const;
+    void push_compacted_state(const State &state);
+    State pop_compacted_state();
+    void initialize_hash_compaction();
+    SearchStatus compacted_step();
+    // successor_pruned[i] is the pruning result for applicable_ops[i].
+    std::vector<bool> successor_pruned;
+    void prune_and_evaluate_successors_in_parallel(
+        const GlobalState &state, const std::vector<OperatorID> &applicable_ops);
+
     std::pair<SearchNode, bool> fetch_next_node();
     void start_f_value_statistics(EvaluationContext &eval_context);
     void update_f_value_statistics(const SearchNode &node);
@@ -45,6 +87,8 @@ public:
     virtual void print_statistics() const override;
 
     void dump_search_space() const;
+
+    static void add_hash_compaction_options(options::OptionParser &parser);
 };
 }
 
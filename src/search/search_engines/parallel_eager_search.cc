@@ -0,0 +1,416 @@
+#include "parallel_eager_search.h"
+
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+#include "../globals.h"
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../options/predefinitions.h"
+
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/countdown_timer.h"
+#include "../utils/hash.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <set>
+#include <thread>
+
+using namespace std;
+
+namespace parallel_eager_search {
+// Check the time limit only every few iterations to avoid clock calls.
+static const int TIMER_CHECK_INTERVAL = 100;
+
+ParallelEagerSearch::MessageQueue::MessageQueue()
+    : head(nullptr) {
+}
+
+ParallelEagerSearch::MessageQueue::~MessageQueue() {
+    Message *message = take_all();
+    while (message) {
+        Message *next = message->next;
+        delete message;
+        message = next;
+    }
+}
+
+void ParallelEagerSearch::MessageQueue::push(Message *message) {
+    message->next = head.load(memory_order_relaxed);
+    while (!head.compare_exchange_weak(
+               message->next, message,
+               memory_order_release, memory_order_relaxed)) {
+    }
+}
+
+ParallelEagerSearch::Message *ParallelEagerSearch::MessageQueue::take_all() {
+    // Taking the whole list at once avoids the ABA problem of single pops.
+    return head.exchange(nullptr, memory_order_acquire);
+}
+
+
+ParallelEagerSearch::ParallelEagerSearch(const Options &opts)
+    : SearchEngine(opts),
+      num_threads(opts.get<int>("num_threads") == 0 ?
+                  max(1u, thread::hardware_concurrency()) :
+                  opts.get<int>("num_threads")),
+      num_outstanding(0),
+      incumbent_cost(bound),
+      search_aborted(false),
+      goal_thread(-1),
+      goal_id(StateID::no_state) {
+    /*
+      The axiom evaluator keeps its working data in the (shared) task
+      information and hence cannot be used by several threads at once.
+    */
+    task_properties::verify_no_axioms(task_proxy);
+
+    /*
+      Parsing is not thread-safe, so all evaluators and registries are
+      created up front. Creating the registries here also creates the
+      state packer and the successor generator before the threads start.
+    */
+    const options::ParseTree &eval_config = opts.get<options::ParseTree>("eval");
+    for (int i = 0; i < num_threads; ++i) {
+        options::OptionParser parser(eval_config, false);
+        unique_ptr<Worker> worker(new Worker());
+        worker->evaluator = parser.start_parsing<Evaluator *>();
+        set<Evaluator *> path_dependent_evaluators;
+        worker->evaluator->get_path_dependent_evaluators(path_dependent_evaluators);
+        if (!path_dependent_evaluators.empty()) {
+            cerr << "Parallel A* does not support path-dependent evaluators, "
+                 << "because a state and its parent can belong to different "
+                 << "threads." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+        }
+        worker->registry.reset(
+            new StateRegistry(
+                *task, state_registry.get_spill_directory(),
+                state_registry.uses_compressed_states()));
+        workers.push_back(move(worker));
+    }
+}
+
+ParallelEagerSearch::~ParallelEagerSearch() {
+}
+
+/*
+  Return the name of a predefined evaluator that the configuration refers
+  to or the empty string if there is none. Such evaluators would be shared
+  by all threads.
+*/
+static string find_predefined_evaluator(const options::ParseTree &config) {
+    const auto *predefinitions =
+        options::Predefinitions<Evaluator *>::instance();
+    for (auto it = config.begin(); it != config.end(); ++it) {
+        if (config.number_of_children(it) == 0 &&
+            predefinitions->contains(it->value)) {
+            return it->value;
+        }
+    }
+    return "";
+}
+
+int ParallelEagerSearch::get_owner(
+    const PackedStateBin *buffer, int bins_per_state) const {
+    utils::HashState hash_state;
+    for (int i = 0; i < bins_per_state; ++i) {
+        hash_state.feed(buffer[i]);
+    }
+    /*
+      The registries use the lower 32 bits of the hash for their hash
+      tables. Using the upper bits here keeps the states of each shard
+      spread over all buckets.
+    */
+    uint32_t hash = hash_state.get_hash64() >> 32;
+    return hash % num_threads;
+}
+
+void ParallelEagerSearch::initialize() {
+    cout << "Conducting parallel A* search with " << num_threads
+         << " thread(s), (real) bound = " << bound << endl;
+    Message *message = new Message();
+    state_registry.get_packed_state(
+        state_registry.get_initial_state(), message->buffer);
+    message->g = 0;
+    int owner = get_owner(message->buffer.data(), message->buffer.size());
+    // Every thread starts active and the initial state is in transit.
+    num_outstanding = num_threads + 1;
+    workers[owner]->inbox.push(message);
+}
+
+void ParallelEagerSearch::send(
+    int sender, const GlobalState &parent, OperatorID op_id, int g) {
+    Worker &worker = *workers[sender];
+    OperatorProxy op = task_proxy.get_operators()[op_id];
+    Message &local_message = worker.local_message;
+    worker.registry->compute_successor_buffer(parent, op, local_message.buffer);
+    int owner = get_owner(local_message.buffer.data(),
+                          local_message.buffer.size());
+    Message *message = &local_message;
+    if (owner != sender) {
+        message = new Message();
+        message->buffer = local_message.buffer;
+    }
+    message->g = g;
+    message->parent_thread = sender;
+    message->parent_id = parent.get_id();
+    message->creating_op = op_id;
+    if (owner == sender) {
+        receive(sender, *message);
+    } else {
+        num_outstanding.fetch_add(1);
+        workers[owner]->inbox.push(message);
+    }
+}
+
+void ParallelEagerSearch::receive(int thread, const Message &message) {
+    Worker &worker = *workers[thread];
+    GlobalState state = worker.registry->register_state(message.buffer.data());
+    NodeInfo &info = worker.nodes[state];
+    bool is_new = (info.g == -1);
+    if (!is_new && (info.h == -1 || info.g <= message.g)) {
+        // Dead end or no cheaper path.
+        return;
+    }
+    if (is_new) {
+        EvaluationContext eval_context(
+            state, message.g, false, &worker.statistics);
+        worker.statistics.inc_evaluated_states();
+        if (eval_context.is_evaluator_value_infinite(worker.evaluator)) {
+            info.g = message.g;
+            info.h = -1;
+            worker.statistics.inc_dead_ends();
+            return;
+        }
+        info.h = eval_context.get_evaluator_value(worker.evaluator);
+    } else {
+        // Counts all cheaper paths, also to states that are still open.
+        worker.statistics.inc_reopened();
+    }
+    info.g = message.g;
+    info.parent_thread = message.parent_thread;
+    info.parent_id = message.parent_id;
+    info.creating_op = message.creating_op;
+    int f = info.g + info.h;
+    if (f < incumbent_cost.load(memory_order_relaxed)) {
+        worker.open_list.emplace(f, info.h, info.g, state.get_id());
+    }
+}
+
+bool ParallelEagerSearch::has_open_nodes_below_incumbent(Worker &worker) {
+    /*
+      Remove entries for states that were reached more cheaply after the
+      insertion and entries that cannot lead to a cheaper plan. The
+      incumbent cost never increases, so the latter are never needed again.
+    */
+    OpenList &open_list = worker.open_list;
+    int incumbent = incumbent_cost.load(memory_order_relaxed);
+    while (!open_list.empty()) {
+        const OpenEntry &entry = open_list.top();
+        GlobalState state = worker.registry->lookup_state(entry.id);
+        if (entry.f < incumbent && entry.g == worker.nodes[state].g) {
+            return true;
+        }
+        open_list.pop();
+    }
+    return false;
+}
+
+void ParallelEagerSearch::report_goal(int thread, StateID id, int cost) {
+    lock_guard<mutex> lock(incumbent_mutex);
+    if (cost < incumbent_cost.load(memory_order_relaxed)) {
+        cout << "Thread " << thread << " found a plan with cost "
+             << cost << "." << endl;
+        incumbent_cost.store(cost, memory_order_relaxed);
+        goal_thread = thread;
+        goal_id = id;
+    }
+}
+
+void ParallelEagerSearch::expand(int thread, const OpenEntry &entry) {
+    Worker &worker = *workers[thread];
+    GlobalState state = worker.registry->lookup_state(entry.id);
+    worker.statistics.inc_expanded();
+    if (task_properties::is_goal_state(task_proxy, state)) {
+        report_goal(thread, entry.id, entry.g);
+        return;
+    }
+
+    worker.applicable_ops.clear();
+    g_successor_generator->generate_applicable_ops(state, worker.applicable_ops);
+    OperatorsProxy operators = task_proxy.get_operators();
+    for (OperatorID op_id : worker.applicable_ops) {
+        int succ_g = entry.g + get_adjusted_cost(operators[op_id]);
+        if (succ_g >= incumbent_cost.load(memory_order_relaxed))
+            continue;
+        worker.statistics.inc_generated();
+        send(thread, state, op_id, succ_g);
+    }
+}
+
+void ParallelEagerSearch::run_worker(
+    int thread, const utils::CountdownTimer &timer) {
+    Worker &worker = *workers[thread];
+    bool active = true;
+    int iterations = 0;
+    while (!search_aborted.load(memory_order_relaxed)) {
+        if (++iterations == TIMER_CHECK_INTERVAL) {
+            iterations = 0;
+            if (timer.is_expired()) {
+                search_aborted = true;
+                break;
+            }
+        }
+
+        Message *message = worker.inbox.take_all();
+        if (message && !active) {
+            // Reactivate before the received messages stop being counted.
+            num_outstanding.fetch_add(1);
+            active = true;
+        }
+        while (message) {
+            receive(thread, *message);
+            Message *next = message->next;
+            delete message;
+            message = next;
+            num_outstanding.fetch_sub(1);
+        }
+
+        if (has_open_nodes_below_incumbent(worker)) {
+            OpenEntry entry = worker.open_list.top();
+            worker.open_list.pop();
+            expand(thread, entry);
+        } else {
+            if (active) {
+                active = false;
+                num_outstanding.fetch_sub(1);
+            }
+            if (num_outstanding.load() == 0)
+                break;
+            this_thread::yield();
+        }
+    }
+}
+
+void ParallelEagerSearch::extract_plan() {
+    Plan plan;
+    int thread = goal_thread;
+    StateID id = goal_id;
+    while (true) {
+        Worker &worker = *workers[thread];
+        const NodeInfo &info =
+            worker.nodes[worker.registry->lookup_state(id)];
+        if (info.parent_thread == -1)
+            break;
+        plan.push_back(info.creating_op);
+        thread = info.parent_thread;
+        id = info.parent_id;
+    }
+    reverse(plan.begin(), plan.end());
+    set_plan(plan);
+}
+
+SearchStatus ParallelEagerSearch::step() {
+    utils::CountdownTimer timer(max_time);
+    vector<thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back(&ParallelEagerSearch::run_worker, this, i,
+                             cref(timer));
+    }
+    for (thread &t : threads) {
+        t.join();
+    }
+
+    for (const unique_ptr<Worker> &worker : workers) {
+        const SearchStatistics &stats = worker->statistics;
+        statistics.inc_expanded(stats.get_expanded());
+        statistics.inc_reopened(stats.get_reopened());
+        statistics.inc_evaluated_states(stats.get_evaluated_states());
+        statistics.inc_evaluations(stats.get_evaluations());
+        statistics.inc_generated(stats.get_generated());
+        statistics.inc_dead_ends(stats.get_dead_ends());
+    }
+
+    if (search_aborted) {
+        cout << "Time limit reached. Abort search." << endl;
+        return TIMEOUT;
+    }
+    if (goal_thread == -1) {
+        cout << "Completely explored state space -- no solution!" << endl;
+        return FAILED;
+    }
+    cout << "Solution found!" << endl;
+    extract_plan();
+    return SOLVED;
+}
+
+void ParallelEagerSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    for (int i = 0; i < num_threads; ++i) {
+        const Worker &worker = *workers[i];
+        cout << "Thread " << i << ": "
+             << worker.statistics.get_expanded() << " expanded, "
+             << worker.registry->size() << " registered state(s)" << endl;
+    }
+}
+
+static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Parallel A* search (eager)",
+        "A* search with hash-distributed state ownership (HDA*). Each thread "
+        "owns the states that hash to it, stores them in its own state "
+        "registry and expands them in order of g+h, breaking ties by h. "
+        "Successors owned by other threads are sent to them through "
+        "lock-free message queues. The search only terminates when no thread "
+        "has a node with an f-value below the best plan cost, so the plan is "
+        "optimal for admissible evaluators.");
+    parser.document_language_support("axioms", "not supported");
+    parser.document_note(
+        "Evaluators",
+        "Every thread uses its own evaluator, which is parsed from the "
+        "given configuration once per thread. Evaluators must therefore not "
+        "refer to predefined evaluators, which would be shared between the "
+        "threads, and must not be path-dependent. Both are rejected.");
+    parser.document_note(
+        "Determinism",
+        "The number of expansions and the returned plan (but not its cost) "
+        "can differ between runs, because they depend on the timing of the "
+        "threads.");
+    parser.add_option<options::ParseTree>(
+        "eval", "evaluator for h-value, instantiated once per thread");
+    parser.add_option<int>(
+        "num_threads",
+        "Number of search threads. "
+        "Set to 0 to use one thread per hardware thread.",
+        "1",
+        Bounds("0", "infinity"));
+    SearchEngine::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    if (parser.help_mode()) {
+        return nullptr;
+    }
+
+    string predefined_evaluator = find_predefined_evaluator(
+        opts.get<options::ParseTree>("eval"));
+    if (!predefined_evaluator.empty()) {
+        cerr << "Parallel A* does not support predefined evaluators, "
+             << "because they would be shared by all threads: "
+             << predefined_evaluator << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+
+    if (parser.dry_run()) {
+        options::OptionParser test_parser(
+            opts.get<options::ParseTree>("eval"), true);
+        test_parser.start_parsing<Evaluator *>();
+        return nullptr;
+    }
+    return make_shared<ParallelEagerSearch>(opts);
+}
+
+static PluginShared<SearchEngine> _plugin("parallel_astar", _parse);
+}
@@ -0,0 +1,156 @@
+#ifndef SEARCH_ENGINES_PARALLEL_EAGER_SEARCH_H
+#define SEARCH_ENGINES_PARALLEL_EAGER_SEARCH_H
+
+#include "../per_state_information.h"
+#include "../search_engine.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+class Evaluator;
+
+namespace options {
+class Options;
+}
+
+namespace utils {
+class CountdownTimer;
+}
+
+namespace parallel_eager_search {
+/*
+  A* with hash-distributed state ownership (HDA*). Every state belongs to
+  the thread selected by a hash of its packed data. Only the owner
+  registers the state in its StateRegistry shard, evaluates it and keeps
+  it in its open list. Successors of other threads are sent to their
+  owners through lock-free message queues.
+
+  A thread is idle if its queue is empty and its open list contains no
+  node with an f-value below the cost of the best plan found so far. The
+  search terminates when all threads are idle and no messages are in
+  transit. Then all nodes with an f-value below the plan cost have been
+  expanded, so the plan is optimal if the evaluator is admissible.
+*/
+class ParallelEagerSearch : public SearchEngine {
+    struct NodeInfo {
+        // g is -1 for states that were not reached yet.
+        int g;
+        // h is -1 for dead ends.
+        int h;
+        int parent_thread;
+        StateID parent_id;
+        OperatorID creating_op;
+
+        NodeInfo()
+            : g(-1), h(0), parent_thread(-1), parent_id(StateID::no_state),
+              creating_op(OperatorID::no_operator) {
+        }
+    };
+
+    struct Message {
+        std::vector<PackedStateBin> buffer;
+        int g;
+        int parent_thread;
+        StateID parent_id;
+        OperatorID creating_op;
+        Message *next;
+
+        Message()
+            : g(-1), parent_thread(-1), parent_id(StateID::no_state),
+              creating_op(OperatorID::no_operator), next(nullptr) {
+        }
+    };
+
+    // Multiple producers push single messages, the owner takes all at once.
+    class MessageQueue {
+        std::atomic<Message *> head;
+public:
+        MessageQueue();
+        ~MessageQueue();
+        void push(Message *message);
+        Message *take_all();
+    };
+
+    struct OpenEntry {
+        int f;
+        int h;
+        int g;
+        StateID id;
+
+        OpenEntry(int f, int h, int g, StateID id)
+            : f(f), h(h), g(g), id(id) {
+        }
+    };
+
+    // Order by increasing f and break ties by increasing h.
+    struct OpenEntryGreater {
+        bool operator()(const OpenEntry &lhs, const OpenEntry &rhs) const {
+            if (lhs.f != rhs.f)
+                return lhs.f > rhs.f;
+            return lhs.h > rhs.h;
+        }
+    };
+
+    using OpenList = std::priority_queue<
+        OpenEntry, std::vector<OpenEntry>, OpenEntryGreater>;
+
+    struct Worker {
+        Evaluator *evaluator;
+        std::unique_ptr<StateRegistry> registry;
+        PerStateInformation<NodeInfo> nodes;
+        OpenList open_list;
+        MessageQueue inbox;
+        SearchStatistics statistics;
+        std::vector<OperatorID> applicable_ops;
+        // Reused for successors that the thread owns itself.
+        Message local_message;
+
+        Worker()
+            : evaluator(nullptr),
+              nodes("search nodes") {
+        }
+    };
+
+    const int num_threads;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    /*
+      Number of threads that are not idle plus the number of messages in
+      transit. Senders count a message before they push it and receivers
+      reactivate before they process messages, so the counter only reaches
+      zero when the search is complete.
+    */
+    std::atomic<int> num_outstanding;
+    // Cost of the best plan found so far (initially the bound).
+    std::atomic<int> incumbent_cost;
+    std::atomic<bool> search_aborted;
+    // Protects the goal node and the updates of incumbent_cost.
+    std::mutex incumbent_mutex;
+    int goal_thread;
+    StateID goal_id;
+
+    int get_owner(const PackedStateBin *buffer, int bins_per_state) const;
+    void send(int sender, const GlobalState &parent, OperatorID op_id, int g);
+    void receive(int thread, const Message &message);
+    void expand(int thread, const OpenEntry &entry);
+    bool has_open_nodes_below_incumbent(Worker &worker);
+    void report_goal(int thread, StateID id, int cost);
+    void run_worker(int thread, const utils::CountdownTimer &timer);
+    void extract_plan();
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    explicit ParallelEagerSearch(const options::Options &opts);
+    virtual ~ParallelEagerSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
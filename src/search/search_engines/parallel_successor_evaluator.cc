@@ -0,0 +1,169 @@
+#include "parallel_successor_evaluator.h"
+
+#include "../evaluation_context.h"
+#include "../global_state.h"
+#include "../heuristic.h"
+#include "../option_parser.h"
+#include "../search_statistics.h"
+
+#include "../utils/system.h"
+#include "../utils/thread_pool.h"
+#include "../utils/thread_pool_options.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <set>
+#include <unordered_set>
+
+using namespace std;
+
+namespace parallel_successor_evaluator {
+ParallelSuccessorEvaluator::ParallelSuccessorEvaluator(const Options &opts) {
+    // Engines that are not created from a parser do not have these options.
+    if (!opts.contains("parallel_evaluators")) {
+        return;
+    }
+    vector<Evaluator *> evaluators =
+        opts.get_list<Evaluator *>("parallel_evaluators");
+    if (evaluators.empty()) {
+        return;
+    }
+    for (Evaluator *evaluator : evaluators) {
+        Heuristic *heuristic = dynamic_cast<Heuristic *>(evaluator);
+        if (!heuristic || !heuristic->does_cache_estimates()) {
+            cerr << "parallel_evaluators must be heuristics that cache "
+                 << "their estimates: " << evaluator->get_description() << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+        }
+        if (!heuristic->supports_thread_local_copies()) {
+            cerr << "parallel_evaluators must compute their estimates from "
+                 << "the state alone: " << evaluator->get_description() << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+        }
+        set<Evaluator *> path_dependent_evaluators;
+        heuristic->get_path_dependent_evaluators(path_dependent_evaluators);
+        if (!path_dependent_evaluators.empty()) {
+            cerr << "parallel_evaluators must not be path-dependent: "
+                 << evaluator->get_description() << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+        }
+        heuristics.push_back(heuristic);
+    }
+    values.resize(heuristics.size());
+
+    thread_pool = utils::parse_thread_pool_from_options(opts);
+    int num_threads = thread_pool->get_num_threads();
+    if (num_threads == 1) {
+        // Without further threads, the engine evaluates the states itself.
+        return;
+    }
+    cout << "Evaluating successors with " << num_threads << " threads" << endl;
+    copies.resize(num_threads);
+    for (vector<Heuristic *> &task_copies : copies) {
+        for (const Heuristic *heuristic : heuristics) {
+            Heuristic *copy = heuristic->create_thread_local_copy();
+            if (!copy) {
+                cerr << "Cannot create copies of parallel evaluator "
+                     << heuristic->get_description() << endl;
+                utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+            }
+            task_copies.push_back(copy);
+        }
+    }
+}
+
+ParallelSuccessorEvaluator::~ParallelSuccessorEvaluator() {
+    for (vector<Heuristic *> &task_copies : copies) {
+        for (Heuristic *copy : task_copies) {
+            delete copy;
+        }
+    }
+}
+
+void ParallelSuccessorEvaluator::evaluate(
+    const vector<GlobalState> &states, SearchStatistics &statistics) {
+    assert(is_enabled());
+    vector<const GlobalState *> pending;
+    unordered_set<StateID> pending_ids;
+    for (const GlobalState &state : states) {
+        bool is_cached = all_of(
+            heuristics.begin(), heuristics.end(),
+            [&state](const Heuristic *heuristic) {
+                return heuristic->is_estimate_cached(state);
+            });
+        if (!is_cached && pending_ids.insert(state.get_id()).second) {
+            pending.push_back(&state);
+        }
+    }
+    if (pending.empty()) {
+        return;
+    }
+
+    int num_states = pending.size();
+    int num_tasks = min(static_cast<int>(copies.size()), num_states);
+    for (vector<int> &heuristic_values : values) {
+        heuristic_values.resize(num_states);
+    }
+    // Task t evaluates a contiguous range of states with its own copies.
+    thread_pool->run(
+        num_tasks,
+        [&](int task) {
+            int begin = num_states * task / num_tasks;
+            int end = num_states * (task + 1) / num_tasks;
+            const vector<Heuristic *> &task_copies = copies[task];
+            for (int j = begin; j < end; ++j) {
+                EvaluationContext eval_context(*pending[j]);
+                for (size_t i = 0; i < task_copies.size(); ++i) {
+                    values[i][j] = eval_context.get_evaluator_value_or_infinity(
+                        task_copies[i]);
+                }
+            }
+        });
+
+    for (size_t i = 0; i < heuristics.size(); ++i) {
+        Heuristic *heuristic = heuristics[i];
+        for (int j = 0; j < num_states; ++j) {
+            if (!heuristic->is_estimate_cached(*pending[j])) {
+                heuristic->set_cached_estimate(*pending[j], values[i][j]);
+                // The engine only looks up the value, which is not counted.
+                statistics.inc_evaluations();
+            }
+        }
+    }
+}
+
+void ParallelSuccessorEvaluator::add_options_to_parser(OptionParser &parser) {
+    parser.document_note(
+        "Parallel evaluation",
+        "The heuristics given as parallel_evaluators are computed for all "
+        "new successors of an expanded state in parallel before the "
+        "successors are inserted into the open list. Every thread uses its "
+        "own copy of each heuristic, parsed from the heuristic's "
+        "configuration, so the search behaves as with sequential evaluation "
+        "as long as the heuristic values only depend on the state. "
+        "Heuristics that are refined during the search must therefore not "
+        "be evaluated in parallel. Heuristics whose values depend on the g "
+        "value or whose evaluation has side effects, like mugs_hmax(), "
+        "mugs_hc() or the lmcount synergy, are rejected. "
+        "Objects that the configurations refer to "
+        "by name are shared between the copies and must not be modified "
+        "during evaluation. Since every copy is parsed anew, it repeats the "
+        "preprocessing of the heuristic and keeps its own data, e.g., each "
+        "copy of a PDB or merge-and-shrink heuristic builds and stores its "
+        "own pattern databases or abstractions. Preprocessing time and "
+        "memory for them therefore grow with the number of threads. "
+        "Parallel evaluation pays off for heuristics that "
+        "take long to compute, like lmcut(), merge-and-shrink or operator "
+        "counting. Example:\n"
+        "```\n--evaluator h=lmcut()\n"
+        "--search astar(h, parallel_evaluators=[h], num_threads=4)\n```\n",
+        true);
+    parser.add_list_option<Evaluator *>(
+        "parallel_evaluators",
+        "heuristics that are evaluated in parallel for the successors of "
+        "each expanded state; they must cache their estimates",
+        "[]");
+    utils::add_thread_pool_options(parser);
+}
+}
@@ -0,0 +1,61 @@
+#ifndef SEARCH_ENGINES_PARALLEL_SUCCESSOR_EVALUATOR_H
+#define SEARCH_ENGINES_PARALLEL_SUCCESSOR_EVALUATOR_H
+
+#include <memory>
+#include <vector>
+
+class GlobalState;
+class Heuristic;
+class SearchStatistics;
+
+namespace options {
+class OptionParser;
+class Options;
+}
+
+namespace utils {
+class ThreadPool;
+}
+
+namespace parallel_successor_evaluator {
+/*
+  Computes the values of expensive heuristics for a batch of successor
+  states in parallel and stores them in the caches of the heuristics. The
+  search engine then evaluates the successors as usual, but the selected
+  heuristics only look up their cached values.
+
+  Heuristics are not thread-safe, so every task uses its own copy of each
+  heuristic, which is parsed from the heuristic's configuration. The
+  registry of the states must not be modified while evaluate() runs.
+*/
+class ParallelSuccessorEvaluator {
+    std::shared_ptr<utils::ThreadPool> thread_pool;
+    std::vector<Heuristic *> heuristics;
+    // copies[task][i] is the copy of heuristics[i] used by the given task.
+    std::vector<std::vector<Heuristic *>> copies;
+    /*
+      values[i][j] is the value of heuristics[i] for the j-th state to
+      evaluate. The vectors are reused across calls to evaluate().
+    */
+    std::vector<std::vector<int>> values;
+
+public:
+    explicit ParallelSuccessorEvaluator(const options::Options &opts);
+    ~ParallelSuccessorEvaluator();
+
+    bool is_enabled() const {
+        return !copies.empty();
+    }
+
+    /*
+      Compute and cache the values of all heuristics for the given states
+      unless they are cached already.
+    */
+    void evaluate(
+        const std::vector<GlobalState> &states, SearchStatistics &statistics);
+
+    static void add_options_to_parser(options::OptionParser &parser);
+};
+}
+
+#endif
@@ -25,6 +25,8 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
         "use preferred operators of these evaluators", "[]");
 
     SearchEngine::add_pruning_option(parser);
+    parallel_successor_evaluator::ParallelSuccessorEvaluator::add_options_to_parser(
+        parser);
     SearchEngine::add_options_to_parser(parser);
     Options opts = parser.parse();
 
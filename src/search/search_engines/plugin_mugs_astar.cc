@@ -36,6 +36,9 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
                             "", "false");
 
     SearchEngine::add_pruning_option(parser);
+    mugs_search::MugsSearch::add_hash_compaction_options(parser);
+    parallel_successor_evaluator::ParallelSuccessorEvaluator::add_options_to_parser(
+        parser);
     SearchEngine::add_options_to_parser(parser);
     Options opts = parser.parse();
 
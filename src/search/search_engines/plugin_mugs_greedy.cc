@@ -56,6 +56,9 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
         "boost value for preferred operator open lists", "0");
 
     SearchEngine::add_pruning_option(parser);
+    mugs_search::MugsSearch::add_hash_compaction_options(parser);
+    parallel_successor_evaluator::ParallelSuccessorEvaluator::add_options_to_parser(
+        parser);
     SearchEngine::add_options_to_parser(parser);
 
     Options opts = parser.parse();
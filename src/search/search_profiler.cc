@@ -0,0 +1,225 @@
+#include "search_profiler.h"
+
+#include "search_statistics.h"
+
+#include "utils/memory_accounting.h"
+#include "utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+SearchProfiler g_search_profiler;
+
+static const char *get_event_name(TraceEventType type) {
+    switch (type) {
+    case TraceEventType::SEARCH_STARTED:
+        return "search_started";
+    case TraceEventType::SEARCH_FINISHED:
+        return "search_finished";
+    case TraceEventType::SUBSEARCH_FINISHED:
+        return "subsearch_finished";
+    case TraceEventType::F_VALUE_JUMP:
+        return "f_value_jump";
+    case TraceEventType::NEW_BEST_VALUE:
+        return "new_best_value";
+    }
+    return "unknown";
+}
+
+static string escape_json(const string &text) {
+    ostringstream escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped << "\\u" << hex << setw(4) << setfill('0')
+                    << static_cast<int>(c) << dec;
+        } else {
+            escaped << c;
+        }
+    }
+    return escaped.str();
+}
+
+SearchProfiler::SearchProfiler()
+    : enabled(false),
+      snapshot_interval(0),
+      components(new ComponentTimes[MAX_COMPONENTS]),
+      num_components(0),
+      num_unnamed_evaluators(0),
+      trace_mask(0),
+      num_events(0) {
+    // The order must match the ProfiledComponent enum.
+    add_component("successor generation");
+    add_component("registry insert");
+    add_component("pruning");
+    add_component("monitor check");
+    components[MAX_COMPONENTS - 1].name = "further evaluators";
+}
+
+SearchProfiler::~SearchProfiler() {
+}
+
+int SearchProfiler::add_component(const string &name) {
+    if (num_components >= MAX_COMPONENTS - 1) {
+        // Use the reserved last component and report it from now on.
+        num_components = MAX_COMPONENTS;
+        return MAX_COMPONENTS - 1;
+    }
+    components[num_components].name = name;
+    return num_components++;
+}
+
+void SearchProfiler::enable(
+    const string &filename, double snapshot_interval_, int trace_size) {
+    assert(!enabled);
+    output.open(filename);
+    if (!output) {
+        cerr << "Could not open profile file " << filename << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+    snapshot_interval = snapshot_interval_;
+    uint64_t capacity = 1;
+    while (capacity < static_cast<uint64_t>(max(trace_size, 1))) {
+        capacity *= 2;
+    }
+    trace.reset(new TraceSlot[capacity]);
+    for (uint64_t i = 0; i < capacity; ++i) {
+        trace[i].sequence.store(0, memory_order_relaxed);
+    }
+    trace_mask = capacity - 1;
+    start_time = chrono::steady_clock::now();
+    last_snapshot_time = start_time;
+    enabled = true;
+    cout << "Writing profile to " << filename << endl;
+}
+
+int SearchProfiler::get_evaluator_component(const string &description) {
+    lock_guard<mutex> lock(components_mutex);
+    auto it = evaluator_components.find(description);
+    if (it != evaluator_components.end()) {
+        return it->second;
+    }
+    int component = add_component(description);
+    evaluator_components[description] = component;
+    return component;
+}
+
+int SearchProfiler::add_unnamed_evaluator_component() {
+    lock_guard<mutex> lock(components_mutex);
+    ++num_unnamed_evaluators;
+    return add_component(
+        "unnamed evaluator " + to_string(num_unnamed_evaluators));
+}
+
+uint64_t SearchProfiler::get_elapsed_nanoseconds() const {
+    return chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now() - start_time).count();
+}
+
+void SearchProfiler::record_event(TraceEventType type, int value) {
+    if (!enabled) {
+        return;
+    }
+    uint64_t position = num_events.fetch_add(1, memory_order_relaxed);
+    TraceSlot &slot = trace[position & trace_mask];
+    slot.sequence.store(0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot.nanoseconds.store(get_elapsed_nanoseconds(), memory_order_relaxed);
+    slot.type.store(static_cast<int>(type), memory_order_relaxed);
+    slot.value.store(value, memory_order_relaxed);
+    slot.sequence.store(position + 1, memory_order_release);
+}
+
+void SearchProfiler::write_components() {
+    lock_guard<mutex> lock(components_mutex);
+    output << "\"components\": {";
+    for (int i = 0; i < num_components; ++i) {
+        const ComponentTimes &times = components[i];
+        if (i != 0) {
+            output << ", ";
+        }
+        output << "\"" << escape_json(times.name) << "\": {\"seconds\": "
+               << times.nanoseconds.load(memory_order_relaxed) / 1e9
+               << ", \"calls\": " << times.calls.load(memory_order_relaxed)
+               << "}";
+    }
+    output << "}";
+}
+
+void SearchProfiler::write_memory_usage() {
+    output << "\"memory_kb\": {";
+    bool first = true;
+    utils::report_memory_usage(
+        [this, &first](const char *subsystem, size_t num_bytes) {
+            if (!first) {
+                output << ", ";
+            }
+            first = false;
+            output << "\"" << escape_json(subsystem) << "\": "
+                   << num_bytes / 1024;
+        });
+    output << "}";
+}
+
+void SearchProfiler::write_snapshot(const SearchStatistics &statistics) {
+    assert(enabled);
+    last_snapshot_time = chrono::steady_clock::now();
+    output << "{\"type\": \"snapshot\", \"time\": "
+           << get_elapsed_nanoseconds() / 1e9
+           << ", \"expanded\": " << statistics.get_expanded()
+           << ", \"evaluated\": " << statistics.get_evaluated_states()
+           << ", \"evaluations\": " << statistics.get_evaluations()
+           << ", \"generated\": " << statistics.get_generated()
+           << ", \"reopened\": " << statistics.get_reopened()
+           << ", \"dead_ends\": " << statistics.get_dead_ends()
+           << ", \"peak_memory_kb\": " << utils::get_peak_memory_in_kb()
+           << ", ";
+    write_memory_usage();
+    output << ", ";
+    write_components();
+    output << "}" << endl;
+}
+
+void SearchProfiler::write_trace() {
+    assert(enabled);
+    uint64_t end = num_events.load(memory_order_acquire);
+    uint64_t capacity = trace_mask + 1;
+    uint64_t begin = end > capacity ? end - capacity : 0;
+    for (uint64_t position = begin; position < end; ++position) {
+        const TraceSlot &slot = trace[position & trace_mask];
+        if (slot.sequence.load(memory_order_acquire) != position + 1) {
+            // The event is still being written or was overwritten.
+            continue;
+        }
+        uint64_t nanoseconds = slot.nanoseconds.load(memory_order_relaxed);
+        int type = slot.type.load(memory_order_relaxed);
+        int value = slot.value.load(memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (slot.sequence.load(memory_order_relaxed) != position + 1) {
+            continue;
+        }
+        output << "{\"type\": \"event\", \"time\": " << nanoseconds / 1e9
+               << ", \"event\": \""
+               << get_event_name(static_cast<TraceEventType>(type))
+               << "\", \"value\": " << value << "}" << endl;
+    }
+}
+
+void SearchProfiler::print_statistics() const {
+    if (!enabled) {
+        return;
+    }
+    lock_guard<mutex> lock(components_mutex);
+    for (int i = 0; i < num_components; ++i) {
+        const ComponentTimes &times = components[i];
+        cout << "Time for " << times.name << ": "
+             << times.nanoseconds.load(memory_order_relaxed) / 1e9 << "s ("
+             << times.calls.load(memory_order_relaxed) << " calls)" << endl;
+    }
+}
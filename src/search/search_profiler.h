@@ -0,0 +1,193 @@
+#ifndef SEARCH_PROFILER_H
+#define SEARCH_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class SearchStatistics;
+
+// Parts of the search whose run time is measured. Evaluators are added later.
+enum class ProfiledComponent {
+    SUCCESSOR_GENERATION,
+    REGISTRY_INSERT,
+    PRUNING,
+    MONITOR_CHECK
+};
+
+enum class TraceEventType {
+    SEARCH_STARTED,
+    // The value is the SearchStatus of the search.
+    SEARCH_FINISHED,
+    // The value is 1 if the subsearch found a solution and 0 otherwise.
+    SUBSEARCH_FINISHED,
+    // The value is the new highest expanded f value.
+    F_VALUE_JUMP,
+    // The value is the new lowest value of an evaluator.
+    NEW_BEST_VALUE
+};
+
+/*
+  Collects profiling data of the search if a profile file is given (search
+  option profile_file):
+
+  - The run time and number of calls of the components of the search (see
+    ProfiledComponent) and of every evaluator. The time of an evaluator
+    includes the time of the evaluators it calls, e.g., the time of sum([g(),
+    h]) includes the time of h.
+  - The most recent search events in a fixed-size ring buffer.
+  - Snapshots of the search statistics, component times and memory usage
+    of the subsystems (see utils::MemoryReporter), which are written
+    periodically during the search.
+
+  The snapshots and, at the end of the search, the events are written to
+  the profile file as JSON lines. Without a profile file, profiling only
+  costs a check of a flag per measurement. Timers and events may be
+  recorded from several threads.
+*/
+class SearchProfiler {
+    struct ComponentTimes {
+        std::string name;
+        std::atomic<std::uint64_t> nanoseconds;
+        std::atomic<std::uint64_t> calls;
+
+        ComponentTimes()
+            : nanoseconds(0), calls(0) {
+        }
+    };
+
+    /*
+      The components are never reallocated, so that timers can add to them
+      while other threads add components. The last component is reserved
+      for the evaluators that do not fit into the others.
+    */
+    static const int MAX_COMPONENTS = 256;
+
+    /*
+      An event is valid if its sequence number is the position of the event
+      in the trace plus one. Writers set it after the other fields, so that
+      readers can detect events that were overwritten while reading them.
+    */
+    struct TraceSlot {
+        std::atomic<std::uint64_t> sequence;
+        std::atomic<std::uint64_t> nanoseconds;
+        std::atomic<int> type;
+        std::atomic<int> value;
+    };
+
+    bool enabled;
+    std::ofstream output;
+    std::chrono::steady_clock::time_point start_time;
+    std::chrono::steady_clock::time_point last_snapshot_time;
+    double snapshot_interval;
+
+    std::unique_ptr<ComponentTimes[]> components;
+    int num_components;
+    /*
+      Heuristics are identified by their descriptions, so copies of a
+      heuristic (e.g., for other threads) share a component.
+    */
+    std::unordered_map<std::string, int> evaluator_components;
+    int num_unnamed_evaluators;
+    mutable std::mutex components_mutex;
+
+    std::unique_ptr<TraceSlot[]> trace;
+    std::uint64_t trace_mask;
+    std::atomic<std::uint64_t> num_events;
+
+    int add_component(const std::string &name);
+    std::uint64_t get_elapsed_nanoseconds() const;
+    void write_components();
+    void write_memory_usage();
+public:
+    SearchProfiler();
+    ~SearchProfiler();
+
+    /*
+      Start writing profiling data to the given file. The trace keeps the
+      last trace_size events (rounded up to a power of two).
+    */
+    void enable(const std::string &filename, double snapshot_interval,
+                int trace_size);
+
+    bool is_enabled() const {
+        return enabled;
+    }
+
+    /*
+      Return the component of the evaluator with the given description.
+      This takes a lock, so evaluators only call it once (see
+      Evaluator::get_profiler_component).
+    */
+    int get_evaluator_component(const std::string &description);
+
+    /*
+      Add a component for an evaluator without description (e.g., g() or
+      sum()), which does not share it with any other evaluator.
+    */
+    int add_unnamed_evaluator_component();
+
+    void add_time(int component, std::uint64_t nanoseconds) {
+        ComponentTimes &times = components[component];
+        times.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+        times.calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void record_event(TraceEventType type, int value = 0);
+
+    // Write a snapshot if the last one was written snapshot_interval ago.
+    void check_snapshot(const SearchStatistics &statistics) {
+        if (enabled && std::chrono::steady_clock::now() - last_snapshot_time >=
+            std::chrono::duration<double>(snapshot_interval)) {
+            write_snapshot(statistics);
+        }
+    }
+
+    void write_snapshot(const SearchStatistics &statistics);
+    void write_trace();
+    void print_statistics() const;
+
+    /*
+      Measures the time until the end of the current scope and adds it to
+      the given component.
+    */
+    class ScopedTimer {
+        SearchProfiler *profiler;
+        int component;
+        std::chrono::steady_clock::time_point start;
+    public:
+        ScopedTimer(SearchProfiler &profiler, ProfiledComponent component)
+            : ScopedTimer(profiler, static_cast<int>(component)) {
+        }
+
+        ScopedTimer(SearchProfiler &profiler_, int component)
+            : profiler(profiler_.is_enabled() ? &profiler_ : nullptr),
+              component(component) {
+            if (profiler) {
+                start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~ScopedTimer() {
+            if (profiler) {
+                auto duration = std::chrono::steady_clock::now() - start;
+                profiler->add_time(
+                    component,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        duration).count());
+            }
+        }
+
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+    };
+};
+
+extern SearchProfiler g_search_profiler;
+
+#endif
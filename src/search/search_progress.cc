@@ -2,6 +2,7 @@
 
 #include "evaluation_context.h"
 #include "evaluator.h"
+#include "search_profiler.h"
 
 #include <iostream>
 #include <string>
@@ -37,6 +38,9 @@ bool SearchProgress::check_progress(const EvaluationContext &eval_context) {
         [this, &boost](const Evaluator *eval, const EvaluationResult &result) {
             if (eval->is_used_for_reporting_minima() || eval->is_used_for_boosting()) {
                 if (process_evaluator_value(eval, result.get_evaluator_value())) {
+                    g_search_profiler.record_event(
+                        TraceEventType::NEW_BEST_VALUE,
+                        result.get_evaluator_value());
                     if (eval->is_used_for_reporting_minima()) {
                         eval->report_new_minimum_value(result);
                     }
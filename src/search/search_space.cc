@@ -121,7 +121,8 @@ void SearchNode::dump(const TaskProxy &task_proxy) const {
 }
 
 SearchSpace::SearchSpace(StateRegistry &state_registry, OperatorCost cost_type)
-    : state_registry(state_registry),
+    : search_node_infos("search nodes"),
+      state_registry(state_registry),
       cost_type(cost_type) {
 }
 
@@ -1,5 +1,7 @@
 #include "search_statistics.h"
 
+#include "search_profiler.h"
+
 #include "utils/timer.h"
 #include "utils/system.h"
 
@@ -29,6 +31,7 @@ void SearchStatistics::report_f_value_progress(int f) {
     if (f > lastjump_f_value) {
         lastjump_f_value = f;
         print_f_line();
+        g_search_profiler.record_event(TraceEventType::F_VALUE_JUMP, f);
         lastjump_expanded_states = expanded_states;
         lastjump_reopened_states = reopened_states;
         lastjump_evaluated_states = evaluated_states;
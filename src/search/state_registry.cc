@@ -1,22 +1,33 @@
 #include "state_registry.h"
 
 #include "per_state_information.h"
+#include "search_profiler.h"
 #include "task_proxy.h"
 
 #include "task_utils/task_properties.h"
+#include "utils/memory.h"
 
 using namespace std;
 
-StateRegistry::StateRegistry(AbstractTask &task)
+StateRegistry::StateRegistry(
+    AbstractTask &task, const string &spill_directory, bool compress_states)
     : task(task),
       state_packer(task_properties::g_state_packers[&task]),
       axiom_evaluator(g_axiom_evaluators[&task]),
       num_variables(TaskProxy(task).get_variables().size()),
-      state_data_pool(get_bins_per_state()),
+      arena(spill_directory.empty() ? nullptr :
+            make_shared<utils::FileBackedArena>(spill_directory)),
+      state_data_pool(get_bins_per_state(),
+                      utils::ArenaAllocator<PackedStateBin>(arena)),
       registered_states(
           StateIDSemanticHash(state_data_pool, get_bins_per_state()),
           StateIDSemanticEqual(state_data_pool, get_bins_per_state())),
-      cached_initial_state(0) {
+      compressed_states(
+          compress_states ?
+          utils::make_unique_ptr<tree_compressed_set::TreeCompressedSet>(
+              get_bins_per_state(), arena) : nullptr),
+      cached_initial_state(0),
+      memory_reporter("state registry", [this]() {return get_num_bytes();}) {
 }
 
 
@@ -41,26 +52,46 @@ StateID StateRegistry::insert_id_or_pop_state() {
     return StateID(result.first);
 }
 
+GlobalState StateRegistry::insert_compressed_state(
+    shared_ptr<vector<PackedStateBin>> &&buffer) {
+    assert(compressed_states);
+    StateID id(compressed_states->insert(buffer->data()).first);
+#ifndef NDEBUG
+    // Decompressing the stored state must give back the inserted buffer.
+    vector<PackedStateBin> stored_buffer(get_bins_per_state());
+    compressed_states->get(id.value, stored_buffer.data());
+    assert(stored_buffer == *buffer);
+#endif
+    return GlobalState(move(buffer), *this, id);
+}
+
 GlobalState StateRegistry::lookup_state(StateID id) const {
+    if (compressed_states) {
+        auto buffer = make_shared<vector<PackedStateBin>>(get_bins_per_state());
+        compressed_states->get(id.value, buffer->data());
+        return GlobalState(move(buffer), *this, id);
+    }
     return GlobalState(state_data_pool[id.value], *this, id);
 }
 
 const GlobalState &StateRegistry::get_initial_state() {
     if (cached_initial_state == 0) {
-        PackedStateBin *buffer = new PackedStateBin[get_bins_per_state()];
         // Avoid garbage values in half-full bins.
-        fill_n(buffer, get_bins_per_state(), 0);
+        auto buffer = make_shared<vector<PackedStateBin>>(get_bins_per_state(), 0);
 
         TaskProxy task_proxy(task);
         State initial_state = task_proxy.get_initial_state();
         for (size_t i = 0; i < initial_state.size(); ++i) {
-            state_packer.set(buffer, i, initial_state[i].get_value());
+            state_packer.set(buffer->data(), i, initial_state[i].get_value());
+        }
+        if (compressed_states) {
+            cached_initial_state = new GlobalState(
+                insert_compressed_state(move(buffer)));
+        } else {
+            state_data_pool.push_back(buffer->data());
+            StateID id = insert_id_or_pop_state();
+            cached_initial_state = new GlobalState(lookup_state(id));
         }
-        state_data_pool.push_back(buffer);
-        // buffer is copied by push_back
-        delete[] buffer;
-        StateID id = insert_id_or_pop_state();
-        cached_initial_state = new GlobalState(lookup_state(id));
     }
     return *cached_initial_state;
 }
@@ -70,6 +101,13 @@ const GlobalState &StateRegistry::get_initial_state() {
 //     operating on state buffers (PackedStateBin *).
 GlobalState StateRegistry::get_successor_state(const GlobalState &predecessor, const OperatorProxy &op) {
     assert(!op.is_axiom());
+    SearchProfiler::ScopedTimer timer(
+        g_search_profiler, ProfiledComponent::REGISTRY_INSERT);
+    if (compressed_states) {
+        auto buffer = make_shared<vector<PackedStateBin>>();
+        compute_successor_buffer(predecessor, op, *buffer);
+        return insert_compressed_state(move(buffer));
+    }
     state_data_pool.push_back(predecessor.get_packed_buffer());
     PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
     for (EffectProxy effect : op.get_effects()) {
@@ -83,15 +121,66 @@ GlobalState StateRegistry::get_successor_state(const GlobalState &predecessor, c
     return lookup_state(id);
 }
 
+void StateRegistry::compute_successor_buffer(
+    const GlobalState &predecessor, const OperatorProxy &op,
+    vector<PackedStateBin> &buffer) {
+    assert(!op.is_axiom());
+    const PackedStateBin *predecessor_buffer = predecessor.get_packed_buffer();
+    buffer.assign(predecessor_buffer, predecessor_buffer + get_bins_per_state());
+    for (EffectProxy effect : op.get_effects()) {
+        if (does_fire(effect, predecessor)) {
+            FactPair effect_pair = effect.get_fact().get_pair();
+            state_packer.set(buffer.data(), effect_pair.var, effect_pair.value);
+        }
+    }
+    axiom_evaluator.evaluate(buffer.data(), state_packer);
+}
+
+void StateRegistry::get_packed_state(
+    const GlobalState &state, vector<PackedStateBin> &buffer) const {
+    const PackedStateBin *state_buffer = state.get_packed_buffer();
+    buffer.assign(state_buffer, state_buffer + get_bins_per_state());
+}
+
+GlobalState StateRegistry::register_state(const PackedStateBin *buffer) {
+    SearchProfiler::ScopedTimer timer(
+        g_search_profiler, ProfiledComponent::REGISTRY_INSERT);
+    if (compressed_states) {
+        return insert_compressed_state(make_shared<vector<PackedStateBin>>(
+                                           buffer, buffer + get_bins_per_state()));
+    }
+    state_data_pool.push_back(buffer);
+    StateID id = insert_id_or_pop_state();
+    return lookup_state(id);
+}
+
 int StateRegistry::get_bins_per_state() const {
     return state_packer.get_num_bins();
 }
 
+size_t StateRegistry::get_num_bytes() const {
+    if (compressed_states) {
+        return compressed_states->get_num_bytes();
+    }
+    return state_data_pool.get_num_bytes() + registered_states.get_num_bytes();
+}
+
 int StateRegistry::get_state_size_in_bytes() const {
     return get_bins_per_state() * sizeof(PackedStateBin);
 }
 
 void StateRegistry::print_statistics() const {
     cout << "Number of registered states: " << size() << endl;
-    registered_states.print_statistics();
+    if (compressed_states) {
+        cout << "Compressed state storage: "
+             << compressed_states->get_num_nodes() << " nodes, "
+             << get_num_bytes() / 1024 << " KB (uncompressed: "
+             << size() * get_state_size_in_bytes() / 1024 << " KB)" << endl;
+    } else {
+        registered_states.print_statistics();
+    }
+    if (arena) {
+        cout << "State storage in " << arena->get_directory() << ": "
+             << arena->get_allocated_bytes() / 1024 << " KB" << endl;
+    }
 }
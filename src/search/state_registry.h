@@ -10,9 +10,14 @@
 #include "algorithms/int_packer.h"
 #include "algorithms/segmented_vector.h"
 #include "algorithms/subscriber.h"
+#include "algorithms/tree_compressed_set.h"
+#include "utils/file_backed_arena.h"
 #include "utils/hash.h"
+#include "utils/memory_accounting.h"
 
+#include <memory>
 #include <set>
+#include <vector>
 
 /*
   Overview of classes relevant to storing and working with registered states.
@@ -52,6 +57,20 @@
     This class is used to store the actual (packed) state data for all states
     while avoiding dynamically allocating each state individually.
     The index within this vector corresponds to the ID of the state.
+    If the registry is created with a spill directory, the segments of this
+    vector and of all PerStateInformation objects for the registry are
+    allocated from a memory-mapped file in that directory (see
+    FileBackedArena), so the operating system can move cold segments to
+    disk. Only the hash set of state IDs has to stay in RAM.
+
+  TreeCompressedSet
+    Alternative storage for the state data if the registry is created with
+    compress_states=true. Each packed state is stored as a binary tree of
+    pairs of bins, and equal subtrees of different states are shared, which
+    saves memory for tasks with many variables since successors only differ
+    from their predecessors in few bins. The index of a state in this set
+    is its ID, so the set also replaces the hash set of state IDs. States
+    looked up from such a registry own a decompressed copy of their data.
 
   PerStateInformation<T>
     Associates a value of type T with every state in a given StateRegistry.
@@ -100,11 +119,14 @@
 */
 
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
+    using StateDataPool = segmented_vector::SegmentedArrayVector<
+        PackedStateBin, utils::ArenaAllocator<PackedStateBin>>;
+
     struct StateIDSemanticHash {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        const StateDataPool &state_data_pool;
         int state_size;
         StateIDSemanticHash(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
+            const StateDataPool &state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool),
               state_size(state_size) {
@@ -121,10 +143,10 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     };
 
     struct StateIDSemanticEqual {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        const StateDataPool &state_data_pool;
         int state_size;
         StateIDSemanticEqual(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
+            const StateDataPool &state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool),
               state_size(state_size) {
@@ -156,15 +178,29 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     AxiomEvaluator &axiom_evaluator;
     const int num_variables;
 
-    segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
+    // Storage for the state data and per-state information (or nullptr).
+    std::shared_ptr<utils::FileBackedArena> arena;
+    StateDataPool state_data_pool;
     StateIDSet registered_states;
+    // Replaces state_data_pool and registered_states if states are compressed.
+    std::unique_ptr<tree_compressed_set::TreeCompressedSet> compressed_states;
 
     GlobalState *cached_initial_state;
 
+    utils::MemoryReporter memory_reporter;
+
     StateID insert_id_or_pop_state();
-    int get_bins_per_state() const;
+    GlobalState insert_compressed_state(
+        std::shared_ptr<std::vector<PackedStateBin>> &&buffer);
 public:
-    explicit StateRegistry(AbstractTask &task);
+    /*
+      If spill_directory is not empty, the state data and the per-state
+      information are stored in a temporary file in this directory. If
+      compress_states is true, the state data is tree-compressed.
+    */
+    explicit StateRegistry(
+        AbstractTask &task, const std::string &spill_directory = "",
+        bool compress_states = false);
     ~StateRegistry();
 
     /* TODO: Ideally, this should return a TaskProxy. (See comment above the
@@ -177,6 +213,20 @@ public:
         task = t;
     }
 
+    // Returns nullptr if the registry keeps its data in RAM.
+    const std::shared_ptr<utils::FileBackedArena> &get_arena() const {
+        return arena;
+    }
+
+    // Returns the empty string if the registry keeps its data in RAM.
+    std::string get_spill_directory() const {
+        return arena ? arena->get_directory() : "";
+    }
+
+    bool uses_compressed_states() const {
+        return compressed_states != nullptr;
+    }
+
     int get_num_variables() const {
         return num_variables;
     }
@@ -204,15 +254,47 @@ public:
     */
     GlobalState get_successor_state(const GlobalState &predecessor, const OperatorProxy &op);
 
+    /*
+      Writes the packed data of the state that results from applying op to
+      predecessor into buffer without registering the state. Together with
+      register_state(), this allows registering successors in another
+      registry for the same task.
+    */
+    void compute_successor_buffer(
+        const GlobalState &predecessor, const OperatorProxy &op,
+        std::vector<PackedStateBin> &buffer);
+
+    /*
+      Writes the packed data of state into buffer, e.g., to register the
+      state in another registry for the same task with register_state().
+    */
+    void get_packed_state(
+        const GlobalState &state, std::vector<PackedStateBin> &buffer) const;
+
+    /*
+      Returns the state with the given packed data and registers it if this
+      was not done before. The data must have been created by a registry for
+      the same task.
+    */
+    GlobalState register_state(const PackedStateBin *buffer);
+
+    int get_bins_per_state() const;
+
     /*
       Returns the number of states registered so far.
     */
     size_t size() const {
+        if (compressed_states) {
+            return compressed_states->size();
+        }
         return registered_states.size();
     }
 
     int get_state_size_in_bytes() const;
 
+    // Number of bytes used for storing and finding the registered states.
+    std::size_t get_num_bytes() const;
+
     void print_statistics() const;
 
     class const_iterator : public std::iterator<
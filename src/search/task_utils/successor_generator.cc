@@ -5,6 +5,7 @@
 
 #include "../abstract_task.h"
 #include "../global_state.h"
+#include "../search_profiler.h"
 
 using namespace std;
 
@@ -17,11 +18,15 @@ SuccessorGenerator::~SuccessorGenerator() = default;
 
 void SuccessorGenerator::generate_applicable_ops(
     const State &state, vector<OperatorID> &applicable_ops) const {
+    SearchProfiler::ScopedTimer timer(
+        g_search_profiler, ProfiledComponent::SUCCESSOR_GENERATION);
     root->generate_applicable_ops(state, applicable_ops);
 }
 
 void SuccessorGenerator::generate_applicable_ops(
     const GlobalState &state, vector<OperatorID> &applicable_ops) const {
+    SearchProfiler::ScopedTimer timer(
+        g_search_profiler, ProfiledComponent::SUCCESSOR_GENERATION);
     root->generate_applicable_ops(state, applicable_ops);
 }
 }
@@ -0,0 +1,122 @@
+#include "file_backed_arena.h"
+
+#include "system.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace utils {
+static const size_t ALIGNMENT = alignof(max_align_t);
+
+static size_t round_up(size_t bytes, size_t multiple) {
+    return (bytes + multiple - 1) / multiple * multiple;
+}
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+FileBackedArena::FileBackedArena(const string &directory, size_t chunk_size)
+    : directory(directory),
+      chunk_size(chunk_size),
+      file_descriptor(-1),
+      file_size(0),
+      next_free(nullptr),
+      remaining_bytes(0),
+      allocated_bytes(0) {
+    string filename = directory + "/fd-state-storage-XXXXXX";
+    vector<char> filename_buffer(filename.begin(), filename.end());
+    filename_buffer.push_back('\0');
+    file_descriptor = mkstemp(filename_buffer.data());
+    if (file_descriptor < 0) {
+        cerr << "Could not create a file in " << directory << ": "
+             << strerror(errno) << endl;
+        exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    // The data stays accessible through the descriptor and the mappings.
+    unlink(filename_buffer.data());
+}
+
+FileBackedArena::~FileBackedArena() {
+    for (const pair<char *, size_t> &chunk : chunks) {
+        munmap(chunk.first, chunk.second);
+    }
+    close(file_descriptor);
+}
+
+void FileBackedArena::add_chunk(size_t min_size) {
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    size_t size = round_up(max(chunk_size, min_size), page_size);
+    /*
+      Reserve the disk space up front where possible. Writing to a sparse
+      file on a full disk would kill the process with SIGBUS instead.
+    */
+#if OPERATING_SYSTEM == LINUX
+    int error = posix_fallocate(file_descriptor, file_size, size);
+#else
+    int error = ftruncate(file_descriptor, file_size + size) ? errno : 0;
+#endif
+    if (error) {
+        cerr << "Could not extend the state storage file in " << directory
+             << ": " << strerror(error) << endl;
+        exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+    void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                         file_descriptor, file_size);
+    if (mapping == MAP_FAILED) {
+        cerr << "Could not map the state storage file: "
+             << strerror(errno) << endl;
+        exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+    file_size += size;
+    chunks.emplace_back(static_cast<char *>(mapping), size);
+    next_free = chunks.back().first;
+    remaining_bytes = size;
+}
+#else
+FileBackedArena::FileBackedArena(const string &directory, size_t chunk_size)
+    : directory(directory),
+      chunk_size(chunk_size),
+      file_descriptor(-1),
+      file_size(0),
+      next_free(nullptr),
+      remaining_bytes(0),
+      allocated_bytes(0) {
+    cout << "Memory-mapped files are not supported on this system. "
+         << "Keeping all states in memory." << endl;
+}
+
+FileBackedArena::~FileBackedArena() {
+    for (const pair<char *, size_t> &chunk : chunks) {
+        delete[] chunk.first;
+    }
+}
+
+void FileBackedArena::add_chunk(size_t min_size) {
+    size_t size = round_up(max(chunk_size, min_size), ALIGNMENT);
+    chunks.emplace_back(new char[size], size);
+    next_free = chunks.back().first;
+    remaining_bytes = size;
+}
+#endif
+
+void *FileBackedArena::allocate(size_t bytes) {
+    bytes = round_up(bytes, ALIGNMENT);
+    if (bytes > remaining_bytes) {
+        // The rest of the current chunk stays unused.
+        add_chunk(bytes);
+    }
+    void *result = next_free;
+    next_free += bytes;
+    remaining_bytes -= bytes;
+    allocated_bytes += bytes;
+    return result;
+}
+}
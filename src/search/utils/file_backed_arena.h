@@ -0,0 +1,122 @@
+#ifndef UTILS_FILE_BACKED_ARENA_H
+#define UTILS_FILE_BACKED_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace utils {
+/*
+  Allocates memory from a temporary file that is mapped into memory in
+  chunks. The operating system writes pages that were not used recently to
+  the file and reads them back when they are accessed, so the allocated data
+  can exceed the available RAM as long as most accesses go to a small part
+  of it. The file is deleted right after its creation, so it disappears when
+  the process ends.
+
+  Memory is only released when the arena is destroyed. On systems without
+  memory-mapped files, the memory is allocated on the heap.
+*/
+class FileBackedArena {
+    const std::string directory;
+    const std::size_t chunk_size;
+    int file_descriptor;
+    std::size_t file_size;
+    std::vector<std::pair<char *, std::size_t>> chunks;
+    char *next_free;
+    std::size_t remaining_bytes;
+    std::size_t allocated_bytes;
+
+    void add_chunk(std::size_t min_size);
+public:
+    explicit FileBackedArena(
+        const std::string &directory, std::size_t chunk_size = 64 << 20);
+    ~FileBackedArena();
+    FileBackedArena(const FileBackedArena &) = delete;
+    FileBackedArena &operator=(const FileBackedArena &) = delete;
+
+    void *allocate(std::size_t bytes);
+
+    const std::string &get_directory() const {
+        return directory;
+    }
+
+    std::size_t get_allocated_bytes() const {
+        return allocated_bytes;
+    }
+};
+
+/*
+  Allocator for the segmented vectors that allocates from the given arena
+  or, without an arena, from the heap. Memory of an arena is only released
+  with the arena, which the allocator keeps alive.
+*/
+template<typename T>
+class ArenaAllocator {
+    template<typename U>
+    friend class ArenaAllocator;
+
+    std::shared_ptr<FileBackedArena> arena;
+public:
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template<typename U>
+    struct rebind {
+        using other = ArenaAllocator<U>;
+    };
+
+    ArenaAllocator() = default;
+
+    explicit ArenaAllocator(const std::shared_ptr<FileBackedArena> &arena)
+        : arena(arena) {
+    }
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other)
+        : arena(other.arena) {
+    }
+
+    T *allocate(std::size_t n) {
+        if (arena) {
+            return static_cast<T *>(arena->allocate(n * sizeof(T)));
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *p, std::size_t n) {
+        if (!arena) {
+            std::allocator<T>().deallocate(p, n);
+        }
+    }
+
+    template<typename U, typename ... Args>
+    void construct(U *p, Args && ... args) {
+        ::new(static_cast<void *>(p))U(std::forward<Args>(args) ...);
+    }
+
+    template<typename U>
+    void destroy(U *p) {
+        p->~U();
+    }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U> &other) const {
+        return arena == other.arena;
+    }
+
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const {
+        return !(*this == other);
+    }
+};
+}
+
+#endif
@@ -75,6 +75,18 @@ TraceBlock::~TraceBlock() {
 }
 
 
+SilentBlock::SilentBlock(ostream &stream)
+    : stream(stream),
+      previous_state(stream.rdstate()) {
+    stream.setstate(ios::failbit);
+}
+
+
+SilentBlock::~SilentBlock() {
+    stream.clear(previous_state);
+}
+
+
 void trace(const string &msg) {
     _tracer.print_trace_message(msg);
 }
@@ -31,6 +31,21 @@ public:
     ~TraceBlock();
 };
 
+/*
+  Discards all output to the given stream while the object exists. The
+  previous state of the stream is restored afterwards, also if the block is
+  left with an exception.
+*/
+class SilentBlock {
+    std::ostream &stream;
+    std::ios::iostate previous_state;
+public:
+    explicit SilentBlock(std::ostream &stream);
+    ~SilentBlock();
+    SilentBlock(const SilentBlock &) = delete;
+    SilentBlock &operator=(const SilentBlock &) = delete;
+};
+
 extern void trace(const std::string &msg = "");
 }
 
@@ -0,0 +1,118 @@
+#include "memory_accounting.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace std;
+
+namespace utils {
+/*
+  The registry is never destroyed, because reporters of static objects may
+  be destroyed after it otherwise.
+*/
+static vector<const MemoryReporter *> &get_reporters() {
+    static vector<const MemoryReporter *> *reporters =
+        new vector<const MemoryReporter *>();
+    return *reporters;
+}
+
+static mutex &get_reporters_mutex() {
+    static mutex *reporters_mutex = new mutex();
+    return *reporters_mutex;
+}
+
+/*
+  Set while the current thread holds (or waits for) the reporters mutex.
+  If it runs out of memory then, e.g., while adding a reporter, the
+  out-of-memory handler must not try to lock the non-recursive mutex again.
+*/
+static thread_local bool uses_reporters = false;
+
+namespace {
+class ReportersUse {
+public:
+    ReportersUse() {
+        assert(!uses_reporters);
+        uses_reporters = true;
+    }
+
+    ~ReportersUse() {
+        uses_reporters = false;
+    }
+};
+}
+
+MemoryReporter::MemoryReporter(
+    const char *subsystem, function<size_t()> compute_num_bytes)
+    : subsystem(subsystem),
+      compute_num_bytes(move(compute_num_bytes)) {
+    ReportersUse use;
+    lock_guard<mutex> lock(get_reporters_mutex());
+    get_reporters().push_back(this);
+}
+
+MemoryReporter::~MemoryReporter() {
+    ReportersUse use;
+    lock_guard<mutex> lock(get_reporters_mutex());
+    vector<const MemoryReporter *> &reporters = get_reporters();
+    auto it = find(reporters.begin(), reporters.end(), this);
+    assert(it != reporters.end());
+    reporters.erase(it);
+}
+
+void report_memory_usage(
+    const function<void(const char *, size_t)> &report, bool wait_for_lock) {
+    if (uses_reporters) {
+        assert(!wait_for_lock);
+        return;
+    }
+    ReportersUse use;
+    unique_lock<mutex> lock(get_reporters_mutex(), defer_lock);
+    if (wait_for_lock) {
+        lock.lock();
+    } else if (!lock.try_lock()) {
+        return;
+    }
+    const vector<const MemoryReporter *> &reporters = get_reporters();
+    int num_reporters = reporters.size();
+    /*
+      Sum up the reporters of each subsystem without allocating memory. The
+      first reporter of a subsystem collects the bytes of all others.
+    */
+    for (int i = 0; i < num_reporters; ++i) {
+        const char *subsystem = reporters[i]->get_subsystem();
+        bool is_first = true;
+        for (int j = 0; j < i && is_first; ++j) {
+            if (strcmp(reporters[j]->get_subsystem(), subsystem) == 0) {
+                is_first = false;
+            }
+        }
+        if (!is_first) {
+            continue;
+        }
+        size_t num_bytes = 0;
+        for (int j = i; j < num_reporters; ++j) {
+            if (strcmp(reporters[j]->get_subsystem(), subsystem) == 0) {
+                try {
+                    num_bytes += reporters[j]->compute_bytes();
+                } catch (const bad_alloc &) {
+                }
+            }
+        }
+        report(subsystem, num_bytes);
+    }
+}
+
+void print_memory_usage() {
+    report_memory_usage(
+        [](const char *subsystem, size_t num_bytes) {
+            cout << "Memory for " << subsystem << ": "
+                 << num_bytes / 1024 << " KB" << endl;
+        });
+}
+}
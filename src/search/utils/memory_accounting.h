@@ -0,0 +1,87 @@
+#ifndef UTILS_MEMORY_ACCOUNTING_H
+#define UTILS_MEMORY_ACCOUNTING_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+
+namespace utils {
+/*
+  Registers a function that computes the number of bytes currently used by
+  a data structure, e.g., the state registry, an open list or the lookup
+  tables of a heuristic, in a central registry as long as the reporter
+  exists. The registry sums up the bytes of all reporters with the same
+  subsystem name when the memory usage is printed (see
+  print_memory_usage()), so keeping the accounts does not cost anything
+  during the search.
+
+  The numbers count the memory of the main containers of the data
+  structures and ignore the overhead of the memory allocator, so they do
+  not add up to the memory usage of the process.
+
+  The subsystem name must live as long as the reporter, which is always the
+  case for string literals. Since the function usually refers to its owner,
+  reporters cannot be copied or moved.
+*/
+class MemoryReporter {
+    const char *subsystem;
+    std::function<std::size_t()> compute_num_bytes;
+public:
+    MemoryReporter(
+        const char *subsystem, std::function<std::size_t()> compute_num_bytes);
+    ~MemoryReporter();
+    MemoryReporter(const MemoryReporter &) = delete;
+    MemoryReporter &operator=(const MemoryReporter &) = delete;
+
+    const char *get_subsystem() const {
+        return subsystem;
+    }
+
+    std::size_t compute_bytes() const {
+        return compute_num_bytes();
+    }
+};
+
+/*
+  Call report once for every subsystem with the total number of bytes of
+  its reporters. This does not allocate memory itself, so it can be used
+  when the planner runs out of memory. Reporters that fail to compute their
+  size because they run out of memory are skipped. If wait_for_lock is
+  false and another thread currently adds or removes a reporter, nothing is
+  reported. Nothing is reported either if the calling thread is adding,
+  removing or reporting the reporters itself, e.g., when it runs out of
+  memory while doing so.
+*/
+extern void report_memory_usage(
+    const std::function<void(const char *subsystem, std::size_t num_bytes)> &report,
+    bool wait_for_lock = true);
+
+// Print the memory usage of all subsystems.
+extern void print_memory_usage();
+
+/*
+  Estimate the number of bytes used by a std::deque<T> with the given
+  number of elements. Deques store their elements in blocks of 512 bytes
+  (or of one element if it is larger), which are managed by an array of
+  block pointers with room for at least 8 blocks.
+*/
+template<typename T>
+std::size_t estimate_deque_bytes(std::size_t num_elements) {
+    std::size_t elements_per_block = std::max<std::size_t>(1, 512 / sizeof(T));
+    std::size_t num_blocks = num_elements / elements_per_block + 1;
+    return num_blocks * elements_per_block * sizeof(T) +
+           std::max<std::size_t>(8, num_blocks + 2) * sizeof(T *);
+}
+
+/*
+  Estimate the number of bytes used by a node of a std::map or std::set
+  that stores values of type T: the value, two child pointers, a parent
+  pointer and the color.
+*/
+template<typename T>
+std::size_t estimate_tree_node_bytes() {
+    return sizeof(T) + 4 * sizeof(void *);
+}
+}
+
+#endif
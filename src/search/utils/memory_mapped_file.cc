@@ -0,0 +1,84 @@
+#include "memory_mapped_file.h"
+
+#include "system.h"
+
+#include <fstream>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace utils {
+MemoryMappedFile::MemoryMappedFile()
+    : data(nullptr),
+      size(0) {
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    close();
+}
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+bool MemoryMappedFile::open(const string &filename) {
+    close();
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat file_info;
+    if (fstat(fd, &file_info) != 0 || file_info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void *mapping = mmap(nullptr, file_info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping stays valid after closing the file descriptor.
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    data = static_cast<const char *>(mapping);
+    size = file_info.st_size;
+    return true;
+}
+
+void MemoryMappedFile::close() {
+    if (data) {
+        munmap(const_cast<char *>(data), size);
+    }
+    data = nullptr;
+    size = 0;
+}
+#else
+bool MemoryMappedFile::open(const string &filename) {
+    close();
+    ifstream file(filename, ios::binary | ios::ate);
+    if (!file) {
+        return false;
+    }
+    streamsize file_size = file.tellg();
+    if (file_size <= 0) {
+        return false;
+    }
+    buffer.resize(file_size);
+    file.seekg(0);
+    if (!file.read(buffer.data(), file_size)) {
+        buffer.clear();
+        return false;
+    }
+    data = buffer.data();
+    size = buffer.size();
+    return true;
+}
+
+void MemoryMappedFile::close() {
+    buffer.clear();
+    data = nullptr;
+    size = 0;
+}
+#endif
+}
@@ -0,0 +1,42 @@
+#ifndef UTILS_MEMORY_MAPPED_FILE_H
+#define UTILS_MEMORY_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace utils {
+/*
+  Read-only view of a file's contents. On Unix systems the file is mapped
+  into memory, so its pages are only loaded when they are accessed and are
+  shared between processes using the same file. On other systems the file
+  is read into memory completely.
+*/
+class MemoryMappedFile {
+    const char *data;
+    std::size_t size;
+    std::vector<char> buffer;
+public:
+    /*
+      Returns false if the file does not exist or cannot be mapped. In that
+      case the object stays empty.
+    */
+    bool open(const std::string &filename);
+    void close();
+
+    MemoryMappedFile();
+    ~MemoryMappedFile();
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+    const char *get_data() const {
+        return data;
+    }
+
+    std::size_t get_size() const {
+        return size;
+    }
+};
+}
+
+#endif
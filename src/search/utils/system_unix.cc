@@ -22,6 +22,8 @@
 
 #include "system_unix.h"
 
+#include "memory_accounting.h"
+
 #include <csignal>
 #include <cstdio>
 #include <cstring>
@@ -163,6 +165,21 @@ void out_of_memory_handler() {
       memory for the stack of the signal handler and raising a signal here.
     */
     write_reentrant_str(STDOUT_FILENO, "Failed to allocate memory.\n");
+    /*
+      Report which subsystems used the memory. Computing the sizes does not
+      allocate memory except for a few reporters, which fail with bad_alloc
+      instead of calling this handler again.
+    */
+    set_new_handler(nullptr);
+    report_memory_usage(
+        [](const char *subsystem, size_t num_bytes) {
+            write_reentrant_str(STDOUT_FILENO, "Memory for ");
+            write_reentrant_str(STDOUT_FILENO, subsystem);
+            write_reentrant_str(STDOUT_FILENO, ": ");
+            write_reentrant_int(
+                STDOUT_FILENO, static_cast<int>(num_bytes / 1024));
+            write_reentrant_str(STDOUT_FILENO, " KB\n");
+        }, false);
     exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
 }
 
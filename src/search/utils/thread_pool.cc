@@ -0,0 +1,109 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace utils {
+ThreadPool::ThreadPool(int num_threads)
+    : task(nullptr),
+      num_tasks(0),
+      num_busy_workers(0),
+      generation(0),
+      shutting_down(false),
+      exception_index(-1),
+      next_task(0) {
+    if (num_threads == 0) {
+        num_threads = max(1u, thread::hardware_concurrency());
+    }
+    workers.reserve(num_threads - 1);
+    for (int i = 1; i < num_threads; ++i) {
+        workers.emplace_back(&ThreadPool::work_loop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(pool_mutex);
+        shutting_down = true;
+    }
+    work_available.notify_all();
+    for (thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::execute_tasks() {
+    while (true) {
+        int index = next_task.fetch_add(1);
+        if (index >= num_tasks) {
+            break;
+        }
+        try {
+            (*task)(index);
+        } catch (...) {
+            lock_guard<mutex> lock(pool_mutex);
+            if (!exception || index < exception_index) {
+                exception = current_exception();
+                exception_index = index;
+            }
+            next_task = num_tasks;
+        }
+    }
+}
+
+void ThreadPool::work_loop() {
+    unsigned seen_generation = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(pool_mutex);
+            work_available.wait(lock, [&]() {
+                                    return shutting_down ||
+                                    generation != seen_generation;
+                                });
+            if (shutting_down) {
+                return;
+            }
+            seen_generation = generation;
+        }
+        execute_tasks();
+        {
+            lock_guard<mutex> lock(pool_mutex);
+            --num_busy_workers;
+        }
+        work_finished.notify_one();
+    }
+}
+
+void ThreadPool::run(int num_tasks_, const function<void(int)> &task_) {
+    if (workers.empty() || num_tasks_ <= 1) {
+        for (int i = 0; i < num_tasks_; ++i) {
+            task_(i);
+        }
+        return;
+    }
+    {
+        lock_guard<mutex> lock(pool_mutex);
+        task = &task_;
+        num_tasks = num_tasks_;
+        next_task = 0;
+        exception = nullptr;
+        exception_index = -1;
+        num_busy_workers = workers.size();
+        ++generation;
+    }
+    work_available.notify_all();
+    execute_tasks();
+    exception_ptr result;
+    {
+        unique_lock<mutex> lock(pool_mutex);
+        work_finished.wait(lock, [this]() {return num_busy_workers == 0;});
+        task = nullptr;
+        result = exception;
+        exception = nullptr;
+    }
+    if (result) {
+        rethrow_exception(result);
+    }
+}
+}
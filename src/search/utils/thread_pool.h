@@ -0,0 +1,61 @@
+#ifndef UTILS_THREAD_POOL_H
+#define UTILS_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+/*
+  A fixed set of threads that execute indexed tasks. run(num_tasks, task)
+  calls task(i) for all i in [0, num_tasks) and returns when all calls have
+  finished. The calling thread takes part in the work, so a pool with
+  num_threads = 1 runs all tasks in order in the calling thread.
+
+  Tasks are started in increasing index order but may finish in any order.
+  To get results that do not depend on the number of threads, tasks should
+  only write to data owned by their index, and the caller should combine
+  the results in index order after run() returns.
+
+  If tasks throw, the remaining tasks are skipped and run() rethrows the
+  exception of the task with the smallest index.
+*/
+class ThreadPool {
+    std::vector<std::thread> workers;
+
+    std::mutex pool_mutex;
+    std::condition_variable work_available;
+    std::condition_variable work_finished;
+    // The following members are protected by pool_mutex.
+    const std::function<void(int)> *task;
+    int num_tasks;
+    int num_busy_workers;
+    unsigned generation;
+    bool shutting_down;
+    std::exception_ptr exception;
+    int exception_index;
+
+    std::atomic<int> next_task;
+
+    void execute_tasks();
+    void work_loop();
+public:
+    // num_threads = 0 uses one thread per hardware thread.
+    explicit ThreadPool(int num_threads);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int get_num_threads() const {
+        return workers.size() + 1;
+    }
+
+    void run(int num_tasks, const std::function<void(int)> &task);
+};
+}
+
+#endif
@@ -0,0 +1,24 @@
+#include "thread_pool_options.h"
+
+#include "thread_pool.h"
+
+#include "../options/option_parser.h"
+
+using namespace std;
+
+namespace utils {
+void add_thread_pool_options(options::OptionParser &parser) {
+    parser.add_option<int>(
+        "num_threads",
+        "Number of threads used for independent computations. "
+        "Set to 0 to use one thread per hardware thread. "
+        "The results do not depend on the number of threads.",
+        "1",
+        options::Bounds("0", "infinity"));
+}
+
+shared_ptr<ThreadPool> parse_thread_pool_from_options(
+    const options::Options &options) {
+    return make_shared<ThreadPool>(options.get<int>("num_threads"));
+}
+}
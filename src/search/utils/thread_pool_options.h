@@ -0,0 +1,25 @@
+#ifndef UTILS_THREAD_POOL_OPTIONS_H
+#define UTILS_THREAD_POOL_OPTIONS_H
+
+#include <memory>
+
+namespace options {
+class OptionParser;
+class Options;
+}
+
+namespace utils {
+class ThreadPool;
+
+// Add num_threads option to parser.
+extern void add_thread_pool_options(options::OptionParser &parser);
+
+/*
+  Return a thread pool with the number of threads given in the options.
+  Only use this together with "add_thread_pool_options()".
+*/
+extern std::shared_ptr<ThreadPool> parse_thread_pool_from_options(
+    const options::Options &options);
+}
+
+#endif